@@ -0,0 +1,390 @@
+#include <elle/AtomicFileSet.hh>
+
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <set>
+
+#ifndef ELLE_WINDOWS
+# include <fcntl.h>
+# include <unistd.h>
+#endif
+
+#include <elle/assert.hh>
+#include <elle/err.hh>
+#include <elle/log.hh>
+
+ELLE_LOG_COMPONENT("elle.AtomicFileSet");
+
+namespace elle
+{
+  namespace
+  {
+    /// Operations of a transaction, as (target, staged) pairs. An empty
+    /// staged path denotes a removal.
+    using Entries = std::vector<std::pair<bfs::path, bfs::path>>;
+
+    void
+    save(std::ostream& output, bfs::path const& target, bfs::path const& staged)
+    {
+      output << std::quoted(target.string()) << ' '
+             << std::quoted(staged.string()) << '\n';
+    }
+
+    /// Read the entries of @a log, ignoring any torn trailing one.
+    Entries
+    load(bfs::path const& log)
+    {
+      auto res = Entries{};
+      auto input = std::ifstream(log.string());
+      auto target = std::string{};
+      auto staged = std::string{};
+      while (input >> std::quoted(target) >> std::quoted(staged)
+             && input.get() == '\n')
+        res.emplace_back(target, staged);
+      return res;
+    }
+
+#ifndef ELLE_WINDOWS
+    [[noreturn]]
+    void
+    fail(bfs::path const& path)
+    {
+      throw bfs::filesystem_error(
+        strerror(errno), path,
+        boost::system::error_code(errno, boost::system::system_category()));
+    }
+
+    /// An open file descriptor.
+    class Descriptor
+    {
+    public:
+      Descriptor(bfs::path path)
+        : _path(std::move(path))
+        , _fd(::open(this->_path.string().c_str(), O_RDONLY))
+      {
+        if (this->_fd < 0)
+          fail(this->_path);
+      }
+
+      Descriptor(Descriptor&& source)
+        : _path(std::move(source._path))
+        , _fd(source._fd)
+      {
+        source._fd = -1;
+      }
+
+      ~Descriptor()
+      {
+        if (this->_fd >= 0)
+          ::close(this->_fd);
+      }
+
+      ELLE_ATTRIBUTE_R(bfs::path, path);
+      ELLE_ATTRIBUTE_R(int, fd);
+    };
+
+    /// Files flushed at once, to bound open descriptors.
+    auto constexpr batch = 256u;
+#endif
+
+    /// Flush the content of @a paths to disk.
+    ///
+    /// Writeback is started for a whole batch before waiting on any file, so
+    /// the device sees every write at once instead of one file at a time.
+    template <typename Paths>
+    void
+    sync_files(Paths const& paths)
+    {
+#ifndef ELLE_WINDOWS
+      auto it = paths.begin();
+      while (it != paths.end())
+      {
+        auto files = std::vector<Descriptor>{};
+        for (; it != paths.end() && files.size() < batch; ++it)
+          files.emplace_back(*it);
+# ifdef ELLE_LINUX
+        // Only a hint, errors are reported by fdatasync.
+        for (auto const& f: files)
+          ::sync_file_range(f.fd(), 0, 0, SYNC_FILE_RANGE_WRITE);
+        for (auto const& f: files)
+          if (::fdatasync(f.fd()))
+            fail(f.path());
+# else
+        for (auto const& f: files)
+          if (::fsync(f.fd()))
+            fail(f.path());
+# endif
+      }
+#endif
+    }
+
+    /// Flush entries of @a directories to disk.
+    template <typename Paths>
+    void
+    sync_directories(Paths const& directories)
+    {
+#ifndef ELLE_WINDOWS
+      for (auto const& d: directories)
+        if (::fsync(Descriptor(d).fd()))
+          fail(d);
+#endif
+    }
+
+    bfs::path
+    directory(bfs::path const& path)
+    {
+      auto res = path.parent_path();
+      return res.empty() ? "." : res;
+    }
+  }
+
+  /*-------------.
+  | Construction |
+  `-------------*/
+
+  AtomicFileSet::AtomicFileSet(bfs::path root, bool sync)
+    : _root(std::move(root))
+    , _sync(sync)
+    , _transacting(false)
+    , _path_log(this->_root / ".transaction")
+    , _path_log_new(this->_root / ".transaction.new")
+  {
+    bfs::create_directories(this->_root);
+    this->_recover();
+  }
+
+  AtomicFileSet::~AtomicFileSet()
+  {
+    ELLE_ASSERT(!this->transacting());
+  }
+
+  /*------------.
+  | Transaction |
+  `------------*/
+
+  AtomicFileSet::Transaction::Transaction(AtomicFileSet* owner)
+    : _owner(owner)
+    , _committed(false)
+    , _log(std::make_unique<std::ofstream>(owner->_path_log_new.string()))
+  {
+    if (!*this->_log)
+      err("%s: unable to create %s", *owner, owner->_path_log_new);
+    this->_owner->_transacting = true;
+  }
+
+  AtomicFileSet::Transaction::Transaction(Transaction&& source)
+    : _owner(source._owner)
+    , _committed(source._committed)
+    , _log(std::move(source._log))
+    , _changes(std::move(source._changes))
+    , _index(std::move(source._index))
+  {
+    source._owner = nullptr;
+  }
+
+  AtomicFileSet::Transaction::~Transaction()
+  {
+    if (this->_owner && !this->_committed)
+      try
+      {
+        this->abort();
+      }
+      catch (std::exception const& e)
+      {
+        ELLE_WARN("%s: unable to discard transaction: %s", *this->_owner, e);
+        this->_owner->_transacting = false;
+      }
+  }
+
+  AtomicFileSet::Transaction::Change&
+  AtomicFileSet::Transaction::_change(bfs::path const& path)
+  {
+    ELLE_ASSERT(this->_owner);
+    ELLE_ASSERT(!this->_committed);
+    auto target = path.is_absolute() ? path : this->_owner->_root / path;
+    auto it = this->_index.find(target);
+    if (it != this->_index.end())
+      return this->_changes[it->second];
+    auto staged =
+      directory(target) / ("." + target.filename().string() + ".transaction");
+    this->_index.emplace(target, this->_changes.size());
+    this->_changes.emplace_back(std::move(target), std::move(staged));
+    return this->_changes.back();
+  }
+
+  std::ostream&
+  AtomicFileSet::Transaction::write(bfs::path const& path)
+  {
+    auto& change = this->_change(path);
+    ELLE_DEBUG("%s: write %s", *this->_owner, change.target);
+    if (change.stream)
+      // Discard the previous content.
+      change.stream->close();
+    else
+    {
+      bfs::create_directories(directory(change.target));
+      save(*this->_log, change.target, change.staged);
+      this->_log->flush();
+    }
+    change.stream = std::make_unique<std::ofstream>(
+      change.staged.string(), std::ios::binary | std::ios::trunc);
+    if (!*change.stream)
+      err("%s: unable to create %s", *this->_owner, change.staged);
+    return *change.stream;
+  }
+
+  void
+  AtomicFileSet::Transaction::remove(bfs::path const& path)
+  {
+    auto& change = this->_change(path);
+    ELLE_DEBUG("%s: remove %s", *this->_owner, change.target);
+    if (change.stream)
+    {
+      change.stream.reset();
+      try_remove(change.staged);
+    }
+  }
+
+  void
+  AtomicFileSet::Transaction::commit()
+  {
+    ELLE_ASSERT(this->_owner);
+    ELLE_ASSERT(!this->_committed);
+    auto& owner = *this->_owner;
+    ELLE_TRACE_SCOPE("%s: commit %s changes", owner, this->_changes.size());
+    auto files = std::vector<bfs::path>{};
+    auto directories = std::set<bfs::path>{};
+    try
+    {
+      for (auto& change: this->_changes)
+      {
+        if (change.stream)
+        {
+          change.stream->close();
+          if (!*change.stream)
+            err("%s: unable to write %s", owner, change.staged);
+          files.emplace_back(change.staged);
+        }
+        directories.emplace(directory(change.target));
+      }
+      // Record every operation, removals included.
+      this->_log.reset();
+      {
+        auto log = std::ofstream(owner._path_log_new.string(),
+                                 std::ios::trunc);
+        for (auto const& change: this->_changes)
+          save(log, change.target,
+               change.stream ? change.staged : bfs::path());
+        log.close();
+        if (!log)
+          err("%s: unable to write %s", owner, owner._path_log_new);
+      }
+      if (owner._sync)
+      {
+        ELLE_DEBUG("%s: flush %s files", owner, files.size() + 1)
+        {
+          files.emplace_back(owner._path_log_new);
+          sync_files(files);
+          sync_directories(directories);
+        }
+      }
+      bfs::rename(owner._path_log_new, owner._path_log);
+    }
+    catch (...)
+    {
+      ELLE_WARN("%s: commit failed: %s", owner, elle::exception_string());
+      this->abort();
+      throw;
+    }
+    // Past the commit point, an interrupted or failed transaction is replayed
+    // upon recovery: never abort it.
+    this->_committed = true;
+    owner._transacting = false;
+    if (owner._sync)
+      sync_directories(std::vector<bfs::path>{owner._root});
+    for (auto const& change: this->_changes)
+      if (change.stream)
+        bfs::rename(change.staged, change.target);
+      else
+        bfs::remove(change.target);
+    if (owner._sync)
+      sync_directories(directories);
+    bfs::remove(owner._path_log);
+  }
+
+  void
+  AtomicFileSet::Transaction::abort()
+  {
+    ELLE_ASSERT(this->_owner);
+    ELLE_ASSERT(!this->_committed);
+    ELLE_TRACE_SCOPE("%s: abort %s changes",
+                     *this->_owner, this->_changes.size());
+    this->_log.reset();
+    for (auto& change: this->_changes)
+      if (change.stream)
+      {
+        change.stream.reset();
+        try_remove(change.staged);
+      }
+    this->_changes.clear();
+    this->_index.clear();
+    try_remove(this->_owner->_path_log_new);
+    this->_owner->_transacting = false;
+  }
+
+  AtomicFileSet::Transaction
+  AtomicFileSet::transaction()
+  {
+    ELLE_TRACE_SCOPE("%s: start transaction", this);
+    ELLE_ASSERT(!this->transacting());
+    // Replay a previous commit that failed past its commit point, lest its
+    // log be overwritten.
+    this->_recover();
+    return Transaction(this);
+  }
+
+  /*---------.
+  | Recovery |
+  `---------*/
+
+  void
+  AtomicFileSet::_recover()
+  {
+    if (bfs::exists(this->_path_log))
+    {
+      ELLE_WARN("%s: replay interrupted transaction", this);
+      auto directories = std::set<bfs::path>{};
+      for (auto const& entry: load(this->_path_log))
+      {
+        if (entry.second.empty())
+          bfs::remove(entry.first);
+        // Otherwise, a missing staged file was already renamed.
+        else if (bfs::exists(entry.second))
+          bfs::rename(entry.second, entry.first);
+        directories.emplace(directory(entry.first));
+      }
+      if (this->_sync)
+        sync_directories(directories);
+      bfs::remove(this->_path_log);
+    }
+    if (bfs::exists(this->_path_log_new))
+    {
+      ELLE_WARN("%s: discard aborted transaction", this);
+      for (auto const& entry: load(this->_path_log_new))
+        if (!entry.second.empty())
+          try_remove(entry.second);
+      bfs::remove(this->_path_log_new);
+    }
+  }
+
+  /*----------.
+  | Printable |
+  `----------*/
+
+  void
+  AtomicFileSet::print(std::ostream& stream) const
+  {
+    stream << "AtomicFileSet(" << this->_root << ')';
+  }
+}
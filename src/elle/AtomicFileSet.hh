@@ -0,0 +1,172 @@
+#pragma once
+
+#include <fstream>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include <elle/attribute.hh>
+#include <elle/filesystem.hh>
+#include <elle/Printable.hh>
+
+namespace elle
+{
+  namespace bfs = boost::filesystem;
+
+  /// A set of files committed together, durably and atomically.
+  ///
+  /// Where AtomicFile commits files one by one, an AtomicFileSet stages any
+  /// number of writes and removals in a Transaction and commits them as a
+  /// group: either all of them are visible after a crash, or none is.
+  ///
+  /// New contents are written next to their targets as they are staged.
+  /// Committing a transaction then:
+  ///
+  /// 1. records every operation in an intent log, in the set's directory;
+  /// 2. flushes the log and the new contents to disk in one batch: writeback
+  ///    is started for every file before waiting on any, and every directory
+  ///    is synced only once;
+  /// 3. renames the intent log in place: this is the commit point;
+  /// 4. renames the new contents over their targets and drops the log.
+  ///
+  /// Upon construction, a set recovers from any interrupted transaction: if
+  /// the commit point was reached, the renames are replayed, otherwise the
+  /// staged contents are discarded.
+  ///
+  /// Targets must live on the same filesystem as their directory, relative
+  /// paths are relative to the set's directory.
+  ///
+  /// @code{.cc}
+  ///
+  /// auto set = AtomicFileSet{"state"};
+  /// {
+  ///   auto transaction = set.transaction();
+  ///   transaction.write("peers") << peers;
+  ///   transaction.write("blocks/index") << index;
+  ///   transaction.remove("blocks/stale");
+  ///   transaction.commit();
+  /// }
+  /// // Without commit(), a Transaction discards its changes.
+  ///
+  /// @endcode
+  class ELLE_API AtomicFileSet
+    : public elle::Printable
+  {
+  /*------.
+  | Types |
+  `------*/
+  public:
+    /// Self type.
+    using Self = AtomicFileSet;
+
+  /*-------------.
+  | Construction |
+  `-------------*/
+  public:
+    /// Create a set in directory @a root, recovering any interrupted
+    /// transaction.
+    ///
+    /// @param sync Whether to flush commits to disk. Only disable it for
+    ///             data that need not survive a power loss.
+    AtomicFileSet(bfs::path root, bool sync = true);
+    /// Destruct an AtomicFileSet.
+    ///
+    /// @pre !this->transacting()
+    ~AtomicFileSet();
+    /// The directory holding the intent log.
+    ELLE_ATTRIBUTE_R(bfs::path, root);
+    /// Whether commits are flushed to disk.
+    ELLE_ATTRIBUTE_R(bool, sync);
+
+  /*------------.
+  | Transaction |
+  `------------*/
+  public:
+    /// A group of writes and removals, committed together.
+    class ELLE_API Transaction
+    {
+    public:
+      /// Move a transaction.
+      Transaction(Transaction&& source);
+      /// Destruct a transaction, discarding it unless committed.
+      ~Transaction();
+      /// A stream to write the new content of @a path to.
+      ///
+      /// Writing the same path twice discards the first content.
+      std::ostream&
+      write(bfs::path const& path);
+      /// Remove @a path, if it exists.
+      void
+      remove(bfs::path const& path);
+      /// Commit every change atomically.
+      ///
+      /// @pre !this->committed()
+      /// @post this->committed()
+      void
+      commit();
+      /// Discard every change.
+      void
+      abort();
+      /// The set this transaction runs on.
+      ELLE_ATTRIBUTE_R(AtomicFileSet*, owner);
+      /// Whether the changes were committed.
+      ELLE_ATTRIBUTE_R(bool, committed);
+    private:
+      /// Create a transaction on @a owner.
+      Transaction(AtomicFileSet* owner);
+      /// Let the owner access us.
+      friend class AtomicFileSet;
+      /// A staged change: new content, or removal if it has no stream.
+      struct Change
+      {
+        Change(bfs::path target, bfs::path staged)
+          : target(std::move(target))
+          , staged(std::move(staged))
+          , stream()
+        {}
+
+        bfs::path target;
+        bfs::path staged;
+        std::unique_ptr<std::ofstream> stream;
+      };
+      /// The change on @a path, created if needed.
+      Change&
+      _change(bfs::path const& path);
+      /// Staged files, to discard them if interrupted.
+      ELLE_ATTRIBUTE(std::unique_ptr<std::ofstream>, log);
+      ELLE_ATTRIBUTE(std::vector<Change>, changes);
+      ELLE_ATTRIBUTE((std::unordered_map<bfs::path, std::size_t>), index);
+    };
+
+    /// Start a transaction.
+    ///
+    /// @pre !this->transacting()
+    /// @post this->transacting()
+    Transaction
+    transaction();
+    /// Whether a transaction is in progress.
+    ELLE_ATTRIBUTE_R(bool, transacting);
+
+  /*---------.
+  | Recovery |
+  `---------*/
+  private:
+    /// Complete or discard any interrupted transaction.
+    void
+    _recover();
+    /// The intent log of the committed transaction.
+    ELLE_ATTRIBUTE(bfs::path, path_log);
+    /// The intent log of the transaction being staged.
+    ELLE_ATTRIBUTE(bfs::path, path_log_new);
+
+  /*----------.
+  | Printable |
+  `----------*/
+  public:
+    /// Print pretty representation to @a stream.
+    void
+    print(std::ostream& stream) const override;
+  };
+}
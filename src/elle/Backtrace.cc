@@ -7,10 +7,13 @@
 #include <cxxabi.h>
 #include <cmath>
 
+#include <algorithm>
 #include <cstdlib>
 #include <iomanip>
+#include <mutex>
 #include <string>
 #include <sstream>
+#include <unordered_map>
 
 #include <elle/err.hh>
 #include <elle/printf.hh>
@@ -174,18 +177,124 @@ namespace elle
     , _resolved(true)
   {}
 
+  Backtrace::Backtrace(Backtrace const& source)
+    : _frames(source._frames)
+    , _resolved(source._resolved)
+    , _skip(source._skip)
+    , _frame_count(source._frame_count)
+  {
+    std::copy_n(source._callstack.begin(), this->_frame_count,
+                this->_callstack.begin());
+  }
+
+  Backtrace::Backtrace(Backtrace&& source)
+    : _frames(std::move(source._frames))
+    , _resolved(source._resolved)
+    , _skip(source._skip)
+    , _frame_count(source._frame_count)
+  {
+    std::copy_n(source._callstack.begin(), this->_frame_count,
+                this->_callstack.begin());
+  }
+
+  Backtrace&
+  Backtrace::operator =(Backtrace const& source)
+  {
+    if (this != &source)
+    {
+      this->_frames = source._frames;
+      this->_resolved = source._resolved;
+      this->_skip = source._skip;
+      this->_frame_count = source._frame_count;
+      std::copy_n(source._callstack.begin(), this->_frame_count,
+                  this->_callstack.begin());
+    }
+    return *this;
+  }
+
+  Backtrace&
+  Backtrace::operator =(Backtrace&& source)
+  {
+    if (this != &source)
+    {
+      this->_frames = std::move(source._frames);
+      this->_resolved = source._resolved;
+      this->_skip = source._skip;
+      this->_frame_count = source._frame_count;
+      std::copy_n(source._callstack.begin(), this->_frame_count,
+                  this->_callstack.begin());
+    }
+    return *this;
+  }
+
+  namespace
+  {
+    /// Resolved frames by address, shared by the whole process.
+    class Symbols
+    {
+    public:
+      /// Resolve @a addresses, symbolizing only unknown ones.
+      std::vector<StackFrame>
+      resolve(void* const* addresses, unsigned count)
+      {
+        auto missing = std::vector<void*>{};
+        {
+          std::lock_guard<std::mutex> lock(this->_mutex);
+          for (unsigned i = 0; i < count; ++i)
+            if (this->_frames.find(addresses[i]) == this->_frames.end())
+              missing.emplace_back(addresses[i]);
+        }
+        if (!missing.empty())
+        {
+          ELLE_DEBUG("symbolize %s out of %s frames", missing.size(), count);
+          // Demangling is slow: do not hold the lock meanwhile.
+          auto resolved = std::vector<StackFrame>{};
+#if ELLE_HAVE_BACKTRACE
+          char** strs = ::backtrace_symbols(missing.data(), missing.size());
+          for (unsigned i = 0; i < missing.size(); ++i)
+            resolved.emplace_back(strs[i]);
+          free(strs);
+#endif
+          std::lock_guard<std::mutex> lock(this->_mutex);
+          for (unsigned i = 0; i < resolved.size(); ++i)
+            this->_frames.emplace(missing[i], std::move(resolved[i]));
+        }
+        auto res = std::vector<StackFrame>{};
+        res.reserve(count);
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        for (unsigned i = 0; i < count; ++i)
+        {
+          auto it = this->_frames.find(addresses[i]);
+          if (it != this->_frames.end())
+            res.emplace_back(it->second);
+        }
+        return res;
+      }
+
+    private:
+      std::mutex _mutex;
+      /// Code addresses: bounded by the size of the program.
+      std::unordered_map<void*, StackFrame> _frames;
+    };
+
+    Symbols&
+    symbols()
+    {
+      // Never destroyed: exceptions may be printed by static destructors.
+      static auto* res = new Symbols;
+      return *res;
+    }
+  }
+
   void
   Backtrace::_resolve()
   {
-    ELLE_DEBUG("resolve {} frames", this->_frame_count);
     if (this->_resolved)
       return;
-#if ELLE_HAVE_BACKTRACE
-    char** strs = backtrace_symbols(this->_callstack.data(), this->_frame_count);
-    for (unsigned i = this->_skip; i < this->_frame_count; ++i)
-      this->_frames.emplace_back(strs[i]);
-    free(strs);
-#endif
+    ELLE_DEBUG("resolve {} frames", this->_frame_count);
+    if (this->_skip < this->_frame_count)
+      this->_frames = symbols().resolve(this->_callstack.data() + this->_skip,
+                                        this->_frame_count - this->_skip);
     this->_resolved = true;
   }
 
@@ -197,6 +306,15 @@ namespace elle
     return this->_frames;
   }
 
+  bool
+  Backtrace::empty() const
+  {
+    if (this->_resolved)
+      return this->_frames.empty();
+    else
+      return this->_frame_count <= this->_skip;
+  }
+
   void
   Backtrace::strip_base(const Backtrace& base)
   {
@@ -64,15 +64,30 @@ namespace elle ELLE_API
   demangle(const std::string& sym);
 
 
+  /// A call stack.
+  ///
+  /// Capture only saves raw return addresses: symbols are resolved when
+  /// frames are first requested, e.g. when printed, through a process-wide
+  /// address to frame cache.
   class Backtrace
   {
   public:
     using Frame = StackFrame;
 
     /// An empty backtrace.
+    ///
+    /// Exceptions used for control flow, whose backtraces are never looked
+    /// at, build their base with it to skip capture entirely.
     Backtrace();
     /// A backtrace corresponding to these stack frames.
     Backtrace(std::vector<Frame>);
+    /// Copy only the captured part of the call stack.
+    Backtrace(Backtrace const& source);
+    Backtrace(Backtrace&& source);
+    Backtrace&
+    operator =(Backtrace const& source);
+    Backtrace&
+    operator =(Backtrace&& source);
 
     struct now_t {};
     static now_t now;
@@ -96,6 +111,10 @@ namespace elle ELLE_API
     std::vector<Frame> const&
     frames() const;
 
+    /// Whether there are no frames, without resolving them.
+    bool
+    empty() const;
+
   private:
     void _resolve();
     std::vector<Frame> _frames;
@@ -152,6 +152,7 @@ namespace elle
   Buffer::Buffer()
     : _size(0)
     , _capacity(elle_buffer_initial_size)
+    , _headroom(0)
     , _contents(static_cast<Byte*>(malloc(elle_buffer_initial_size)))
   {
     if (this->_contents == nullptr)
@@ -161,6 +162,7 @@ namespace elle
   Buffer::Buffer(void const* data, Buffer::Size size)
     : _size(0)
     , _capacity(0)
+    , _headroom(0)
     , _contents(nullptr)
   {
     if (size == 0)
@@ -185,6 +187,7 @@ namespace elle
   Buffer::Buffer(Buffer&& other)
     : _size(0)
     , _capacity(0)
+    , _headroom(0)
     , _contents(nullptr)
   {
     (*this) = std::move(other);
@@ -193,6 +196,7 @@ namespace elle
   Buffer::Buffer(Buffer const& source)
     : _size(source._size)
     , _capacity(source._size)
+    , _headroom(0)
     , _contents(static_cast<Byte*>(::malloc(this->_capacity)))
   {
     if (!this->_contents)
@@ -207,28 +211,31 @@ namespace elle
   Buffer&
   Buffer::operator = (Buffer&& other)
   {
-    ::free(this->_contents);
+    ::free(this->_contents - this->_headroom);
     this->_size = other._size;
     this->_capacity = other._capacity;
+    this->_headroom = other._headroom;
     this->_contents = other._contents;
     other._contents = nullptr;
     other._size = 0;
     other._capacity = 0;
+    other._headroom = 0;
     return *this;
   }
 
   Buffer::~Buffer()
   {
-    ::free(this->_contents);
+    ::free(this->_contents - this->_headroom);
   }
 
   void
   Buffer::capacity(Size capacity_)
   {
     auto const capacity = std::max(capacity_, elle_buffer_initial_size);
-    if (auto tmp = ::realloc(this->_contents, capacity))
+    if (auto tmp = ::realloc(this->_contents - this->_headroom,
+                             this->_headroom + capacity))
     {
-      this->_contents = static_cast<Byte*>(tmp);
+      this->_contents = static_cast<Byte*>(tmp) + this->_headroom;
       this->_capacity = capacity;
       this->_size = std::min(this->_size, capacity);
     }
@@ -244,6 +251,33 @@ namespace elle
     memmove(this->_contents + old_size, data, size);
   }
 
+  void
+  Buffer::headroom(Size headroom)
+  {
+    if (headroom <= this->_headroom)
+      return;
+    auto const tmp = static_cast<Byte*>(::malloc(headroom + this->_capacity));
+    if (!tmp)
+      throw std::bad_alloc();
+    memcpy(tmp + headroom, this->_contents, this->_size);
+    ::free(this->_contents - this->_headroom);
+    this->_contents = tmp + headroom;
+    this->_headroom = headroom;
+  }
+
+  void
+  Buffer::prepend(void const* data, Size size)
+  {
+    ELLE_ASSERT(data || !size);
+    if (this->_headroom < size)
+      this->headroom(Buffer::_next_size(size));
+    this->_contents -= size;
+    this->_headroom -= size;
+    this->_size += size;
+    this->_capacity += size;
+    memmove(this->_contents, data, size);
+  }
+
   void Buffer::pop_front(Size size)
   {
     ELLE_ASSERT(size <= _size);
@@ -268,6 +302,14 @@ namespace elle
   Buffer::ContentPair
   Buffer::release()
   {
+    // The owner of the memory expects the data at its beginning.
+    if (this->_headroom)
+    {
+      memmove(this->_contents - this->_headroom, this->_contents, this->_size);
+      this->_contents -= this->_headroom;
+      this->_capacity += this->_headroom;
+      this->_headroom = 0;
+    }
     auto res = ContentPair{ContentPtr{this->_contents}, this->_size};
     this->_contents = nullptr;
     this->_size = 0;
@@ -307,7 +349,8 @@ namespace elle
               << "[Buffer] "
               << "address(" << static_cast<void const*>(this->_contents) << ") "
               << "size(" << std::dec << this->_size << ") "
-              << "capacity(" << std::dec << this->_capacity << ")"
+              << "capacity(" << std::dec << this->_capacity << ") "
+              << "headroom(" << std::dec << this->_headroom << ")"
               << '\n';
     dump_hexa(std::cout, margin, this->_contents, this->_size);
   }
@@ -390,10 +433,11 @@ namespace elle
     auto capacity = std::max(elle_buffer_initial_size, this->_size);
     if (capacity < this->_capacity)
     {
-      void* tmp = ::realloc(_contents, capacity);
+      void* tmp = ::realloc(this->_contents - this->_headroom,
+                            this->_headroom + capacity);
       if (tmp == nullptr)
         throw std::bad_alloc();
-      this->_contents = static_cast<Byte*>(tmp);
+      this->_contents = static_cast<Byte*>(tmp) + this->_headroom;
       this->_capacity = capacity;
     }
   }
@@ -90,6 +90,11 @@ namespace elle
     ELLE_ATTRIBUTE_Rw(Size, size);
     /// Size of the underlying allocated memory.
     ELLE_ATTRIBUTE_Rw(Size, capacity);
+    /// Size of the memory reserved in front of the data.
+    ///
+    /// Setting it reserves at least that many bytes, so as many can then be
+    /// prepended without moving the data.
+    ELLE_ATTRIBUTE_Rw(Size, headroom);
     /// Buffer data.
     ELLE_ATTRIBUTE_R(Byte*, contents);
     /// Buffer mutable data.
@@ -117,6 +122,12 @@ namespace elle
     /// Append a copy of the data to the end of the buffer.
     void
     append(void const* data, Size size);
+    /// Insert a copy of the data at the beginning of the buffer.
+    ///
+    /// Cheap if the headroom is large enough, otherwise the data is moved to
+    /// make more room.
+    void
+    prepend(void const* data, Size size);
     /// Drop a number of bytes.
     /// Costly, as it memmoves the remaing bytes.
     void
@@ -23,6 +23,7 @@ namespace elle
   Buffer::Buffer(T size)
     : _size(static_cast<Size>(size))
     , _capacity(size)
+    , _headroom(0)
     , _contents(nullptr)
   {
     if ((this->_contents =
@@ -7,6 +7,7 @@
 # include <string>
 
 # include <elle/memory.hh>
+# include <elle/metrics.hh>
 # include <elle/printf.hh>
 #endif
 
@@ -72,7 +73,10 @@ namespace elle
       {
         this->done = true;
         using namespace std::chrono;
-        auto d = duration_cast<milliseconds>(system_clock::now() - this->start);
+        auto const elapsed = steady_clock::now() - this->start;
+        metrics::registry().histogram("measure." + this->name, 1e-9)
+          ->record(elapsed);
+        auto d = duration_cast<milliseconds>(elapsed);
         elle::fprintf(std::cout,
                       "%s %s took %s ms (%s:%s)\n",
                       std::string(_indent(), '#'),
@@ -92,8 +96,8 @@ namespace elle
     char const* file;
     unsigned int line;
     std::string const name;
-    std::chrono::system_clock::time_point const start
-      = std::chrono::system_clock::now();
+    std::chrono::steady_clock::time_point const start
+      = std::chrono::steady_clock::now();
     bool done = false;
 
   private:
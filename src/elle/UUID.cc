@@ -1,11 +1,22 @@
 #include <elle/UUID.hh>
 
 #include <chrono>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <thread>
+
+#ifdef VALGRIND
+# include <valgrind/valgrind.h>
+#else
+# define RUNNING_ON_VALGRIND 0
+#endif
 
 #include <boost/uuid/nil_generator.hpp>
-#include <boost/uuid/random_generator.hpp>
 #include <boost/uuid/string_generator.hpp>
 
+#include <elle/random.hh>
+
 namespace elle
 {
   /*-------------------.
@@ -29,19 +40,65 @@ namespace elle
     throw InvalidUUID(repr);
   }
 
-  UUID
-  UUID::random()
+  namespace
   {
-    // Beware, (probably) not thread safe.
-    static bool first = true;
-    static boost::mt19937 rng;
-    if (first)
+    /// The UUID engine of the current thread.
+    ///
+    /// Unlike random_engine, it is never deterministic: ELLE_SEED must not
+    /// make UUIDs collide across processes.
+    RandomEngine&
+    engine()
     {
-      first = false;
-      rng.seed(std::chrono::steady_clock::now().time_since_epoch().count() );
+      static thread_local auto res = []
+        {
+          // Valgrind does not like the random_device, nor reseeding from
+          // it: use the clock instead.
+          if (RUNNING_ON_VALGRIND)
+            return RandomEngine{
+              std::uint64_t(
+                std::chrono::high_resolution_clock::now()
+                .time_since_epoch().count()) ^
+              std::hash<std::thread::id>()(std::this_thread::get_id())};
+          else
+          {
+            std::random_device rd{};
+            return RandomEngine{
+              (std::uint64_t(rd()) << 32) ^ rd(), 1u << 20};
+          }
+        }();
+      return res;
     }
-    static boost::uuids::basic_random_generator<boost::mt19937> generator(&rng);
-    return generator();
+
+    /// A version 4, random, UUID as per RFC 4122.
+    boost::uuids::uuid
+    generate(RandomEngine& engine)
+    {
+      auto res = boost::uuids::uuid();
+      std::uint64_t const bits[2] = {engine(), engine()};
+      std::memcpy(res.data, bits, sizeof bits);
+      // Variant: RFC 4122.
+      res.data[8] = (res.data[8] & 0x3f) | 0x80;
+      // Version: random.
+      res.data[6] = (res.data[6] & 0x0f) | 0x40;
+      return res;
+    }
+  }
+
+  UUID
+  UUID::random()
+  {
+    return generate(engine());
+  }
+
+  std::vector<UUID>
+  UUID::random_many(std::size_t n)
+  {
+    auto& e = engine();
+    auto res = std::vector<UUID>{};
+    res.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+      res.emplace_back(generate(e));
+    return res;
   }
 
   /*----------------.
@@ -69,15 +126,29 @@ namespace elle
 
   namespace serialization
   {
-    std::string
-    Serialize<UUID>::convert(UUID& uuid)
+    void
+    Serialize<UUID>::serialize(UUID const& uuid, SerializerOut& s)
     {
-      return boost::lexical_cast<std::string>(uuid);
+      if (s.compact())
+        s._serialize_bytes(elle::unconst(uuid).data, uuid.size());
+      else
+      {
+        auto repr = uuid.repr();
+        Serializer::serialize_switch(s, repr);
+      }
     }
 
     UUID
-    Serialize<UUID>::convert(std::string& repr)
+    Serialize<UUID>::deserialize(SerializerIn& s)
     {
+      if (s.compact())
+      {
+        auto res = UUID();
+        s._serialize_bytes(res.data, res.size());
+        return res;
+      }
+      auto repr = std::string{};
+      Serializer::serialize_switch(s, repr);
       if (repr.empty())
         return UUID();
       return elle::UUID(repr);
@@ -1,6 +1,8 @@
 #ifndef ELLE_UUID_HH
 # define ELLE_UUID_HH
 
+# include <vector>
+
 # include <boost/functional/hash.hpp>
 # include <boost/uuid/uuid.hpp>
 # include <boost/uuid/uuid_io.hpp>
@@ -27,9 +29,18 @@ namespace elle
     /// Create from string representation.
     UUID(std::string const& repr);
     /// Create random UUID.
+    ///
+    /// Uses a random engine of the current thread, and is thus thread
+    /// safe. Unlike elle::random_engine, it is always seeded from
+    /// std::random_device, or the clock under valgrind, regardless of
+    /// ELLE_SEED.
     static
     UUID
     random();
+    /// Create @a n random UUIDs.
+    static
+    std::vector<UUID>
+    random_many(std::size_t n);
 
   /*----------.
   | Observers |
@@ -70,19 +81,18 @@ namespace elle
   /// Serialization
   ///
   /// Serialize UUID as strings. The empty string is considered a valid, nil
-  /// UUID.
+  /// UUID. Compact binary serializers store the 16 bytes as is.
   namespace serialization
   {
     template <>
     struct ELLE_API Serialize<UUID>
     {
-      using Type = std::string;
       static
-      std::string
-      convert(UUID& uuid);
+      void
+      serialize(UUID const& uuid, SerializerOut& s);
       static
       UUID
-      convert(std::string& repr);
+      deserialize(SerializerIn& s);
     };
   }
 }
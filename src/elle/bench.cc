@@ -1,5 +1,8 @@
 #include <elle/bench.hh>
 
+#include <functional>
+#include <limits>
+
 #include <elle/log.hh>
 #include <elle/printf.hh>
 
@@ -7,15 +10,42 @@ namespace
 {
   auto now()
   {
-    return std::chrono::system_clock::now();
+    return elle::Bench::Clock::now();
+  }
+
+  /// Nanoseconds to microseconds.
+  double
+  us(double ns)
+  {
+    return ns / 1000;
   }
+
+  /// Replace \a current by \a val if it \a precedes it.
+  template <typename Precedes>
+  void
+  keep(std::atomic<double>& current, double val, Precedes precedes)
+  {
+    auto c = current.load(std::memory_order_relaxed);
+    while (precedes(val, c) && !current.compare_exchange_weak(c, val))
+      ;
+  }
+
+  void
+  accumulate(std::atomic<double>& sum, double val)
+  {
+    auto s = sum.load(std::memory_order_relaxed);
+    while (!sum.compare_exchange_weak(s, s + val))
+      ;
+  }
+
+  auto constexpr infinity = std::numeric_limits<double>::infinity();
 }
 
 namespace elle
 {
   Bench::~Bench()
   {
-    if (this->_enabled && this->_count)
+    if (this->_window && this->_enabled && this->count())
       this->show();
   }
 
@@ -23,56 +53,107 @@ namespace elle
                Duration log_interval,
                int roundto)
     : _name(name)
+    , _histogram(metrics::registry().histogram(name, 1e-9))
+    , _window(std::make_shared<metrics::Histogram>())
     , _sum(0)
-    , _count(0)
-    , _min(0)
-    , _max(0)
+    , _min(infinity)
+    , _max(-infinity)
     , _log_interval(log_interval)
     , _roundfactor(std::pow(10, roundto))
     , _enabled{elle::log::detail::Send::active(elle::log::Logger::Level::trace,
                                                elle::log::Logger::Type::info,
                                                this->_name.c_str())}
-    , _start{now()}
+    , _start{now().time_since_epoch().count()}
+  {}
+
+  Bench::Bench(Bench&& source)
+    : _name(std::move(source._name))
+    , _histogram(std::move(source._histogram))
+    , _window(std::move(source._window))
+    , _sum(source._sum.load())
+    , _min(source._min.load())
+    , _max(source._max.load())
+    , _log_interval(source._log_interval)
+    , _roundfactor(source._roundfactor)
+    , _enabled(source._enabled)
+    , _start{source._start.load()}
   {}
 
   void
   Bench::add(double val)
   {
-    if (!this->_count)
-      this->_min = this->_max = val;
-    ++this->_count;
-    this->_sum += val;
-    this->_min = std::min(val, this->_min);
-    this->_max = std::max(val, this->_max);
-    if (this->_log_interval != Duration()
-        && now() - this->_start > this->_log_interval)
+    auto const ns = std::uint64_t(val > 0 ? val * 1000 : 0);
+    this->_histogram->record(ns);
+    this->_window->record(ns);
+    this->_added(val);
+  }
+
+  void
+  Bench::add(Duration d)
+  {
+    this->_histogram->record(d);
+    this->_window->record(d);
+    this->_added(
+      us(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count()));
+  }
+
+  void
+  Bench::_added(double val)
+  {
+    accumulate(this->_sum, val);
+    keep(this->_min, val, std::less<double>());
+    keep(this->_max, val, std::greater<double>());
+    if (this->_log_interval == Duration())
+      return;
+    auto start = this->_start.load(std::memory_order_relaxed);
+    auto const current = now().time_since_epoch();
+    // Only the thread that moves the start forward logs.
+    if (current - Duration(start) > this->_log_interval &&
+        this->_start.compare_exchange_strong(start, current.count()))
     {
       log();
-      reset();
+      this->_reset();
     }
   }
 
   void
   Bench::reset()
   {
-    this->_sum = this->_count = this->_min = this->_max = 0;
-    this->_start = now();
+    this->_reset();
+    this->_start = now().time_since_epoch().count();
+  }
+
+  void
+  Bench::_reset()
+  {
+    this->_window->reset();
+    this->_sum = 0;
+    this->_min = infinity;
+    this->_max = -infinity;
+  }
+
+  double
+  Bench::_mean() const
+  {
+    auto const count = this->count();
+    return count ? this->sum() / count : 0;
   }
 
   void
   Bench::log()
   {
     char const* _trace_component_ = this->_name.c_str();
+    auto const s = this->snapshot();
     ELLE_TRACE(
-      "%s: AVG %s, MIN %s, MAX %s, COUNT %s", this->_name,
-      std::round(double(this->_sum *
-                        this->_roundfactor /
-                        this->_count)) / this->_roundfactor,
-      this->_min, this->_max, this->_count);
+      "%s: AVG %s, MIN %s, MAX %s, P50 %s, P99 %s, COUNT %s", this->_name,
+      std::round(this->_mean() * this->_roundfactor) / this->_roundfactor,
+      this->min(), this->max(),
+      us(s.percentile(0.5)), us(s.percentile(0.99)), s.count);
   }
 
   void Bench::show()
   {
+    auto const s = this->snapshot();
     elle::log::detail::Send send(
       elle::log::Logger::Level::trace,
       elle::log::Logger::Type::info,
@@ -81,24 +162,75 @@ namespace elle
       __FILE__,
       __LINE__,
       ELLE_COMPILER_PRETTY_FUNCTION,
-      "AVG %s\tMIN %s\tMAX %s\tCNT %s\tTOT %s ms",
-      this->_sum / this->_count,
-      this->_min,
-      this->_max,
-      this->_count,
-      uint64_t(this->_sum) / 1000u);
+      "AVG %s\tMIN %s\tMAX %s\tP50 %s\tP99 %s\tCNT %s\tTOT %s ms",
+      this->_mean(),
+      this->min(),
+      this->max(),
+      us(s.percentile(0.5)),
+      us(s.percentile(0.99)),
+      s.count,
+      std::int64_t(this->sum()) / 1000);
   }
 
   void
   Bench::print(std::ostream& os) const
   {
+    auto const s = this->snapshot();
     elle::fprintf(os,
-      "AVG %12s %16tMIN %16s %32tMAX %12s %48tCNT %12s %64tTOT %8s ms",
-      this->_sum / this->_count,
-      this->_min,
-      this->_max,
-      this->_count,
-      uint64_t(this->_sum) / 1000u);
+      "AVG %12s %16tMIN %16s %32tMAX %12s %48tP99 %12s %64tCNT %12s "
+      "%80tTOT %8s ms",
+      this->_mean(),
+      this->min(),
+      this->max(),
+      us(s.percentile(0.99)),
+      s.count,
+      std::int64_t(this->sum()) / 1000);
+  }
+
+  double
+  Bench::sum() const
+  {
+    return this->_sum.load();
+  }
+
+  long
+  Bench::count() const
+  {
+    return this->snapshot().count;
+  }
+
+  double
+  Bench::min() const
+  {
+    auto const min = this->_min.load();
+    return min == infinity ? 0 : min;
+  }
+
+  double
+  Bench::max() const
+  {
+    auto const max = this->_max.load();
+    return max == -infinity ? 0 : max;
+  }
+
+  Bench::Duration
+  Bench::percentile(double p) const
+  {
+    return std::chrono::duration_cast<Duration>(
+      std::chrono::nanoseconds(
+        std::int64_t(this->snapshot().percentile(p))));
+  }
+
+  metrics::Histogram::Snapshot
+  Bench::snapshot() const
+  {
+    return this->_window->snapshot();
+  }
+
+  Bench::Time
+  Bench::start() const
+  {
+    return Time(Duration(this->_start.load()));
   }
 
   Bench::BenchScope::BenchScope(Bench& owner)
@@ -109,8 +241,6 @@ namespace elle
 
   Bench::BenchScope::~BenchScope()
   {
-    using ms = std::chrono::microseconds;
-    auto const d = std::chrono::duration_cast<ms>(now() - this->_start);
-    this->_owner.add(d.count());
+    this->_owner.add(now() - this->_start);
   }
 }
@@ -1,7 +1,12 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+
 #include <elle/attribute.hh>
 #include <elle/compiler.hh>
+#include <elle/metrics.hh>
 #include <elle/time.hh>
 
 namespace elle
@@ -9,7 +14,15 @@ namespace elle
 
   /// Bench a block of code or display statistics about some data.
   ///
-  /// N.B. The Bench is active if the LOG_LEVEL related is activated.
+  /// Values are recorded in the metrics::Histogram named after the Bench, in
+  /// the global metrics::registry, and are thus exported along other
+  /// metrics. The statistics the Bench reports cover its own window, since
+  /// the last reset, which leaves the exported histogram untouched. The
+  /// average, minimum, maximum and total are exact, whereas percentiles and
+  /// exported values are bucketed, in whole nanoseconds, negative values
+  /// counting as zero.
+  /// Recording is lock-free and always active; the Bench is only logged if
+  /// the LOG_LEVEL related is activated.
   ///
   /// @code{.cc}
   ///
@@ -20,14 +33,16 @@ namespace elle
   ///   ::usleep(10);
   /// }
   /// // Result (with ELLE_LOG_LEVEL="bench*:TRACE"):
-  /// [bench.loop] AVG: 1162.05 MIN: 1050 MAX: 2578 CNT: 1000 TOT: 1162 ms
+  /// [bench.loop] AVG: 1162.05 MIN: 1050 MAX: 2578 P50: 1153 P99: 2003
+  /// CNT: 1000 TOT: 1162 ms
   ///
   /// @endcode
   class ELLE_API Bench
   {
   public:
-    using Time = std::chrono::time_point<std::chrono::system_clock>;
-    using Duration = Time::duration;
+    using Clock = std::chrono::steady_clock;
+    using Time = Clock::time_point;
+    using Duration = Clock::duration;
 
     /// Construct a Bench.
     ///
@@ -37,18 +52,23 @@ namespace elle
     Bench(std::string const& name,
           Duration log_interval = {},
           int roundto = 2);
+    Bench(Bench&& source);
     /// Destroy the Bench.
     ///
     /// This call show() if the component is enabled.
     ~Bench();
-    /// Add a time period (in milliseconds) for a given Bench.
+    /// Add a value, e.g. a time period in microseconds.
     ///
     /// BenchScope automatically adds its lifetime duration to its owner Bench.
     ///
-    /// @param val A duration (in milliseconds) to add to the Bench.
+    /// @param val A value to add to the Bench, in microseconds for the
+    ///            percentiles and exported values to make sense.
     void
     add(double val);
-    /// Reset all underlying values of the Bench.
+    /// Add a time period.
+    void
+    add(Duration d);
+    /// Reset the Bench window. Exported values are kept.
     void
     reset();
     /// Output the Bench result.
@@ -69,16 +89,48 @@ namespace elle
       Bench& _owner;
     };
 
+    /// Total of the values, in microseconds.
+    double
+    sum() const;
+    long
+    count() const;
+    /// Smallest value, in microseconds.
+    double
+    min() const;
+    /// Largest value, in microseconds.
+    double
+    max() const;
+    /// The period longer than a ratio @a p of the others.
+    Duration
+    percentile(double p) const;
+    /// Current values.
+    metrics::Histogram::Snapshot
+    snapshot() const;
+    Time
+    start() const;
+
+  private:
+    void
+    _added(double val);
+    void
+    _reset();
+    /// Average value, in microseconds.
+    double
+    _mean() const;
     ELLE_ATTRIBUTE_R(std::string, name);
-    ELLE_ATTRIBUTE_R(double, sum);
-    ELLE_ATTRIBUTE_R(long, count);
-    ELLE_ATTRIBUTE_R(double, min);
-    ELLE_ATTRIBUTE_R(double, max);
+    /// The exported histogram, only ever added to.
+    ELLE_ATTRIBUTE(std::shared_ptr<metrics::Histogram>, histogram);
+    /// Values since the last reset, in nanoseconds.
+    ELLE_ATTRIBUTE(std::shared_ptr<metrics::Histogram>, window);
+    /// Exact statistics of the window, in microseconds.
+    ELLE_ATTRIBUTE(std::atomic<double>, sum);
+    ELLE_ATTRIBUTE(std::atomic<double>, min);
+    ELLE_ATTRIBUTE(std::atomic<double>, max);
     ELLE_ATTRIBUTE_R(Duration, log_interval);
     ELLE_ATTRIBUTE(double, roundfactor);
     ELLE_ATTRIBUTE_R(bool, enabled);
     // Make it last, so that it is set only when the remainder was
     // initialized.
-    ELLE_ATTRIBUTE_R(Time, start);
+    ELLE_ATTRIBUTE(std::atomic<Duration::rep>, start);
   };
 }
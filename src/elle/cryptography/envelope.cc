@@ -27,18 +27,78 @@ namespace elle
   {
     namespace envelope
     {
-      /*----------.
-      | Functions |
-      `----------*/
+      namespace
+      {
+        ::EVP_CIPHER_CTX*
+        _cipher_context()
+        {
+          // Make sure the cryptographic system is set up.
+          cryptography::require();
+          auto res = ::EVP_CIPHER_CTX_new();
+          if (!res)
+            throw Error(
+              elle::sprintf("unable to allocate the cipher context: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+          return res;
+        }
 
-      void
-      seal(::EVP_PKEY* key,
-           ::EVP_CIPHER const* cipher,
-           std::istream& plain,
-           std::ostream& code)
+        /// Make room for the output of a cipher update on @a size bytes.
+        unsigned char*
+        _reserve(std::vector<unsigned char>& output,
+                 ::EVP_CIPHER_CTX* context,
+                 std::size_t size)
+        {
+          auto const needed =
+            size + ::EVP_CIPHER_CTX_block_size(context);
+          if (output.size() < needed)
+            output.resize(needed);
+          return output.data();
+        }
+
+        /// Apply @a update to @a input by chunks of bounded size, handing the
+        /// result over to @a sink.
+        template <typename Update>
+        void
+        _update(::EVP_CIPHER_CTX* context,
+                std::vector<unsigned char>& output,
+                Sink const& sink,
+                elle::ConstWeakBuffer const& input,
+                Update update)
+        {
+          auto data = input.contents();
+          auto left = input.size();
+          while (left > 0)
+          {
+            auto const size =
+              std::min<std::size_t>(left, constants::stream_block_size);
+            auto const out = _reserve(output, context, size);
+            int size_update(0);
+            if (update(context, out, &size_update, data, int(size)) <= 0)
+              throw Error(
+                elle::sprintf("unable to apply the cipher function: %s",
+                              ::ERR_error_string(ERR_get_error(), nullptr)));
+            if (size_update > 0)
+              sink(elle::ConstWeakBuffer(out, size_update));
+            data += size;
+            left -= size;
+          }
+        }
+      }
+
+      /*-------.
+      | Sealer |
+      `-------*/
+
+      Sealer::Sealer(::EVP_PKEY* key,
+                     ::EVP_CIPHER const* cipher,
+                     Sink sink)
+        : _sink(std::move(sink))
+        , _context(_cipher_context())
+        , _output()
+        , _finalized(false)
       {
-        // Make sure the cryptographic system is set up.
-        cryptography::require();
+        elle::SafeFinally free_context(
+          [&] { ::EVP_CIPHER_CTX_free(this->_context); });
 
         // The following variables initialization are more complicated than
         // necessary but have been made for the reader to understand the way
@@ -50,35 +110,22 @@ namespace elle
         ::EVP_PKEY* keys[1];
         keys[0] = key;
 
-        // Create an array with a single secret key.
-        unsigned char* _secret =
-          reinterpret_cast<unsigned char*>(
-            ::OPENSSL_malloc(::EVP_PKEY_size(keys[0])));
-        ELLE_CRYPTOGRAPHY_FINALLY_ACTION_FREE_OPENSSL(_secret);
-
+        // Create an array with a single secret key, followed by the IV so
+        // that the header can be handed over at once.
+        auto const size = ::EVP_PKEY_size(key);
+        auto header = elle::Buffer(size + EVP_MAX_IV_LENGTH);
+        std::fill(header.begin(), header.end(), 0);
         unsigned char* secrets[1];
-        secrets[0] = _secret;
+        secrets[0] = header.mutable_contents();
         int lengths[1];
-
-        // Prepare the memory area to receive the IV.
-        unsigned char* iv =
-          reinterpret_cast<unsigned char*>(
-            ::OPENSSL_malloc(EVP_MAX_IV_LENGTH));
-        ELLE_CRYPTOGRAPHY_FINALLY_ACTION_FREE_OPENSSL(iv);
-
-        // Initialize the cipher context.
-        ::EVP_CIPHER_CTX context;
-
-        ::EVP_CIPHER_CTX_init(&context);
-
-        ELLE_CRYPTOGRAPHY_FINALLY_ACTION_CLEANUP_CIPHER_CONTEXT(context);
+        unsigned char* iv = header.mutable_contents() + size;
 
         // Initialize the envelope seal operation. This operation generates
         // a secret key for the provided cipher, and then encrypts that key a
         // number of times (one for each public key provided in the 'keys'
         // array, once in our case). This operation also generates an IV and
         // places it in 'iv'.
-        if (::EVP_SealInit(&context,
+        if (::EVP_SealInit(this->_context,
                            cipher,
                            secrets,
                            lengths,
@@ -89,11 +136,11 @@ namespace elle
             elle::sprintf("unable to initialize the seal process: %s",
                           ::ERR_error_string(ERR_get_error(), nullptr)));
 
-        ELLE_ASSERT_EQ(::EVP_PKEY_size(key), lengths[0]);
+        ELLE_ASSERT_EQ(size, lengths[0]);
 
-        // At this point, before writing the encrypted data in the output
-        // stream, the parameters (secret and IV) need to be written for
-        // the recipient to retrieve them.
+        // At this point, before handing over the encrypted data, the
+        // parameters (secret and IV) need to be output for the recipient to
+        // retrieve them.
         //
         // We could for instance serialize the header (secret and IV) through
         // a serialization layer on top of the output stream and then use the
@@ -104,229 +151,213 @@ namespace elle
         // For those reasons, the following simply outputs the secret and IV
         // whose size is supposed to be known in advanced according to the
         // cipher used.
-        {
-          // Write the secret.
-          code.write(reinterpret_cast<const char *>(_secret),
-                     ::EVP_PKEY_size(key));
-          if (!code.good())
-            throw Error(
-              elle::sprintf("unable to write the secret to the "
-                            "code's output stream: %s",
-                            code.rdstate()));
-
-          // Write the IV.
-          code.write(reinterpret_cast<const char *>(iv),
-                     EVP_MAX_IV_LENGTH);
-          if (!code.good())
-            throw Error(
-              elle::sprintf("unable to write the IV to the "
-                            "code's output stream: %s",
-                            code.rdstate()));
-        }
+        this->_sink(header);
 
-        // Compute the block size according to the
-        int block_size = ::EVP_CIPHER_CTX_block_size(&context);
-
-        // Encrypt the plain's stream.
-        std::vector<unsigned char> _input(constants::stream_block_size);
-        std::vector<unsigned char> _output(constants::stream_block_size +
-                                           block_size);
-
-        while (!plain.eof())
-        {
-          // Read the plain's input stream and put a block of data in a
-          // temporary buffer.
-          plain.read(reinterpret_cast<char*>(_input.data()), _input.size());
-          if (plain.bad())
-            throw Error(
-              elle::sprintf("unable to read the plain's input stream: %s",
-                            plain.rdstate()));
+        free_context.abort();
+      }
 
-          int size_update(0);
+      Sealer::Sealer(Sealer&& other)
+        : _sink(std::move(other._sink))
+        , _context(other._context)
+        , _output(std::move(other._output))
+        , _finalized(other._finalized)
+      {
+        other._context = nullptr;
+      }
 
-          // Encrypt the input buffer.
-          if (::EVP_SealUpdate(&context,
-                               _output.data(),
-                               &size_update,
-                               _input.data(),
-                               plain.gcount()) <= 0)
-            throw Error(
-              elle::sprintf("unable to apply the encryption function: %s",
-                            ::ERR_error_string(ERR_get_error(), nullptr)));
+      Sealer::~Sealer()
+      {
+        if (this->_context)
+          ::EVP_CIPHER_CTX_free(this->_context);
+      }
 
-          // Write the output buffer to the code stream.
-          code.write(reinterpret_cast<const char *>(_output.data()),
-                     size_update);
-          if (!code.good())
-            throw Error(
-              elle::sprintf("unable to write the encrypted data to the "
-                            "code's output stream: %s",
-                            code.rdstate()));
-        }
+      void
+      Sealer::update(elle::ConstWeakBuffer const& plain)
+      {
+        ELLE_ASSERT(!this->_finalized);
+        _update(this->_context, this->_output, this->_sink, plain,
+                [] (::EVP_CIPHER_CTX* context,
+                    unsigned char* out, int* outl,
+                    unsigned char const* in, int inl)
+                {
+                  return ::EVP_SealUpdate(context, out, outl, in, inl);
+                });
+      }
 
-        // Finalize the encryption process.
+      void
+      Sealer::finalize()
+      {
+        ELLE_ASSERT(!this->_finalized);
+        auto const out = _reserve(this->_output, this->_context, 0);
         int size_final(0);
-
-        if (::EVP_SealFinal(&context,
-                            _output.data(),
-                            &size_final) <= 0)
+        if (::EVP_SealFinal(this->_context, out, &size_final) <= 0)
           throw Error(
             elle::sprintf("unable to finalize the seal process: %s",
                           ::ERR_error_string(ERR_get_error(), nullptr)));
+        this->_finalized = true;
+        if (size_final > 0)
+          this->_sink(elle::ConstWeakBuffer(out, size_final));
+      }
 
-        // Write the final output buffer to the code's output stream.
-        code.write(reinterpret_cast<const char *>(_output.data()),
-                   size_final);
-        if (!code.good())
-          throw Error(
-            elle::sprintf("unable to write the encrypted data to the "
-                          "code's output stream: %s",
-                          code.rdstate()));
-
-        // Clean up the cipher context.
-        if (::EVP_CIPHER_CTX_cleanup(&context) <= 0)
-          throw Error(
-            elle::sprintf("unable to clean the cipher context: %s",
-                          ::ERR_error_string(ERR_get_error(), nullptr)));
-        ELLE_CRYPTOGRAPHY_FINALLY_ABORT(context);
+      /*-------.
+      | Opener |
+      `-------*/
+
+      Opener::Opener(::EVP_PKEY* key,
+                     ::EVP_CIPHER const* cipher,
+                     Sink sink)
+        : _key(key)
+        , _cipher(cipher)
+        , _sink(std::move(sink))
+        , _context(_cipher_context())
+        , _header()
+        , _output()
+        , _finalized(false)
+      {
+        this->_header.capacity(::EVP_PKEY_size(key) + EVP_MAX_IV_LENGTH);
+      }
 
-        // Release the memory associated with the secret and iv.
-        ::OPENSSL_free(iv);
-        ELLE_CRYPTOGRAPHY_FINALLY_ABORT(iv);
+      Opener::Opener(Opener&& other)
+        : _key(other._key)
+        , _cipher(other._cipher)
+        , _sink(std::move(other._sink))
+        , _context(other._context)
+        , _header(std::move(other._header))
+        , _output(std::move(other._output))
+        , _finalized(other._finalized)
+      {
+        other._context = nullptr;
+      }
 
-        ::OPENSSL_free(_secret);
-        ELLE_CRYPTOGRAPHY_FINALLY_ABORT(_secret);
+      Opener::~Opener()
+      {
+        if (this->_context)
+          ::EVP_CIPHER_CTX_free(this->_context);
       }
 
       void
-      open(::EVP_PKEY* key,
-           ::EVP_CIPHER const* cipher,
-           std::istream& code,
-           std::ostream& plain)
+      Opener::_init()
       {
-        // Make sure the cryptographic system is set up.
-        cryptography::require();
-
-        // Start by extracting the secret and IV from the input
-        // stream.
-        unsigned char* secret =
-          reinterpret_cast<unsigned char*>(
-            ::OPENSSL_malloc(::EVP_PKEY_size(key)));
-        ELLE_CRYPTOGRAPHY_FINALLY_ACTION_FREE_OPENSSL(secret);
-
-        unsigned char* iv =
-          reinterpret_cast<unsigned char*>(
-            ::OPENSSL_malloc(EVP_MAX_IV_LENGTH));
-        ELLE_CRYPTOGRAPHY_FINALLY_ACTION_FREE_OPENSSL(iv);
-
-        {
-          // Read the secret.
-          code.read(reinterpret_cast<char*>(secret), ::EVP_PKEY_size(key));
-          if (!code.good())
-            throw Error(
-              elle::sprintf("unable to read the secret from the code's "
-                            "input stream: %s",
-                            code.rdstate()));
-
-          // Read the IV.
-          code.read(reinterpret_cast<char*>(iv), EVP_MAX_IV_LENGTH);
-          if (!code.good())
-            throw Error(
-              elle::sprintf("unable to read the IV from the code's "
-                            "input stream: %s",
-                            code.rdstate()));
-        }
-
-        // Initialize the cipher context.
-        ::EVP_CIPHER_CTX context;
-
-        ::EVP_CIPHER_CTX_init(&context);
-
-        ELLE_CRYPTOGRAPHY_FINALLY_ACTION_CLEANUP_CIPHER_CONTEXT(context);
-
+        auto const size = ::EVP_PKEY_size(this->_key);
         // Initialize the envelope open operation.
-        if (::EVP_OpenInit(&context,
-                           cipher,
-                           secret,
-                           ::EVP_PKEY_size(key),
-                           iv,
-                           key) <= 0)
+        if (::EVP_OpenInit(this->_context,
+                           this->_cipher,
+                           this->_header.contents(),
+                           size,
+                           this->_header.contents() + size,
+                           this->_key) <= 0)
           throw Error(
             elle::sprintf("unable to initialize the open process: %s",
                           ::ERR_error_string(ERR_get_error(), nullptr)));
+      }
 
-        // Compute the block size according to the
-        int block_size = ::EVP_CIPHER_CTX_block_size(&context);
-
-        // Decrypt the plain's stream.
-        std::vector<unsigned char> _input(constants::stream_block_size);
-        std::vector<unsigned char> _output(constants::stream_block_size +
-                                           block_size);
-
-        while (!code.eof())
+      void
+      Opener::update(elle::ConstWeakBuffer const& code)
+      {
+        ELLE_ASSERT(!this->_finalized);
+        auto input = code;
+        auto const header_size =
+          std::size_t(::EVP_PKEY_size(this->_key) + EVP_MAX_IV_LENGTH);
+        // Start by extracting the secret and IV.
+        if (this->_header.size() < header_size)
         {
-          // Read the code's input stream and put a block of data in a
-          // temporary buffer.
-          code.read(reinterpret_cast<char*>(_input.data()), _input.size());
-          if (code.bad())
-            throw Error(
-              elle::sprintf("unable to read the code's input stream: %s",
-                            code.rdstate()));
-
-          int size_update(0);
-
-          // Decrypt the input buffer.
-          if (::EVP_OpenUpdate(&context,
-                               _output.data(),
-                               &size_update,
-                               _input.data(),
-                               code.gcount()) <= 0)
-            throw Error(
-              elle::sprintf("unable to apply the decryption function: %s",
-                            ::ERR_error_string(ERR_get_error(), nullptr)));
-
-          // Write the output buffer to the plain stream.
-          plain.write(reinterpret_cast<const char *>(_output.data()),
-                      size_update);
-          if (!plain.good())
-            throw Error(
-              elle::sprintf("unable to write the decrypted data to the "
-                            "plain's output stream: %s",
-                            plain.rdstate()));
+          auto const missing = header_size - this->_header.size();
+          auto const size = std::min(missing, input.size());
+          this->_header.append(input.contents(), size);
+          input = input.range(size);
+          if (this->_header.size() < header_size)
+            return;
+          this->_init();
         }
+        _update(this->_context, this->_output, this->_sink, input,
+                [] (::EVP_CIPHER_CTX* context,
+                    unsigned char* out, int* outl,
+                    unsigned char const* in, int inl)
+                {
+                  return ::EVP_OpenUpdate(context, out, outl, in, inl);
+                });
+      }
 
-        // Finalize the decryption process.
+      void
+      Opener::finalize()
+      {
+        ELLE_ASSERT(!this->_finalized);
+        if (this->_header.size() <
+            std::size_t(::EVP_PKEY_size(this->_key) + EVP_MAX_IV_LENGTH))
+          throw Error("unable to read the secret and IV: truncated envelope");
+        auto const out = _reserve(this->_output, this->_context, 0);
         int size_final(0);
-
-        if (::EVP_OpenFinal(&context,
-                            _output.data(),
-                            &size_final) <= 0)
+        if (::EVP_OpenFinal(this->_context, out, &size_final) <= 0)
           throw Error(
             elle::sprintf("unable to finalize the open process: %s",
                           ::ERR_error_string(ERR_get_error(), nullptr)));
+        this->_finalized = true;
+        if (size_final > 0)
+          this->_sink(elle::ConstWeakBuffer(out, size_final));
+      }
 
-        // Write the final output buffer to the plain's output stream.
-        plain.write(reinterpret_cast<const char *>(_output.data()),
-                   size_final);
-        if (!plain.good())
-          throw Error(
-            elle::sprintf("unable to write the decrypted data to the "
-                          "plain's output stream: %s",
-                          plain.rdstate()));
+      /*----------.
+      | Functions |
+      `----------*/
 
-        // Clean up the cipher context.
-        if (::EVP_CIPHER_CTX_cleanup(&context) <= 0)
-          throw Error(
-            elle::sprintf("unable to clean the cipher context: %s",
-                          ::ERR_error_string(ERR_get_error(), nullptr)));
-        ELLE_CRYPTOGRAPHY_FINALLY_ABORT(context);
+      namespace
+      {
+        /// Push the content of @a input through @a filter by blocks.
+        template <typename Filter>
+        void
+        _filter(Filter& filter,
+                std::istream& input,
+                std::string const& what)
+        {
+          std::vector<unsigned char> block(constants::stream_block_size);
+          while (!input.eof())
+          {
+            // Read the input stream and put a block of data in a
+            // temporary buffer.
+            input.read(reinterpret_cast<char*>(block.data()), block.size());
+            if (input.bad())
+              throw Error(
+                elle::sprintf("unable to read the %s's input stream: %s",
+                              what, input.rdstate()));
+            filter.update(elle::ConstWeakBuffer(block.data(), input.gcount()));
+          }
+          filter.finalize();
+        }
+
+        Sink
+        _stream_sink(std::ostream& output,
+                     std::string const& what)
+        {
+          return [&output, what] (elle::ConstWeakBuffer const& data)
+          {
+            output.write(reinterpret_cast<const char *>(data.contents()),
+                         data.size());
+            if (!output.good())
+              throw Error(
+                elle::sprintf("unable to write to the %s's output stream: %s",
+                              what, output.rdstate()));
+          };
+        }
+      }
 
-        // Release the memory associated with the secret and iv.
-        OPENSSL_free(iv);
-        ELLE_CRYPTOGRAPHY_FINALLY_ABORT(iv);
+      void
+      seal(::EVP_PKEY* key,
+           ::EVP_CIPHER const* cipher,
+           std::istream& plain,
+           std::ostream& code)
+      {
+        Sealer sealer(key, cipher, _stream_sink(code, "code"));
+        _filter(sealer, plain, "plain");
+      }
 
-        OPENSSL_free(secret);
-        ELLE_CRYPTOGRAPHY_FINALLY_ABORT(secret);
+      void
+      open(::EVP_PKEY* key,
+           ::EVP_CIPHER const* cipher,
+           std::istream& code,
+           std::ostream& plain)
+      {
+        Opener opener(key, cipher, _stream_sink(plain, "plain"));
+        _filter(opener, code, "code");
       }
     }
   }
@@ -5,9 +5,13 @@
 # include <elle/cryptography/Cipher.hh>
 # include <elle/cryptography/Oneway.hh>
 
+# include <elle/Buffer.hh>
+# include <elle/attribute.hh>
 # include <elle/fwd.hh>
 
+# include <functional>
 # include <memory>
+# include <vector>
 
 //
 // ---------- Asymmetric ------------------------------------------------------
@@ -38,6 +42,91 @@ namespace elle
            ::EVP_CIPHER const* cipher,
            std::istream& code,
            std::ostream& plain);
+
+      /*------.
+      | Types |
+      `------*/
+
+      /// Receive the output of a Sealer or an Opener, block by block.
+      ///
+      /// Blocks are only valid for the duration of the call.
+      using Sink = std::function<void (elle::ConstWeakBuffer const&)>;
+
+      /*-------.
+      | Sealer |
+      `-------*/
+
+      /// Seal data pushed block by block into an envelope.
+      ///
+      /// The envelope is the same as the one produced by seal(): the sealed
+      /// secret, the IV and the encrypted data. Memory usage is bounded
+      /// whatever the amount of data sealed.
+      class Sealer
+      {
+      public:
+        /// Start sealing with the given key and cipher.
+        ///
+        /// The envelope header is handed to @a sink right away.
+        Sealer(::EVP_PKEY* key,
+               ::EVP_CIPHER const* cipher,
+               Sink sink);
+        Sealer(Sealer&& other);
+        Sealer(Sealer const& other) = delete;
+        ~Sealer();
+
+      public:
+        /// Encrypt a block of plain text.
+        void
+        update(elle::ConstWeakBuffer const& plain);
+        /// Flush the last encrypted block.
+        void
+        finalize();
+
+      private:
+        ELLE_ATTRIBUTE(Sink, sink);
+        ELLE_ATTRIBUTE(::EVP_CIPHER_CTX*, context);
+        ELLE_ATTRIBUTE(std::vector<unsigned char>, output);
+        ELLE_ATTRIBUTE_R(bool, finalized);
+      };
+
+      /*-------.
+      | Opener |
+      `-------*/
+
+      /// Open an envelope pushed block by block, in any size.
+      ///
+      /// The key must outlive the opener.
+      class Opener
+      {
+      public:
+        /// Start opening with the given key and cipher.
+        Opener(::EVP_PKEY* key,
+               ::EVP_CIPHER const* cipher,
+               Sink sink);
+        Opener(Opener&& other);
+        Opener(Opener const& other) = delete;
+        ~Opener();
+
+      public:
+        /// Decrypt a block of the envelope.
+        void
+        update(elle::ConstWeakBuffer const& code);
+        /// Flush the last decrypted block and check the padding.
+        void
+        finalize();
+
+      private:
+        void
+        _init();
+        ELLE_ATTRIBUTE(::EVP_PKEY*, key);
+        ELLE_ATTRIBUTE(::EVP_CIPHER const*, cipher);
+        ELLE_ATTRIBUTE(Sink, sink);
+        ELLE_ATTRIBUTE(::EVP_CIPHER_CTX*, context);
+        /// The sealed secret and IV, until complete.
+        ELLE_ATTRIBUTE(elle::Buffer, header);
+        ELLE_ATTRIBUTE(std::vector<unsigned char>, output);
+        ELLE_ATTRIBUTE_R(bool, finalized);
+      };
     }
   }
 }
@@ -1,5 +1,10 @@
-# include <openssl/evp.h>
+#include <unordered_map>
 
+#include <openssl/err.h>
+#include <openssl/evp.h>
+
+#include <elle/cryptography/Error.hh>
+#include <elle/cryptography/cryptography.hh>
 #include <elle/cryptography/hash.hh>
 #include <elle/cryptography/raw.hh>
 
@@ -10,17 +15,127 @@ namespace elle
 {
   namespace cryptography
   {
+    /*-------.
+    | Hasher |
+    `-------*/
+
+    Hasher::Hasher(Oneway const oneway)
+      : _oneway(oneway)
+      , _function(oneway::resolve(oneway))
+      , _context(nullptr)
+    {
+      // Make sure the cryptographic system is set up.
+      cryptography::require();
+      if ((this->_context = ::EVP_MD_CTX_create()) == nullptr)
+        throw Error(
+          elle::sprintf("unable to allocate the digest context: %s",
+                        ::ERR_error_string(ERR_get_error(), nullptr)));
+      try
+      {
+        this->reset();
+      }
+      catch (...)
+      {
+        ::EVP_MD_CTX_destroy(this->_context);
+        throw;
+      }
+    }
+
+    Hasher::Hasher(Hasher&& other)
+      : _oneway(other._oneway)
+      , _function(other._function)
+      , _context(other._context)
+    {
+      other._context = nullptr;
+    }
+
+    Hasher::~Hasher()
+    {
+      if (this->_context)
+        ::EVP_MD_CTX_destroy(this->_context);
+    }
+
+    void
+    Hasher::update(elle::ConstWeakBuffer const& data)
+    {
+      if (::EVP_DigestUpdate(this->_context,
+                             data.contents(),
+                             data.size()) <= 0)
+        throw Error(
+          elle::sprintf("unable to apply the digest function: %s",
+                        ::ERR_error_string(ERR_get_error(), nullptr)));
+    }
+
+    elle::Buffer
+    Hasher::finalize()
+    {
+      elle::Buffer digest(EVP_MD_size(this->_function));
+      unsigned int size(0);
+      if (::EVP_DigestFinal_ex(this->_context,
+                               digest.mutable_contents(),
+                               &size) <= 0)
+        throw Error(
+          elle::sprintf("unable to finalize the digest process: %s",
+                        ::ERR_error_string(ERR_get_error(), nullptr)));
+      digest.size(size);
+      this->reset();
+      return (digest);
+    }
+
+    void
+    Hasher::reset()
+    {
+      // Initializing a context with the digest it already uses does not
+      // reallocate it.
+      if (::EVP_DigestInit_ex(this->_context, this->_function, nullptr) <= 0)
+        throw Error(
+          elle::sprintf("unable to initialize the digest process: %s",
+                        ::ERR_error_string(ERR_get_error(), nullptr)));
+    }
+
     /*----------.
     | Functions |
     `----------*/
 
+    namespace
+    {
+      /// The calling thread's hasher for the given oneway function.
+      ///
+      /// Only use it to hash data in one go: hashing a stream could yield
+      /// to another coroutine of the same thread in the middle of the
+      /// digest.
+      Hasher&
+      _hasher(Oneway const oneway)
+      {
+        static thread_local std::unordered_map<int, Hasher> hashers;
+        auto it = hashers.find(static_cast<int>(oneway));
+        if (it == hashers.end())
+          it = hashers.emplace(static_cast<int>(oneway), Hasher(oneway)).first;
+        return it->second;
+      }
+
+      elle::Buffer
+      _hash(Hasher& hasher,
+            elle::ConstWeakBuffer const& plain)
+      {
+        try
+        {
+          hasher.update(plain);
+          return hasher.finalize();
+        }
+        catch (...)
+        {
+          hasher.reset();
+          throw;
+        }
+      }
+    }
+
     elle::Buffer
     hash(elle::ConstWeakBuffer const& plain,
          Oneway const oneway)
     {
-      elle::IOStream _plain(plain.istreambuf());
-
-      return (hash(_plain, oneway));
+      return (_hash(_hasher(oneway), plain));
     }
 
     elle::Buffer
@@ -41,5 +156,17 @@ namespace elle
 
       return (raw::hash(function, plain));
     }
+
+    std::vector<elle::Buffer>
+    hash_many(std::vector<elle::ConstWeakBuffer> const& plains,
+              Oneway const oneway)
+    {
+      auto& hasher = _hasher(oneway);
+      auto res = std::vector<elle::Buffer>();
+      res.reserve(plains.size());
+      for (auto const& plain: plains)
+        res.emplace_back(_hash(hasher, plain));
+      return res;
+    }
   }
 }
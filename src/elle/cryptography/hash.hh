@@ -5,6 +5,9 @@
 # include <elle/cryptography/Oneway.hh>
 
 # include <iosfwd>
+# include <vector>
+
+# include <elle/attribute.hh>
 
 namespace elle
 {
@@ -25,6 +28,45 @@ namespace elle
     elle::Buffer
     hash(std::istream& plain,
          Oneway const oneway);
+    /// Hash every plain text of a batch and return their digests, in order.
+    std::vector<elle::Buffer>
+    hash_many(std::vector<elle::ConstWeakBuffer> const& plains,
+              Oneway const oneway);
+
+    /*-------.
+    | Hasher |
+    `-------*/
+
+    /// Compute a digest incrementally.
+    ///
+    /// The digest context is set up once and reused from one digest to the
+    /// next, which saves its allocation and initialization when hashing many
+    /// small buffers in a row.
+    class Hasher
+    {
+    public:
+      /// Construct a hasher for the given oneway function.
+      Hasher(Oneway const oneway);
+      Hasher(Hasher&& other);
+      Hasher(Hasher const& other) = delete;
+      ~Hasher();
+
+    public:
+      /// Feed data to the digest.
+      void
+      update(elle::ConstWeakBuffer const& data);
+      /// Return the digest of the data fed so far, and start over.
+      elle::Buffer
+      finalize();
+      /// Drop the data fed so far.
+      void
+      reset();
+
+    private:
+      ELLE_ATTRIBUTE_R(Oneway, oneway);
+      ELLE_ATTRIBUTE(::EVP_MD const*, function);
+      ELLE_ATTRIBUTE(::EVP_MD_CTX*, context);
+    };
   }
 }
 
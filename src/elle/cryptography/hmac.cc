@@ -1,9 +1,11 @@
 #include <openssl/err.h>
 #include <openssl/evp.h>
+#include <openssl/hmac.h>
 
 #include <elle/Buffer.hh>
 #include <elle/log.hh>
 
+#include <elle/cryptography/cryptography.hh>
 #include <elle/cryptography/hmac.hh>
 #include <elle/cryptography/raw.hh>
 #include <elle/cryptography/finally.hh>
@@ -15,17 +17,156 @@ namespace elle
   {
     namespace hmac
     {
+      /*-------.
+      | HMACer |
+      `-------*/
+
+      HMACer::HMACer(std::string const& key,
+                     Oneway const oneway)
+        : _oneway(oneway)
+        , _context(new ::HMAC_CTX)
+      {
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+        ::HMAC_CTX_init(this->_context);
+        if (::HMAC_Init_ex(this->_context,
+                           key.data(), key.size(),
+                           oneway::resolve(oneway),
+                           nullptr) <= 0)
+        {
+          ::HMAC_CTX_cleanup(this->_context);
+          delete this->_context;
+          throw Error(
+            elle::sprintf("unable to initialize the HMAC process: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+        }
+      }
+
+      HMACer::HMACer(HMACer&& other)
+        : _oneway(other._oneway)
+        , _context(other._context)
+      {
+        other._context = nullptr;
+      }
+
+      HMACer::~HMACer()
+      {
+        if (this->_context)
+        {
+          ::HMAC_CTX_cleanup(this->_context);
+          delete this->_context;
+        }
+      }
+
+      void
+      HMACer::update(elle::ConstWeakBuffer const& data)
+      {
+        if (::HMAC_Update(this->_context,
+                          data.contents(),
+                          data.size()) <= 0)
+          throw Error(
+            elle::sprintf("unable to apply the HMAC function: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+      }
+
+      elle::Buffer
+      HMACer::finalize()
+      {
+        elle::Buffer digest(EVP_MAX_MD_SIZE);
+        unsigned int size(0);
+        if (::HMAC_Final(this->_context,
+                         digest.mutable_contents(),
+                         &size) <= 0)
+          throw Error(
+            elle::sprintf("unable to finalize the HMAC process: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+        digest.size(size);
+        digest.shrink_to_fit();
+        this->reset();
+        return (digest);
+      }
+
+      void
+      HMACer::reset()
+      {
+        // Passing no key nor digest function restarts with the same ones.
+        if (::HMAC_Init_ex(this->_context, nullptr, 0, nullptr, nullptr) <= 0)
+          throw Error(
+            elle::sprintf("unable to initialize the HMAC process: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+      }
+
       /*----------.
       | Functions |
       `----------*/
 
+      namespace
+      {
+        /// The calling thread's HMAC context, rekeyed on every use so that
+        /// its digest contexts are only allocated once.
+        ::HMAC_CTX*
+        _context()
+        {
+          struct Context
+          {
+            Context()
+            {
+              ::HMAC_CTX_init(&this->context);
+            }
+
+            ~Context()
+            {
+              ::HMAC_CTX_cleanup(&this->context);
+            }
+
+            ::HMAC_CTX context;
+          };
+          static thread_local Context context;
+          return &context.context;
+        }
+      }
+
       elle::Buffer
       sign(elle::ConstWeakBuffer const& plain,
            std::string const& key,
            Oneway const oneway)
       {
-        elle::IOStream _plain(plain.istreambuf());
-        return (sign(_plain, key, oneway));
+        // Make sure the cryptographic system is set up.
+        cryptography::require();
+        auto context = _context();
+        if (::HMAC_Init_ex(context,
+                           key.data(), key.size(),
+                           oneway::resolve(oneway),
+                           nullptr) <= 0 ||
+            ::HMAC_Update(context, plain.contents(), plain.size()) <= 0)
+          throw Error(
+            elle::sprintf("unable to apply the HMAC function: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+        elle::Buffer digest(EVP_MAX_MD_SIZE);
+        unsigned int size(0);
+        if (::HMAC_Final(context, digest.mutable_contents(), &size) <= 0)
+          throw Error(
+            elle::sprintf("unable to finalize the HMAC process: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+        digest.size(size);
+        digest.shrink_to_fit();
+        return (digest);
+      }
+
+      namespace
+      {
+        bool
+        _equal(elle::ConstWeakBuffer const& digest,
+               elle::ConstWeakBuffer const& expected)
+        {
+          if (digest.size() != expected.size())
+            return (false);
+          // Compare using low-level OpenSSL functions to prevent timing
+          // attacks.
+          return (CRYPTO_memcmp(digest.contents(),
+                                expected.contents(),
+                                expected.size()) == 0);
+        }
       }
 
       bool
@@ -34,8 +175,8 @@ namespace elle
              std::string const& key,
              Oneway const oneway)
       {
-        elle::IOStream _plain(plain.istreambuf());
-        return (verify(digest, _plain, key, oneway));
+        auto const expected = sign(plain, key, oneway);
+        return (_equal(digest, expected));
       }
 
       elle::Buffer
@@ -72,19 +213,8 @@ namespace elle
              std::string const& key,
              Oneway const oneway)
       {
-        elle::Buffer _digest = sign(plain, key, oneway);
-
-        if (digest.size() != _digest.size())
-          return (false);
-
-        // Compare using low-level OpenSSL functions to prevent timing attacks.
-        if (CRYPTO_memcmp(digest.contents(),
-                          _digest.contents(),
-                          _digest.size()) != 0)
-          return (false);
-
-        return (true);
-
+        auto const expected = sign(plain, key, oneway);
+        return (_equal(digest, expected));
       }
     }
   }
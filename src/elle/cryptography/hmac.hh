@@ -6,6 +6,8 @@
 
 # include <iosfwd>
 
+# include <elle/attribute.hh>
+
 namespace elle
 {
   namespace cryptography
@@ -64,6 +66,40 @@ namespace elle
              std::istream& plain,
              K const& key,
              Oneway const oneway);
+
+      /*-------.
+      | HMACer |
+      `-------*/
+
+      /// Compute a HMAC incrementally with a string-based key.
+      ///
+      /// The key is set up once: starting over for the next digest only
+      /// restores the keyed context.
+      class HMACer
+      {
+      public:
+        /// Construct a HMACer for the given key and oneway function.
+        HMACer(std::string const& key,
+               Oneway const oneway);
+        HMACer(HMACer&& other);
+        HMACer(HMACer const& other) = delete;
+        ~HMACer();
+
+      public:
+        /// Feed data to the HMAC.
+        void
+        update(elle::ConstWeakBuffer const& data);
+        /// Return the HMAC of the data fed so far, and start over.
+        elle::Buffer
+        finalize();
+        /// Drop the data fed so far.
+        void
+        reset();
+
+      private:
+        ELLE_ATTRIBUTE_R(Oneway, oneway);
+        ELLE_ATTRIBUTE(::HMAC_CTX*, context);
+      };
     }
   }
 }
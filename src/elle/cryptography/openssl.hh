@@ -11,4 +11,5 @@ typedef struct dh_st DH;
 typedef struct bignum_st BIGNUM;
 typedef struct evp_cipher_st EVP_CIPHER;
 typedef struct evp_cipher_ctx_st EVP_CIPHER_CTX;
+typedef struct hmac_ctx_st HMAC_CTX;
 // typedef struct bignum_ctx BN_CTX;
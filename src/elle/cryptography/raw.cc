@@ -33,14 +33,6 @@ static const int buffer_sizes[] = {
   elle::cryptography::constants::stream_block_size + max_block_size
 };
 
-static
-std::mutex&
-_buffers_mutex()
-{
-  static std::mutex mutex;
-  return mutex;
-}
-
 struct BufferDeleter
 {
   void operator()(unsigned char* buf)
@@ -49,25 +41,16 @@ struct BufferDeleter
   }
 };
 
+/// The calling thread's scratch buffers.
 static
 std::pair<unsigned char*, unsigned char*>
 buffers()
 {
   using UPTR = std::unique_ptr<unsigned char, BufferDeleter>;
-  static std::unordered_map<std::thread::id, std::pair<UPTR, UPTR>> map;
-  std::unique_lock<std::mutex> ulock(_buffers_mutex());
-  auto tid = std::this_thread::get_id();
-  auto it = map.find(tid);
-  if (it != map.end())
-    return std::make_pair(it->second.first.get(), it->second.second.get());
-  else
-  {
-    auto p = std::make_pair(UPTR((unsigned char*)malloc(buffer_sizes[0])),
-                              UPTR((unsigned char*)malloc(buffer_sizes[1])));
-    auto res = std::make_pair(p.first.get(), p.second.get());
-    map[tid] = std::move(p);
-    return res;
-  }
+  static thread_local auto const buffers =
+    std::make_pair(UPTR((unsigned char*)malloc(buffer_sizes[0])),
+                   UPTR((unsigned char*)malloc(buffer_sizes[1])));
+  return std::make_pair(buffers.first.get(), buffers.second.get());
 }
 
 //
@@ -841,6 +824,68 @@ namespace elle
   {
     namespace raw
     {
+      namespace
+      {
+        /// Hash the data fed by @a feed, a callable taking a function to
+        /// apply to every block.
+        ///
+        /// Blocks are handed over without being copied, and without going
+        /// through a std::function for every one of them.
+        template <typename Feed>
+        elle::Buffer
+        _hash(::EVP_MD const* oneway,
+              Feed const& feed,
+              std::function<void (::EVP_MD_CTX*)> const& prolog,
+              std::function<void (::EVP_MD_CTX*)> const& epilog)
+        {
+          // Make sure the cryptographic system is set up.
+          cryptography::require();
+          // Initialise the context.
+          ::EVP_MD_CTX context;
+          ::EVP_MD_CTX_init(&context);
+          ELLE_CRYPTOGRAPHY_FINALLY_ACTION_CLEANUP_DIGEST_CONTEXT(context);
+          // Initialise the digest.
+          if (::EVP_DigestInit_ex(&context, oneway, nullptr) <= 0)
+            throw Error(
+              elle::sprintf("unable to initialize the digest process: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+          if (prolog)
+            prolog(&context);
+          feed(
+            [&] (void const* data, std::size_t size)
+            {
+              // Update the digest context.
+              if (::EVP_DigestUpdate(&context, data, size) <= 0)
+                throw Error(
+                  elle::sprintf("unable to apply the digest function: %s",
+                                ::ERR_error_string(ERR_get_error(),
+                                                   nullptr)));
+            });
+          // Allocate the output digest.
+          elle::Buffer digest(EVP_MD_size(oneway));
+          if (epilog)
+            epilog(&context);
+          // Finalize the digest.
+          unsigned int size(0);
+          if (::EVP_DigestFinal_ex(&context,
+                                   digest.mutable_contents(),
+                                   &size) <= 0)
+            throw Error(
+              elle::sprintf("unable to finalize the digest process: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+          // Update the digest final size.
+          digest.size(size);
+          digest.shrink_to_fit();
+          // Clean the context.
+          if (::EVP_MD_CTX_cleanup(&context) <= 0)
+            throw Error(
+              elle::sprintf("unable to clean the digest context: %s",
+                            ::ERR_error_string(ERR_get_error(), nullptr)));
+          ELLE_CRYPTOGRAPHY_FINALLY_ABORT(context);
+          return (digest);
+        }
+      }
+
       elle::Buffer
       hash(::EVP_MD const* oneway,
            std::istream& plain,
@@ -849,22 +894,23 @@ namespace elle
       {
         // Hash the plain's stream.
         unsigned char* _input = buffers().first;
-        elle::Buffer buffer;
-        auto next_block = [&] () -> elle::ConstWeakBuffer {
-          if (plain.eof())
-            return elle::ConstWeakBuffer();
-          // Read the plain's input stream and put a block of data in a
-          // temporary buffer.
-          plain.read(reinterpret_cast<char*>(_input),
-                     constants::stream_block_size);
-          if (plain.bad())
-            throw Error(
-              elle::sprintf("unable to read the plain's input stream: %s",
-                            plain.rdstate()));
-          buffer = elle::Buffer(_input, plain.gcount());
-          return buffer;
-        };
-        return (hash(oneway, next_block, prolog, epilog));
+        auto feed = [&] (auto const& update)
+          {
+            while (!plain.eof())
+            {
+              // Read the plain's input stream and put a block of data in a
+              // temporary buffer.
+              plain.read(reinterpret_cast<char*>(_input),
+                         constants::stream_block_size);
+              if (plain.bad())
+                throw Error(
+                  elle::sprintf("unable to read the plain's input stream: %s",
+                                plain.rdstate()));
+              if (plain.gcount() > 0)
+                update(_input, plain.gcount());
+            }
+          };
+        return (_hash(oneway, feed, prolog, epilog));
       }
 
       elle::Buffer
@@ -873,56 +919,17 @@ namespace elle
            std::function<void (::EVP_MD_CTX*)> prolog,
            std::function<void (::EVP_MD_CTX*)> epilog)
       {
-        // Make sure the cryptographic system is set up.
-        cryptography::require();
-        // Initialise the context.
-        ::EVP_MD_CTX context;
-        ::EVP_MD_CTX_init(&context);
-        ELLE_CRYPTOGRAPHY_FINALLY_ACTION_CLEANUP_DIGEST_CONTEXT(context);
-        // Initialise the digest.
-        if (::EVP_DigestInit_ex(&context, oneway, nullptr) <= 0)
-          throw Error(
-            elle::sprintf("unable to initialize the digest process: %s",
-                          ::ERR_error_string(ERR_get_error(), nullptr)));
-        if (prolog)
-          prolog(&context);
-        unsigned read = 0;
-        while (true)
-        {
-          auto const& buffer = next_block();
-          read += buffer.size();
-          if (buffer.size() == 0)
-            break;
-          // Update the digest context.
-          if (::EVP_DigestUpdate(&context,
-                                 buffer.contents(),
-                                 buffer.size()) <= 0)
-            throw Error(
-              elle::sprintf("unable to apply the digest function: %s",
-                            ::ERR_error_string(ERR_get_error(), nullptr)));
-        }
-        // Allocate the output digest.
-        elle::Buffer digest(EVP_MD_size(oneway));
-        if (epilog)
-          epilog(&context);
-        // Finalize the digest.
-        unsigned int size(0);
-        if (::EVP_DigestFinal_ex(&context,
-                                 digest.mutable_contents(),
-                                 &size) <= 0)
-          throw Error(
-            elle::sprintf("unable to finalize the digest process: %s",
-                          ::ERR_error_string(ERR_get_error(), nullptr)));
-        // Update the digest final size.
-        digest.size(size);
-        digest.shrink_to_fit();
-        // Clean the context.
-        if (::EVP_MD_CTX_cleanup(&context) <= 0)
-          throw Error(
-            elle::sprintf("unable to clean the digest context: %s",
-                          ::ERR_error_string(ERR_get_error(), nullptr)));
-        ELLE_CRYPTOGRAPHY_FINALLY_ABORT(context);
-        return (digest);
+        auto feed = [&] (auto const& update)
+          {
+            while (true)
+            {
+              auto const& buffer = next_block();
+              if (buffer.size() == 0)
+                break;
+              update(buffer.contents(), buffer.size());
+            }
+          };
+        return (_hash(oneway, feed, prolog, epilog));
       }
     }
   }
@@ -1,12 +1,8 @@
 #ifndef ELLE_CRYPTOGRAPHY_RSA_KEYPOOL_HH
 # define ELLE_CRYPTOGRAPHY_RSA_KEYPOOL_HH
 
-# include <condition_variable>
-# include <thread>
-# include <vector>
-
 # include <elle/cryptography/rsa/KeyPair.hh>
-# include <elle/ProducerPool.hh>
+# include <elle/reactor/ProducerPool.hh>
 
 namespace elle
 {
@@ -14,13 +10,22 @@ namespace elle
   {
     namespace rsa
     {
+      /// A pool of pregenerated RSA keypairs.
+      ///
+      /// Keys are generated in the background: a reactor::Thread getting a
+      /// key from an empty pool waits for one without blocking the
+      /// scheduler. It must thus be used from within a reactor::Scheduler.
       class KeyPool
-        : public elle::ProducerPool<KeyPair>
+        : public elle::reactor::ProducerPool<KeyPair>
       {
       public:
+        /// Keep @a max_pool_size keys of @a key_size bits ready, generating
+        /// @a thread_count of them in parallel.
         KeyPool(int key_size, int max_pool_size, int thread_count = 1)
-        : ProducerPool<KeyPair>(
-            [key_size] { return keypair::generate(key_size);},
+          : elle::reactor::ProducerPool<KeyPair>(
+            "rsa keys",
+            [key_size] { return keypair::generate(key_size); },
+            max_pool_size,
             max_pool_size,
             thread_count)
         {}
@@ -188,13 +188,19 @@ namespace elle
                        Cipher const cipher,
                        Mode const mode) const
       {
-        auto is = elle::IOStream(code.istreambuf());
-        std::stringstream plain;
-
-        this->open(is, plain,
-                   cipher, mode);
+        elle::Buffer plain;
+        // The plain text is at most as large as the encrypted data.
+        plain.capacity(code.size());
+        auto opener = this->opener(
+          [&plain] (elle::ConstWeakBuffer const& data)
+          {
+            plain.append(data.contents(), data.size());
+          },
+          cipher, mode);
+        opener.update(code);
+        opener.finalize();
 
-        return plain.str();
+        return plain;
       }
 
       void
@@ -209,6 +215,16 @@ namespace elle
                        plain);
       }
 
+      envelope::Opener
+      PrivateKey::opener(envelope::Sink plain,
+                         Cipher const cipher,
+                         Mode const mode) const
+      {
+        return envelope::Opener(this->_key.get(),
+                                cipher::resolve(cipher, mode),
+                                std::move(plain));
+      }
+
       elle::Buffer
       PrivateKey::decrypt(elle::ConstWeakBuffer const& code,
                           Padding const padding) const
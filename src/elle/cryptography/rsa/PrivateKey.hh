@@ -11,6 +11,7 @@
 #include <elle/cryptography/types.hh>
 #include <elle/cryptography/Oneway.hh>
 #include <elle/cryptography/Cipher.hh>
+#include <elle/cryptography/envelope.hh>
 #if defined(ELLE_CRYPTOGRAPHY_ROTATION)
 # include <elle/cryptography/rsa/Seed.hh>
 #endif
@@ -74,6 +75,14 @@ namespace elle
              std::ostream& plain,
              Cipher const cipher = defaults::envelope_cipher,
              Mode const mode = defaults::envelope_mode) const;
+        /// Start opening an envelope pushed block by block, the plain text
+        /// being handed over to @a plain as it is produced.
+        ///
+        /// The key must outlive the opener.
+        envelope::Opener
+        opener(envelope::Sink plain,
+               Cipher const cipher = defaults::envelope_cipher,
+               Mode const mode = defaults::envelope_mode) const;
         /// Decrypt a code with the raw public key.
         ///
         /// WARNING: This method cannot be used to decrypt large amount of
@@ -5,7 +5,11 @@
 #include <openssl/pem.h>
 #include <openssl/evp.h>
 
+#include <algorithm>
+#include <exception>
 #include <functional>
+#include <iterator>
+#include <thread>
 
 #include <elle/Error.hh>
 #include <elle/finally.hh>
@@ -18,6 +22,7 @@
 #include <elle/cryptography/rsa/KeyPair.hh>
 #include <elle/cryptography/rsa/Seed.hh>
 #include <elle/cryptography/rsa/Padding.hh>
+#include <elle/cryptography/rsa/SignatureCache.hh>
 #include <elle/cryptography/rsa/low.hh>
 #include <elle/cryptography/rsa/serialization.hh>
 #include <elle/cryptography/rsa/der.hh>
@@ -156,13 +161,18 @@ namespace elle
       {
         ELLE_DUMP("plain: %x", plain);
 
-        elle::IOStream _plain(plain.istreambuf());
-        std::stringstream _code;
-
-        this->seal(_plain, _code,
-                   cipher, mode);
-
-        elle::Buffer code(_code.str().data(), _code.str().length());
+        elle::Buffer code;
+        // The header, the plain text and at most one block of padding.
+        code.capacity(::EVP_PKEY_size(this->_key.get()) + EVP_MAX_IV_LENGTH +
+                      plain.size() + EVP_MAX_BLOCK_LENGTH);
+        auto sealer = this->sealer(
+          [&code] (elle::ConstWeakBuffer const& data)
+          {
+            code.append(data.contents(), data.size());
+          },
+          cipher, mode);
+        sealer.update(plain);
+        sealer.finalize();
 
         return (code);
       }
@@ -179,6 +189,16 @@ namespace elle
                        code);
       }
 
+      envelope::Sealer
+      PublicKey::sealer(envelope::Sink code,
+                        Cipher const cipher,
+                        Mode const mode) const
+      {
+        return envelope::Sealer(this->_key.get(),
+                                cipher::resolve(cipher, mode),
+                                std::move(code));
+      }
+
       elle::Buffer
       PublicKey::encrypt(elle::ConstWeakBuffer const& plain,
                          Padding const padding) const
@@ -218,6 +238,58 @@ namespace elle
         return this->_verify(signature, _plain, padding, oneway);
       }
 
+      std::vector<bool>
+      PublicKey::verify_many(std::vector<Verification> const& batch,
+                             SignatureCache* cache,
+                             Padding const padding,
+                             Oneway const oneway,
+                             unsigned int parallelism,
+                             Fanout const& fanout) const
+      {
+        ELLE_TRACE_SCOPE("%s: verify %s signatures", this, batch.size());
+        if (parallelism == 0)
+          parallelism = std::max(std::thread::hardware_concurrency(), 1u);
+        parallelism = std::min<std::size_t>(parallelism, batch.size());
+        // std::vector<bool> elements cannot be written concurrently.
+        auto results = std::vector<char>(batch.size(), false);
+        auto errors = std::vector<std::exception_ptr>(parallelism);
+        auto workers = std::vector<std::function<void ()>>();
+        for (unsigned int worker = 0; worker < parallelism; ++worker)
+          workers.emplace_back(
+            [&, worker]
+            {
+              try
+              {
+                for (auto i = worker; i < batch.size(); i += parallelism)
+                {
+                  auto const& v = batch[i];
+                  results[i] = cache
+                    ? cache->verify(*this, v.first, v.second, padding, oneway)
+                    : this->_verify(v.first, v.second, padding, oneway);
+                }
+              }
+              catch (...)
+              {
+                errors[worker] = std::current_exception();
+              }
+            });
+        if (fanout)
+          fanout(workers);
+        else if (!workers.empty())
+        {
+          auto threads = std::vector<std::thread>();
+          for (auto it = std::next(workers.begin()); it != workers.end(); ++it)
+            threads.emplace_back(*it);
+          workers.front()();
+          for (auto& t: threads)
+            t.join();
+        }
+        for (auto const& e: errors)
+          if (e)
+            std::rethrow_exception(e);
+        return {results.begin(), results.end()};
+      }
+
       bool
       PublicKey::verify(elle::ConstWeakBuffer const& signature,
                         std::istream& plain,
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include <boost/operators.hpp>
 
@@ -13,6 +15,7 @@
 #include <elle/cryptography/types.hh>
 #include <elle/cryptography/Oneway.hh>
 #include <elle/cryptography/Cipher.hh>
+#include <elle/cryptography/envelope.hh>
 #if defined(ELLE_CRYPTOGRAPHY_ROTATION)
 # include <elle/cryptography/rsa/Seed.hh>
 #endif
@@ -71,6 +74,12 @@ namespace elle
              std::ostream& code,
              Cipher const cipher = defaults::envelope_cipher,
              Mode const mode = defaults::envelope_mode) const;
+        /// Start sealing plain text pushed block by block in an envelope,
+        /// handed over to @a code as it is produced.
+        envelope::Sealer
+        sealer(envelope::Sink code,
+               Cipher const cipher = defaults::envelope_cipher,
+               Mode const mode = defaults::envelope_mode) const;
         /// Encrypt a plain text using the raw public key.
         ///
         /// WARNING: This method cannot be used to encrypt large amount of
@@ -93,6 +102,26 @@ namespace elle
         template <typename T>
         std::function<bool ()>
         verify_async(elle::ConstWeakBuffer const& signature, T const& o) const;
+        /// A signature and the plain text it allegedly signs.
+        using Verification =
+          std::pair<elle::ConstWeakBuffer, elle::ConstWeakBuffer>;
+        /// Run the given workers concurrently and return once all are done.
+        using Fanout =
+          std::function<void (std::vector<std::function<void ()>> const&)>;
+        /// Verify a batch of signatures, fanning out across up to
+        /// \a parallelism workers, or one per core if zero.
+        ///
+        /// Verifications known to be valid by \a cache are skipped and
+        /// successful ones are recorded in it. Workers are run by \a fanout,
+        /// or by OS threads if empty, which blocks the calling thread: see
+        /// rsa/background.hh to use the reactor compute pool instead.
+        std::vector<bool>
+        verify_many(std::vector<Verification> const& batch,
+                    SignatureCache* cache = nullptr,
+                    Padding const padding = defaults::signature_padding,
+                    Oneway const oneway = defaults::oneway,
+                    unsigned int parallelism = 0,
+                    Fanout const& fanout = {}) const;
       private:
         virtual
         bool
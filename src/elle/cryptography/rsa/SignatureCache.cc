@@ -0,0 +1,179 @@
+#include <elle/cryptography/rsa/SignatureCache.hh>
+
+#include <elle/log.hh>
+#include <elle/print.hh>
+
+#include <elle/cryptography/hash.hh>
+#include <elle/cryptography/rsa/PublicKey.hh>
+
+ELLE_LOG_COMPONENT("elle.cryptography.rsa.SignatureCache");
+
+namespace elle
+{
+  namespace cryptography
+  {
+    namespace rsa
+    {
+      /*-------------.
+      | Construction |
+      `-------------*/
+
+      SignatureCache::SignatureCache(std::size_t capacity)
+        : _capacity(capacity)
+        , _entries()
+        , _hits(0)
+        , _misses(0)
+        , _evictions(0)
+      {
+        ELLE_ASSERT_GT(capacity, 0u);
+      }
+
+      /*-------------.
+      | Verification |
+      `-------------*/
+
+      bool
+      SignatureCache::verify(PublicKey const& K,
+                             elle::ConstWeakBuffer const& signature,
+                             elle::ConstWeakBuffer const& plain,
+                             Padding const padding,
+                             Oneway const oneway)
+      {
+        auto key = SignatureCache::key(K, signature, plain, padding, oneway);
+        if (this->lookup(key))
+          return true;
+        auto const res = K.verify(signature, plain, padding, oneway);
+        if (res)
+          this->insert(std::move(key));
+        return res;
+      }
+
+      std::string
+      SignatureCache::key(PublicKey const& K,
+                          elle::ConstWeakBuffer const& signature,
+                          elle::ConstWeakBuffer const& plain,
+                          Padding const padding,
+                          Oneway const oneway)
+      {
+        // Only digests of the key and the plain are retained: the signature
+        // is kept verbatim so that distinct signatures over the same content
+        // never alias.
+        auto const der = publickey::der::encode(K);
+        auto const fingerprint = hash(der, Oneway::sha256);
+        auto const digest = hash(plain, Oneway::sha256);
+        auto res = std::string();
+        res.reserve(fingerprint.size() + 2 + digest.size() + signature.size());
+        res.append(reinterpret_cast<char const*>(fingerprint.contents()),
+                   fingerprint.size());
+        res.push_back(static_cast<char>(padding));
+        res.push_back(static_cast<char>(oneway));
+        res.append(reinterpret_cast<char const*>(digest.contents()),
+                   digest.size());
+        res.append(reinterpret_cast<char const*>(signature.contents()),
+                   signature.size());
+        return res;
+      }
+
+      bool
+      SignatureCache::lookup(std::string const& key)
+      {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        auto it = this->_entries.find(key);
+        if (it == this->_entries.end())
+        {
+          ++this->_misses;
+          return false;
+        }
+        ++this->_hits;
+        // Mark as most recently used.
+        auto& sequence = this->_entries.get<1>();
+        sequence.relocate(sequence.end(), this->_entries.project<1>(it));
+        return true;
+      }
+
+      void
+      SignatureCache::insert(std::string key)
+      {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        auto& sequence = this->_entries.get<1>();
+        auto res = sequence.push_back(std::move(key));
+        if (!res.second)
+        {
+          sequence.relocate(sequence.end(), res.first);
+          return;
+        }
+        while (sequence.size() > this->_capacity)
+        {
+          ELLE_DEBUG("evict least recently used signature");
+          sequence.pop_front();
+          ++this->_evictions;
+        }
+      }
+
+      void
+      SignatureCache::clear()
+      {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_entries.clear();
+        this->_hits = 0;
+        this->_misses = 0;
+        this->_evictions = 0;
+      }
+
+      /*-----------.
+      | Statistics |
+      `-----------*/
+
+      std::size_t
+      SignatureCache::size() const
+      {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        return this->_entries.size();
+      }
+
+      std::size_t
+      SignatureCache::hits() const
+      {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        return this->_hits;
+      }
+
+      std::size_t
+      SignatureCache::misses() const
+      {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        return this->_misses;
+      }
+
+      std::size_t
+      SignatureCache::evictions() const
+      {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        return this->_evictions;
+      }
+
+      double
+      SignatureCache::hit_rate() const
+      {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        auto const lookups = this->_hits + this->_misses;
+        if (lookups == 0)
+          return 0;
+        return double(this->_hits) / lookups;
+      }
+
+      /*----------.
+      | Printable |
+      `----------*/
+
+      void
+      SignatureCache::print(std::ostream& stream) const
+      {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        elle::print(stream, "SignatureCache(%s/%s, hits: %s, misses: %s)",
+                    this->_entries.size(), this->_capacity,
+                    this->_hits, this->_misses);
+      }
+    }
+  }
+}
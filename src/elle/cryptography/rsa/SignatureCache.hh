@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/identity.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+
+#include <elle/Buffer.hh>
+#include <elle/Printable.hh>
+#include <elle/attribute.hh>
+
+#include <elle/cryptography/Oneway.hh>
+#include <elle/cryptography/rsa/Padding.hh>
+#include <elle/cryptography/rsa/defaults.hh>
+#include <elle/cryptography/rsa/fwd.hh>
+
+namespace elle
+{
+  namespace cryptography
+  {
+    namespace rsa
+    {
+      /// A bounded, thread-safe cache of successfully verified signatures.
+      ///
+      /// Signed blocks are often verified again and again as they travel
+      /// between peers. The cache remembers (key fingerprint, padding,
+      /// oneway, plain digest, signature) tuples that were found valid so
+      /// that further verifications of the same tuple skip the asymmetric
+      /// operation. Invalid signatures are never cached. The least recently
+      /// used entries are evicted once capacity is reached.
+      ///
+      /// \code{.cc}
+      ///
+      /// rsa::SignatureCache cache(4096);
+      /// if (cache.verify(K, signature, plain))
+      ///   ...
+      ///
+      /// \endcode
+      class SignatureCache
+        : public elle::Printable
+      {
+      /*-------------.
+      | Construction |
+      `-------------*/
+      public:
+        /// Create a cache retaining at most \a capacity verified signatures.
+        SignatureCache(std::size_t capacity = 1024);
+
+      /*-------------.
+      | Verification |
+      `-------------*/
+      public:
+        /// Verify \a signature against \a plain with \a K, consulting the
+        /// cache first and recording the result on success.
+        bool
+        verify(PublicKey const& K,
+               elle::ConstWeakBuffer const& signature,
+               elle::ConstWeakBuffer const& plain,
+               Padding const padding = defaults::signature_padding,
+               Oneway const oneway = defaults::oneway);
+        /// The cache key of the given verification.
+        static
+        std::string
+        key(PublicKey const& K,
+            elle::ConstWeakBuffer const& signature,
+            elle::ConstWeakBuffer const& plain,
+            Padding const padding = defaults::signature_padding,
+            Oneway const oneway = defaults::oneway);
+        /// Whether the verification identified by \a key is known to be valid.
+        bool
+        lookup(std::string const& key);
+        /// Remember the verification identified by \a key as valid.
+        void
+        insert(std::string key);
+        /// Forget every cached verification and reset statistics.
+        void
+        clear();
+
+      /*-----------.
+      | Statistics |
+      `-----------*/
+      public:
+        /// Number of cached verifications.
+        std::size_t
+        size() const;
+        /// Number of verifications answered by the cache.
+        std::size_t
+        hits() const;
+        /// Number of verifications that had to be computed.
+        std::size_t
+        misses() const;
+        /// Number of entries dropped to honor the capacity.
+        std::size_t
+        evictions() const;
+        /// Ratio of hits over lookups, 0 if nothing was looked up yet.
+        double
+        hit_rate() const;
+
+      /*----------.
+      | Printable |
+      `----------*/
+      public:
+        void
+        print(std::ostream& stream) const override;
+
+      /*-----------.
+      | Attributes |
+      `-----------*/
+      private:
+        using Entries = boost::multi_index::multi_index_container<
+          std::string,
+          boost::multi_index::indexed_by<
+            boost::multi_index::hashed_unique<
+              boost::multi_index::identity<std::string>>,
+            boost::multi_index::sequenced<>
+          >>;
+        ELLE_ATTRIBUTE_R(std::size_t, capacity);
+        ELLE_ATTRIBUTE(Entries, entries);
+        ELLE_ATTRIBUTE(std::size_t, hits);
+        ELLE_ATTRIBUTE(std::size_t, misses);
+        ELLE_ATTRIBUTE(std::size_t, evictions);
+        ELLE_ATTRIBUTE(std::mutex, mutex, mutable);
+      };
+    }
+  }
+}
@@ -5,6 +5,7 @@
 # include <elle/cryptography/rsa/Padding.hh>
 # include <elle/cryptography/rsa/PrivateKey.hh>
 # include <elle/cryptography/rsa/PublicKey.hh>
+# include <elle/cryptography/rsa/SignatureCache.hh>
 # if defined(ELLE_CRYPTOGRAPHY_ROTATION)
 #  include <elle/cryptography/rsa/Seed.hh>
 # endif
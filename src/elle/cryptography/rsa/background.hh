@@ -0,0 +1,45 @@
+#pragma once
+
+#include <vector>
+
+#include <elle/With.hh>
+
+#include <elle/cryptography/rsa/PublicKey.hh>
+#include <elle/reactor/Thread.hh>
+#include <elle/reactor/scheduler.hh>
+
+namespace elle
+{
+  namespace cryptography
+  {
+    namespace rsa
+    {
+      /// Verify a batch of signatures on the reactor compute pool.
+      ///
+      /// Same as PublicKey::verify_many, except the calling reactor::Thread
+      /// waits for the workers while other coroutines keep running. It must
+      /// thus be used from within a reactor::Scheduler. Workers reference
+      /// \a batch: the wait cannot be interrupted.
+      inline
+      std::vector<bool>
+      verify_many(PublicKey const& key,
+                  std::vector<PublicKey::Verification> const& batch,
+                  SignatureCache* cache = nullptr,
+                  Padding const padding = defaults::signature_padding,
+                  Oneway const oneway = defaults::oneway,
+                  unsigned int parallelism = 0)
+      {
+        return key.verify_many(
+          batch, cache, padding, oneway, parallelism,
+          [] (std::vector<std::function<void ()>> const& workers)
+          {
+            elle::With<elle::reactor::Thread::NonInterruptible>() << [&]
+            {
+              elle::reactor::background(
+                workers, elle::reactor::Background::compute);
+            };
+          });
+      }
+    }
+  }
+}
@@ -10,6 +10,7 @@ namespace elle
       class PrivateKey;
       class PublicKey;
       class KeyPair;
+      class SignatureCache;
 # if defined(ELLE_CRYPTOGRAPHY_ROTATION)
       class Seed;
 # endif
@@ -0,0 +1,403 @@
+#include <elle/metrics.hh>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+
+namespace elle
+{
+  namespace metrics
+  {
+    /*----------.
+    | Histogram |
+    `----------*/
+
+    constexpr int Histogram::precision;
+    constexpr int Histogram::sub_buckets;
+    constexpr int Histogram::buckets;
+    constexpr int Histogram::shards;
+
+    Histogram::Shard::Shard()
+      : count(0)
+      , sum(0)
+      , minimum(std::numeric_limits<std::uint64_t>::max())
+      , maximum(0)
+    {
+      for (auto& c: this->counts)
+        c.store(0, std::memory_order_relaxed);
+    }
+
+    Histogram::Histogram(double unit)
+      : _unit(unit)
+    {
+      for (auto& shard: this->_shards)
+        shard.store(nullptr, std::memory_order_relaxed);
+    }
+
+    Histogram::~Histogram()
+    {
+      for (auto& shard: this->_shards)
+        delete shard.load();
+    }
+
+    int
+    Histogram::bucket(std::uint64_t value)
+    {
+      if (value < std::uint64_t(sub_buckets))
+        return int(value);
+      auto const exponent = 63 - __builtin_clzll(value);
+      auto const octave = exponent - precision + 1;
+      auto const mantissa = int(value >> (exponent - precision)) - sub_buckets;
+      return octave * sub_buckets + mantissa;
+    }
+
+    std::uint64_t
+    Histogram::lower(int index)
+    {
+      if (index < sub_buckets)
+        return std::uint64_t(index);
+      auto const octave = index / sub_buckets;
+      auto const mantissa = index % sub_buckets;
+      return std::uint64_t(sub_buckets + mantissa) << (octave - 1);
+    }
+
+    std::uint64_t
+    Histogram::width(int index)
+    {
+      if (index < sub_buckets)
+        return 1;
+      return std::uint64_t(1) << (index / sub_buckets - 1);
+    }
+
+    Histogram::Shard&
+    Histogram::_shard()
+    {
+      // Give each thread its own shard, as long as there are enough.
+      static std::atomic<int> next(0);
+      static thread_local int const index = next++ % shards;
+      auto& slot = this->_shards[index];
+      auto shard = slot.load(std::memory_order_acquire);
+      if (!shard)
+      {
+        auto fresh = new Shard;
+        if (slot.compare_exchange_strong(shard, fresh,
+                                         std::memory_order_acq_rel))
+          shard = fresh;
+        else
+          delete fresh;
+      }
+      return *shard;
+    }
+
+    void
+    Histogram::record(std::uint64_t value)
+    {
+      auto& shard = this->_shard();
+      shard.counts[bucket(value)].fetch_add(1, std::memory_order_relaxed);
+      shard.count.fetch_add(1, std::memory_order_relaxed);
+      shard.sum.fetch_add(value, std::memory_order_relaxed);
+      auto min = shard.minimum.load(std::memory_order_relaxed);
+      while (value < min &&
+             !shard.minimum.compare_exchange_weak(
+               min, value, std::memory_order_relaxed))
+        ;
+      auto max = shard.maximum.load(std::memory_order_relaxed);
+      while (value > max &&
+             !shard.maximum.compare_exchange_weak(
+               max, value, std::memory_order_relaxed))
+        ;
+    }
+
+    void
+    Histogram::reset()
+    {
+      for (auto& slot: this->_shards)
+        if (auto shard = slot.load(std::memory_order_acquire))
+        {
+          for (auto& c: shard->counts)
+            c.store(0, std::memory_order_relaxed);
+          shard->count.store(0, std::memory_order_relaxed);
+          shard->sum.store(0, std::memory_order_relaxed);
+          shard->minimum.store(std::numeric_limits<std::uint64_t>::max(),
+                               std::memory_order_relaxed);
+          shard->maximum.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    Histogram::Snapshot
+    Histogram::snapshot() const
+    {
+      auto res = Snapshot(this->_unit);
+      auto min = std::numeric_limits<std::uint64_t>::max();
+      auto max = std::uint64_t(0);
+      auto sum = std::uint64_t(0);
+      for (auto& slot: this->_shards)
+        if (auto shard = slot.load(std::memory_order_acquire))
+        {
+          auto const count = shard->count.load(std::memory_order_relaxed);
+          if (!count)
+            continue;
+          if (res.counts.empty())
+            res.counts.resize(buckets, 0);
+          for (int i = 0; i < buckets; ++i)
+            res.counts[i] += shard->counts[i].load(std::memory_order_relaxed);
+          res.count += count;
+          sum += shard->sum.load(std::memory_order_relaxed);
+          min = std::min(min, shard->minimum.load(std::memory_order_relaxed));
+          max = std::max(max, shard->maximum.load(std::memory_order_relaxed));
+        }
+      if (res.count)
+      {
+        res.sum = sum * this->_unit;
+        res.minimum = min * this->_unit;
+        res.maximum = max * this->_unit;
+      }
+      return res;
+    }
+
+    Histogram::Snapshot::Snapshot(double unit)
+      : counts()
+      , count(0)
+      , sum(0)
+      , minimum(0)
+      , maximum(0)
+      , unit(unit)
+    {}
+
+    double
+    Histogram::Snapshot::percentile(double p) const
+    {
+      if (!this->count)
+        return 0;
+      auto const rank = std::max<std::uint64_t>(
+        std::uint64_t(std::ceil(std::min(std::max(p, 0.), 1.) * this->count)),
+        1);
+      auto seen = std::uint64_t(0);
+      for (int i = 0; i < buckets; ++i)
+        if ((seen += this->counts[i]) >= rank)
+        {
+          // The highest value of the bucket, within what was recorded.
+          auto const value = (lower(i) + width(i) - 1) * this->unit;
+          return std::max(std::min(value, this->maximum), this->minimum);
+        }
+      return this->maximum;
+    }
+
+    double
+    Histogram::Snapshot::mean() const
+    {
+      return this->count ? this->sum / this->count : 0;
+    }
+
+    void
+    Histogram::Snapshot::merge(Snapshot const& other)
+    {
+      if (!other.count)
+        return;
+      if (!this->count)
+      {
+        *this = other;
+        return;
+      }
+      for (int i = 0; i < buckets; ++i)
+        this->counts[i] += other.counts[i];
+      this->count += other.count;
+      this->sum += other.sum;
+      this->minimum = std::min(this->minimum, other.minimum);
+      this->maximum = std::max(this->maximum, other.maximum);
+    }
+
+    /*--------.
+    | Counter |
+    `--------*/
+
+    Counter::Counter()
+      : _value(0)
+    {}
+
+    void
+    Counter::increment(std::int64_t n)
+    {
+      this->_value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    std::int64_t
+    Counter::value() const
+    {
+      return this->_value.load(std::memory_order_relaxed);
+    }
+
+    /*------.
+    | Gauge |
+    `------*/
+
+    Gauge::Gauge()
+      : _value(0)
+      , _probe()
+    {}
+
+    Gauge::Gauge(Probe probe)
+      : _value(0)
+      , _probe(std::move(probe))
+    {}
+
+    void
+    Gauge::set(double value)
+    {
+      this->_value.store(value, std::memory_order_relaxed);
+    }
+
+    void
+    Gauge::add(double delta)
+    {
+      auto value = this->_value.load(std::memory_order_relaxed);
+      while (!this->_value.compare_exchange_weak(
+               value, value + delta, std::memory_order_relaxed))
+        ;
+    }
+
+    double
+    Gauge::value() const
+    {
+      if (this->_probe)
+        return this->_probe();
+      return this->_value.load(std::memory_order_relaxed);
+    }
+
+    /*---------.
+    | Registry |
+    `---------*/
+
+    Registry::Registry()
+    {}
+
+    std::shared_ptr<Counter>
+    Registry::counter(std::string const& name)
+    {
+      std::unique_lock<std::mutex> lock(this->_mutex);
+      auto& res = this->_counters[name];
+      if (!res)
+        res = std::make_shared<Counter>();
+      return res;
+    }
+
+    std::shared_ptr<Gauge>
+    Registry::gauge(std::string const& name)
+    {
+      std::unique_lock<std::mutex> lock(this->_mutex);
+      auto& res = this->_gauges[name];
+      if (!res)
+        res = std::make_shared<Gauge>();
+      return res;
+    }
+
+    std::shared_ptr<Gauge>
+    Registry::gauge(std::string const& name, Gauge::Probe probe)
+    {
+      auto res = std::make_shared<Gauge>(std::move(probe));
+      std::unique_lock<std::mutex> lock(this->_mutex);
+      this->_gauges[name] = res;
+      return res;
+    }
+
+    std::shared_ptr<Histogram>
+    Registry::histogram(std::string const& name, double unit)
+    {
+      std::unique_lock<std::mutex> lock(this->_mutex);
+      auto& res = this->_histograms[name];
+      if (!res)
+        res = std::make_shared<Histogram>(unit);
+      return res;
+    }
+
+    Registry::Snapshot
+    Registry::snapshot() const
+    {
+      // Copy the metrics first, so probes and histograms are read without
+      // holding the lock.
+      auto counters = decltype(this->_counters){};
+      auto gauges = decltype(this->_gauges){};
+      auto histograms = decltype(this->_histograms){};
+      {
+        std::unique_lock<std::mutex> lock(this->_mutex);
+        counters = this->_counters;
+        gauges = this->_gauges;
+        histograms = this->_histograms;
+      }
+      auto res = Snapshot{};
+      for (auto const& c: counters)
+        res.counters.emplace(c.first, c.second->value());
+      for (auto const& g: gauges)
+        res.gauges.emplace(g.first, g.second->value());
+      for (auto const& h: histograms)
+        res.histograms.emplace(h.first, h.second->snapshot());
+      return res;
+    }
+
+    Registry&
+    registry()
+    {
+      static Registry res;
+      return res;
+    }
+
+    /*-----------.
+    | Prometheus |
+    `-----------*/
+
+    namespace
+    {
+      std::string
+      sanitize(std::string name)
+      {
+        for (auto& c: name)
+          if (!std::isalnum(static_cast<unsigned char>(c)) &&
+              c != '_' && c != ':')
+            c = '_';
+        if (name.empty() || std::isdigit(static_cast<unsigned char>(name[0])))
+          name = "_" + name;
+        return name;
+      }
+
+      std::pair<char const*, double> const quantiles[] = {
+        {"0.5", 0.5}, {"0.9", 0.9}, {"0.99", 0.99}, {"0.999", 0.999},
+      };
+    }
+
+    void
+    prometheus(std::ostream& output, Registry::Snapshot const& snapshot)
+    {
+      auto const flags = output.flags();
+      auto const precision =
+        output.precision(std::numeric_limits<double>::max_digits10);
+      output.unsetf(std::ios::floatfield);
+      for (auto const& c: snapshot.counters)
+      {
+        auto const name = sanitize(c.first);
+        output << "# TYPE " << name << " counter\n"
+               << name << ' ' << c.second << '\n';
+      }
+      for (auto const& g: snapshot.gauges)
+      {
+        auto const name = sanitize(g.first);
+        output << "# TYPE " << name << " gauge\n"
+               << name << ' ' << g.second << '\n';
+      }
+      for (auto const& h: snapshot.histograms)
+      {
+        auto const name = sanitize(h.first);
+        output << "# TYPE " << name << " summary\n";
+        for (auto const& q: quantiles)
+          output << name << "{quantile=\"" << q.first << "\"} "
+                 << h.second.percentile(q.second) << '\n';
+        output << name << "_sum " << h.second.sum << '\n'
+               << name << "_count " << h.second.count << '\n';
+      }
+      output.precision(precision);
+      output.flags(flags);
+    }
+  }
+}
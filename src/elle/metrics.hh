@@ -0,0 +1,228 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <elle/attribute.hh>
+#include <elle/compiler.hh>
+
+namespace elle
+{
+  /// Counters, gauges and latency histograms, exportable in Prometheus text
+  /// format.
+  ///
+  /// @code{.cc}
+  ///
+  /// static auto requests = elle::metrics::registry().counter("http.requests");
+  /// static auto latency = elle::metrics::registry().histogram(
+  ///   "http.latency", 1e-9);
+  /// auto const start = std::chrono::steady_clock::now();
+  /// serve();
+  /// requests->increment();
+  /// latency->record(std::chrono::steady_clock::now() - start);
+  /// // ...
+  /// elle::metrics::prometheus(std::cout, elle::metrics::registry().snapshot());
+  ///
+  /// @endcode
+  namespace metrics
+  {
+    /*----------.
+    | Histogram |
+    `----------*/
+
+    /// A lock-free histogram of positive integers, in the manner of
+    /// HdrHistogram.
+    ///
+    /// Each power of two is split in 64 buckets, bounding the relative error
+    /// of percentiles to 1.6% over the whole 64 bits range. Recording
+    /// threads are spread over separate shards, allocated on first use, so
+    /// they do not contend on the same cache lines.
+    class ELLE_API Histogram
+    {
+    public:
+      /// Buckets per power of two, as a power of two.
+      static constexpr int precision = 6;
+      static constexpr int sub_buckets = 1 << precision;
+      static constexpr int buckets = (64 - precision + 1) * sub_buckets;
+      /// Recording shards.
+      static constexpr int shards = 8;
+
+      /// A point in time copy of a Histogram.
+      struct ELLE_API Snapshot
+      {
+        Snapshot(double unit = 1);
+        /// The smallest value greater than or equal to a ratio @a p of
+        /// the recorded ones, in the Histogram unit.
+        double
+        percentile(double p) const;
+        double
+        mean() const;
+        void
+        merge(Snapshot const& other);
+        /// Values recorded per bucket, empty if none.
+        std::vector<std::uint64_t> counts;
+        std::uint64_t count;
+        double sum;
+        double minimum;
+        double maximum;
+        /// What one recorded unit amounts to.
+        double unit;
+      };
+
+      /// A histogram whose values amount to @a unit each, e.g. 1e-9 to
+      /// record nanoseconds and report seconds.
+      Histogram(double unit = 1);
+      ~Histogram();
+      Histogram(Histogram const&) = delete;
+      /// Record @a value.
+      void
+      record(std::uint64_t value);
+      /// Record @a d, in nanoseconds.
+      template <typename Rep, typename Period>
+      void
+      record(std::chrono::duration<Rep, Period> d);
+      /// Forget recorded values.
+      void
+      reset();
+      Snapshot
+      snapshot() const;
+      ELLE_ATTRIBUTE_R(double, unit);
+
+    public:
+      /// The bucket @a value falls in.
+      static
+      int
+      bucket(std::uint64_t value);
+      /// The smallest value falling in bucket @a index.
+      static
+      std::uint64_t
+      lower(int index);
+      /// The values span of bucket @a index.
+      static
+      std::uint64_t
+      width(int index);
+
+    private:
+      struct Shard
+      {
+        Shard();
+        std::array<std::atomic<std::uint64_t>, buckets> counts;
+        std::atomic<std::uint64_t> count;
+        std::atomic<std::uint64_t> sum;
+        std::atomic<std::uint64_t> minimum;
+        std::atomic<std::uint64_t> maximum;
+      };
+      Shard&
+      _shard();
+      ELLE_ATTRIBUTE((std::array<std::atomic<Shard*>, shards>), shards);
+    };
+
+    /*--------.
+    | Counter |
+    `--------*/
+
+    /// A monotonic count of events.
+    class ELLE_API Counter
+    {
+    public:
+      Counter();
+      void
+      increment(std::int64_t n = 1);
+      std::int64_t
+      value() const;
+    private:
+      ELLE_ATTRIBUTE(std::atomic<std::int64_t>, value);
+    };
+
+    /*------.
+    | Gauge |
+    `------*/
+
+    /// A value that goes up and down.
+    class ELLE_API Gauge
+    {
+    public:
+      using Probe = std::function<double ()>;
+      Gauge();
+      /// A gauge reading its value from @a probe upon snapshots.
+      Gauge(Probe probe);
+      void
+      set(double value);
+      void
+      add(double delta);
+      double
+      value() const;
+    private:
+      ELLE_ATTRIBUTE(std::atomic<double>, value);
+      ELLE_ATTRIBUTE(Probe, probe);
+    };
+
+    /*---------.
+    | Registry |
+    `---------*/
+
+    /// Named metrics.
+    ///
+    /// Metrics are created upon first request and live as long as the
+    /// registry: requesting the same name twice yields the same metric.
+    class ELLE_API Registry
+    {
+    public:
+      struct Snapshot
+      {
+        std::map<std::string, std::int64_t> counters;
+        std::map<std::string, double> gauges;
+        std::map<std::string, Histogram::Snapshot> histograms;
+      };
+
+    public:
+      Registry();
+      Registry(Registry const&) = delete;
+      std::shared_ptr<Counter>
+      counter(std::string const& name);
+      std::shared_ptr<Gauge>
+      gauge(std::string const& name);
+      /// A gauge reading @a probe, replacing any previous one.
+      std::shared_ptr<Gauge>
+      gauge(std::string const& name, Gauge::Probe probe);
+      /// The histogram @a name, created with @a unit if needed.
+      std::shared_ptr<Histogram>
+      histogram(std::string const& name, double unit = 1);
+      /// Copy all metrics values.
+      Snapshot
+      snapshot() const;
+
+    private:
+      ELLE_ATTRIBUTE(mutable std::mutex, mutex);
+      ELLE_ATTRIBUTE((std::map<std::string, std::shared_ptr<Counter>>),
+                     counters);
+      ELLE_ATTRIBUTE((std::map<std::string, std::shared_ptr<Gauge>>), gauges);
+      ELLE_ATTRIBUTE((std::map<std::string, std::shared_ptr<Histogram>>),
+                     histograms);
+    };
+
+    /// The process wide registry.
+    ELLE_API
+    Registry&
+    registry();
+
+    /// Print @a snapshot in Prometheus text exposition format.
+    ///
+    /// Names are sanitized, dots becoming underscores. Histograms are
+    /// exported as summaries with 0.5, 0.9, 0.99 and 0.999 quantiles.
+    ELLE_API
+    void
+    prometheus(std::ostream& output, Registry::Snapshot const& snapshot);
+  }
+}
+
+#include <elle/metrics.hxx>
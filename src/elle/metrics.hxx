@@ -0,0 +1,14 @@
+namespace elle
+{
+  namespace metrics
+  {
+    template <typename Rep, typename Period>
+    void
+    Histogram::record(std::chrono::duration<Rep, Period> d)
+    {
+      auto const ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+      this->record(std::uint64_t(ns > 0 ? ns : 0));
+    }
+  }
+}
@@ -1,4 +1,7 @@
 #include <memory>
+#include <ostream>
+#include <streambuf>
+#include <unordered_map>
 
 #include <boost/bind.hpp>
 #include <boost/config/warning_disable.hpp>
@@ -325,11 +328,95 @@ namespace elle
       auto res = std::shared_ptr<Expression>{};
       auto first = input.begin();
       auto last = input.end();
-      if (!qi::phrase_parse(first, last, phrase, qi::eoi, res) || first != last)
+      // The grammar handles every character itself, it has no use for a
+      // skipper.
+      if (!qi::parse(first, last, phrase, res) || first != last)
         elle::err("invalid format: %s", input);
       ELLE_ASSERT(res);
       return res;
     }
+
+    /// A stream buffer appending to a string.
+    class Appender
+      : public std::streambuf
+    {
+    public:
+      std::string* output = nullptr;
+
+    protected:
+      int_type
+      overflow(int_type c) override
+      {
+        if (!traits_type::eq_int_type(c, traits_type::eof()))
+          this->output->push_back(traits_type::to_char_type(c));
+        return traits_type::not_eof(c);
+      }
+
+      std::streamsize
+      xsputn(char const* s, std::streamsize n) override
+      {
+        this->output->append(s, n);
+        return n;
+      }
+    };
+
+    struct AppendStream
+    {
+      AppendStream()
+        : stream(&buffer)
+      {}
+
+      Appender buffer;
+      std::ostream stream;
+    };
+
+    /// Set once the calling thread's Locals are destroyed: static
+    /// destructors may still print afterwards.
+    thread_local bool locals_destroyed = false;
+
+    /// Per-thread parsed formats and streams.
+    struct Locals
+    {
+      ~Locals()
+      {
+        locals_destroyed = true;
+      }
+
+      /// Formats are mostly literals used over and over, parsing them is by
+      /// far the most expensive part of printing.
+      std::unordered_map<std::string, std::shared_ptr<Expression>> asts;
+      /// Streams are expensive to build. Printing an argument may print to a
+      /// string itself, hence more than one.
+      std::vector<std::unique_ptr<AppendStream>> streams;
+    };
+
+    Locals*
+    locals()
+    {
+      if (locals_destroyed)
+        return nullptr;
+      static thread_local Locals res;
+      return &res;
+    }
+
+    /// The AST of @a input, parsed once per thread.
+    std::shared_ptr<Expression>
+    parsed(std::string const& input)
+    {
+      auto l = locals();
+      if (!l)
+        return parse(input);
+      auto it = l->asts.find(input);
+      if (it == l->asts.end())
+      {
+        auto ast = parse(input);
+        // Formats built at runtime must not grow the cache indefinitely.
+        if (l->asts.size() >= 1024)
+          l->asts.clear();
+        it = l->asts.emplace(input, std::move(ast)).first;
+      }
+      return it->second;
+    }
     }
 
     /*------.
@@ -341,19 +428,19 @@ namespace elle
     void
     print(std::ostream& s,
           Expression const& ast,
-          std::vector<Argument> const& args,
+          Arguments const& args,
           int& count,
           bool p,
           NamedArguments const& named,
           bool& full_positional)
     {
       auto const nth = [&] (int n) -> Argument const& {
-        if (n < signed(args.size()))
-          return args[n];
+        if (n < signed(args.size))
+          return args.data[n];
         else
           elle::err(
             "too few arguments for format: %s, expected at least %s",
-            args.size(), n + 1);
+            args.size, n + 1);
       };
       auto* id = &typeid(ast);
       if (id == &typeid(Composite))
@@ -473,16 +560,46 @@ namespace elle
     void
     print(std::ostream& s,
           std::string const& fmt,
-          std::vector<Argument> const& args,
+          Arguments const& args,
           NamedArguments const& named)
     {
-      auto const ast = _details::parse(fmt);
+      auto const ast = _details::parsed(fmt);
       int count = 0;
       bool full_positional = true;
       _details::print(s, *ast, args, count, true, named, full_positional);
-      if (full_positional && count < signed(args.size()))
+      if (full_positional && count < signed(args.size))
         elle::err("too many arguments (%s > %s) for format: %s",
-                  args.size(), count, fmt);
+                  args.size, count, fmt);
+    }
+
+    void
+    print(std::string& output,
+          std::string const& fmt,
+          Arguments const& args,
+          NamedArguments const& named)
+    {
+      static std::ostream const pristine(nullptr);
+      auto l = locals();
+      auto stream = std::unique_ptr<AppendStream>();
+      if (!l || l->streams.empty())
+        stream = std::make_unique<AppendStream>();
+      else
+      {
+        stream = std::move(l->streams.back());
+        l->streams.pop_back();
+        // Forget any formatting state left by the previous use.
+        stream->stream.copyfmt(pristine);
+        stream->stream.clear();
+      }
+      stream->buffer.output = &output;
+      elle::SafeFinally release(
+        [&]
+        {
+          stream->buffer.output = nullptr;
+          if ((l = locals()))
+            l->streams.emplace_back(std::move(stream));
+        });
+      print(stream->stream, fmt, args, named);
     }
   }
 
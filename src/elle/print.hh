@@ -1,6 +1,7 @@
 #pragma once
 
 #include <iosfwd>
+#include <string>
 
 namespace elle
 {
@@ -30,6 +31,19 @@ namespace elle
   std::string
   print(std::string const& fmt, Args&& ... args);
 
+  /// Append a formatted string to @a output.
+  ///
+  /// Reuse @a output across calls to spare the allocations of
+  /// print(fmt, args...).
+  ///
+  /// @param output The string to append to.
+  /// @param fmt The un-formatted string specifying how to format and interpret
+  ///            the given data.
+  /// @param args The arguments specifying data to print.
+  template <typename ... Args>
+  void
+  print_to(std::string& output, std::string const& fmt, Args&& ... args);
+
   /// Whether a stream is set for debugging output.
   ///
   /// Armed with `%r` in print's format.
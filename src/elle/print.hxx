@@ -1,3 +1,4 @@
+#include <array>
 #include <cstring>
 #include <iostream>
 #include <string>
@@ -220,22 +221,60 @@ namespace elle
     | Arguments.  |
     `------------*/
 
-    struct Argument
-      : public std::function<auto (std::ostream&) -> void>
+    /// A type-erased reference to an argument.
+    ///
+    /// Plain function pointers rather than std::function: arguments are
+    /// erased on every call and must stay cheap to build.
+    class Argument
     {
-      using Super = std::function<auto (std::ostream&) -> void>;
+    public:
       template <typename T>
       Argument(T const& value)
-        : Super{[&value] (std::ostream& o) { print(o, value); }}
-        , _bool{[&value] { return branch_test(value, 0); }}
+        : _value(&value)
+        , _print([] (std::ostream& o, void const* v)
+                 {
+                   print(o, *static_cast<T const*>(v));
+                 })
+        , _bool([] (void const* v)
+                {
+                  return branch_test(*static_cast<T const*>(v), 0);
+                })
       {}
 
+      void
+      operator ()(std::ostream& o) const
+      {
+        this->_print(o, this->_value);
+      }
+
       operator bool() const
       {
-        return this->_bool();
+        return this->_bool(this->_value);
+      }
+
+    private:
+      void const* _value;
+      void (*_print)(std::ostream&, void const*);
+      bool (*_bool)(void const*);
+    };
+
+    /// Positional arguments, stored by the caller.
+    struct Arguments
+    {
+      Argument const*
+      begin() const
+      {
+        return this->data;
       }
 
-      std::function<bool()> _bool;
+      Argument const*
+      end() const
+      {
+        return this->data + this->size;
+      }
+
+      Argument const* data;
+      std::size_t size;
     };
 
     struct NamedArgument
@@ -260,17 +299,20 @@ namespace elle
     void
     print(std::ostream& s,
           std::string const& fmt,
-          std::vector<Argument> const& args,
+          Arguments const& args,
+          NamedArguments const& named);
+
+    void
+    print(std::string& output,
+          std::string const& fmt,
+          Arguments const& args,
           NamedArguments const& named);
 
     template <typename ... Args>
-    std::vector <Argument>
+    std::array<Argument, sizeof ... (Args)>
     erasure(Args const& ... args)
     {
-      std::vector<Argument> res;
-      res.reserve(sizeof ... (args));
-      int unused[] __attribute__((unused)) = {(res.emplace_back(args), 0)...};
-      return res;
+      return {{Argument(args)...}};
     }
   }
 
@@ -282,16 +324,25 @@ namespace elle
   void
   print(std::ostream& o, std::string const& fmt, Args&& ... args)
   {
-    _details::print(o, fmt, _details::erasure(args...), {});
+    auto const erased = _details::erasure(args...);
+    _details::print(o, fmt, {erased.data(), erased.size()}, {});
+  }
+
+  template <typename ... Args>
+  void
+  print_to(std::string& output, std::string const& fmt, Args&& ... args)
+  {
+    auto const erased = _details::erasure(args...);
+    _details::print(output, fmt, {erased.data(), erased.size()}, {});
   }
 
   template <typename ... Args>
   std::string
   print(std::string const& fmt, Args&& ... args)
   {
-    std::stringstream output;
-    print(output, fmt, std::forward<Args>(args)...);
-    return output.str();
+    auto res = std::string();
+    print_to(res, fmt, std::forward<Args>(args)...);
+    return res;
   }
 
   /*------.
@@ -304,7 +355,16 @@ namespace elle
         std::string const& fmt,
         _details::NamedArguments const& args)
   {
-    _details::print(o, fmt, {}, args);
+    _details::print(o, fmt, {nullptr, 0}, args);
+  }
+
+  inline
+  void
+  print_to(std::string& output,
+           std::string const& fmt,
+           _details::NamedArguments const& args)
+  {
+    _details::print(output, fmt, {nullptr, 0}, args);
   }
 
   inline
@@ -312,8 +372,8 @@ namespace elle
   print(std::string const& fmt,
         _details::NamedArguments const& args)
   {
-    std::stringstream output;
-    print(output, fmt, args);
-    return output.str();
+    auto res = std::string();
+    print_to(res, fmt, args);
+    return res;
   }
 }
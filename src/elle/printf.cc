@@ -1,12 +1,52 @@
 #include <elle/printf.hh>
 
 #include <sstream>
+#include <unordered_map>
 
 #include <elle/Exception.hh>
 #include <elle/log.hh>
 
 namespace elle
 {
+  namespace _details
+  {
+    namespace
+    {
+      /// Set once the calling thread's cache is destroyed: static
+      /// destructors may still format afterwards.
+      thread_local bool cache_destroyed = false;
+
+      struct Cache
+        : public std::unordered_map<std::string, boost::format>
+      {
+        ~Cache()
+        {
+          cache_destroyed = true;
+        }
+      };
+    }
+
+    boost::format
+    parsed_format(std::string const& fmt)
+    {
+      if (cache_destroyed)
+        return boost::format(fmt);
+      // Parsing dominates the cost of small formats, and formats are mostly
+      // literals used over and over.
+      static thread_local Cache cache;
+      auto it = cache.find(fmt);
+      if (it == cache.end())
+      {
+        auto parsed = boost::format(fmt);
+        // Formats built at runtime must not grow the cache indefinitely.
+        if (cache.size() >= 1024)
+          cache.clear();
+        it = cache.emplace(fmt, std::move(parsed)).first;
+      }
+      return it->second;
+    }
+  }
+
   void
   format_error(std::string const& fmt, boost::io::format_error const& e)
   {
@@ -41,6 +41,13 @@ namespace _elle_printf_details
 
 namespace elle
 {
+  namespace _details
+  {
+    /// A fresh copy of the boost::format for @a fmt, parsed once per thread.
+    boost::format
+    parsed_format(std::string const& fmt);
+  }
+
   namespace
   {
     template <typename T>
@@ -174,7 +181,7 @@ namespace elle
     boost::format
     format(F&& fmt, T&& ... values)
     {
-      auto res = boost::format{fmt};
+      auto res = _details::parsed_format(fmt);
       using swallow = int[];
       (void) swallow
         {
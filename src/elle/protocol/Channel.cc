@@ -1,6 +1,7 @@
 #include <elle/protocol/Channel.hh>
 
 #include <elle/algorithm.hh>
+#include <elle/find.hh>
 #include <elle/log.hh>
 #include <elle/protocol/ChanneledStream.hh>
 
@@ -63,6 +64,7 @@ namespace elle
                      this->_available.waiters().size());
         ELLE_ASSERT(elle::contains(this->_backend._channels, this->_id));
         this->_backend._channels.erase(this->_id);
+        this->_backend._close(this->_id);
       }
     }
 
@@ -94,7 +96,9 @@ namespace elle
     elle::Buffer
     Channel::_read()
     {
-      return this->_packets.get();
+      auto res = this->_packets.get();
+      this->_backend._consumed(this->_id, res.size());
+      return res;
     }
 
     /*--------.
@@ -102,9 +106,28 @@ namespace elle
     `--------*/
 
     void
-    Channel::_write(elle::Buffer const& packet)
+    Channel::_write(elle::Buffer& packet)
     {
       this->_backend._write(packet, this->_id);
     }
+
+    /*-------------.
+    | Flow control |
+    `-------------*/
+
+    int
+    Channel::weight() const
+    {
+      if (auto it = elle::find(this->_backend._flows, this->_id))
+        return it->second.weight;
+      else
+        return 1;
+    }
+
+    void
+    Channel::weight(int weight)
+    {
+      this->_backend._flows[this->_id].weight = std::max(weight, 1);
+    }
   }
 }
@@ -95,7 +95,18 @@ namespace elle
       ///
       /// @see Stream::_write.
       void
-      _write(elle::Buffer const& packet) override;
+      _write(elle::Buffer& packet) override;
+
+    /*-------------.
+    | Flow control |
+    `-------------*/
+    public:
+      /// Fragments sent per round when several channels have pending
+      /// packets, from version 0.4.0.
+      int
+      weight() const;
+      void
+      weight(int weight);
 
     /*--------.
     | Details |
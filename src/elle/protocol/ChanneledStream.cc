@@ -1,8 +1,10 @@
+#include <algorithm>
 #include <iostream>
 
 #include <elle/find.hh>
 #include <elle/log.hh>
 
+#include <elle/reactor/Barrier.hh>
 #include <elle/reactor/scheduler.hh>
 #include <elle/reactor/Thread.hh>
 
@@ -17,14 +19,57 @@ namespace elle
 {
   namespace protocol
   {
+    namespace
+    {
+      /// Kinds of flow controlled packets, following the channel id.
+      enum class Frame: char
+      {
+        /// Last fragment of a packet.
+        last = 0,
+        /// Fragment of a packet, more follow.
+        more = 1,
+        /// Credit granted on a channel.
+        credit = 2,
+      };
+    }
+
+    struct ChanneledStream::Pending
+    {
+      Pending(elle::Buffer& packet)
+        : packet(&packet)
+      {}
+
+      /// The packet, given away by its writer.
+      elle::Buffer* packet;
+      /// The packet, taken over once its writer left.
+      elle::Buffer orphaned;
+      /// Bytes already sent.
+      elle::Buffer::Size offset = 0;
+      /// Whether sending began, the peer then expects all of it.
+      bool started = false;
+      /// Whether its writer left, leaving it up to us to delete it.
+      bool orphan = false;
+      elle::reactor::Barrier sent;
+      std::exception_ptr exception;
+    };
+
     /*-------------.
     | Construction |
     `-------------*/
 
+    constexpr int64_t ChanneledStream::window;
+    constexpr int ChanneledStream::fragment;
+
     ChanneledStream::ChanneledStream(elle::reactor::Scheduler& scheduler,
-                                     Stream& backend)
+                                     Stream& backend,
+                                     bool flow_control)
       : Super(scheduler)
       , _backend(backend)
+      // Flow control framing (frame bytes, fragments and credits) appeared
+      // after protocol 0.3.0. It is not tied to the negotiated version, since
+      // consumers already negotiate 0.4.0 and later for their own formats:
+      // peers opt in explicitly.
+      , _flow_control(flow_control)
       , _master(this->_handshake())
       , _id_current(0)
       , _default(*this)
@@ -32,10 +77,16 @@ namespace elle
       this->_thread.reset(
         new reactor::Thread(
           elle::sprintf("%s", this), [this] { this->_read_thread(); }));
+      if (this->_flow_control)
+        this->_writer.reset(
+          new reactor::Thread(
+            elle::sprintf("%s writer", this),
+            [this] { this->_write_thread(); }));
     }
 
-    ChanneledStream::ChanneledStream(Stream& backend)
-      : ChanneledStream(*elle::reactor::Scheduler::scheduler(), backend)
+    ChanneledStream::ChanneledStream(Stream& backend, bool flow_control)
+      : ChanneledStream(
+        *elle::reactor::Scheduler::scheduler(), backend, flow_control)
     {}
 
     ChanneledStream::~ChanneledStream()
@@ -43,12 +94,18 @@ namespace elle
       try
       {
         this->_thread->terminate_now();
+        if (this->_writer)
+          this->_writer->terminate_now();
       }
       catch (...)
       {
         ELLE_ABORT("exception escaping %s destructor: %s",
                    this, elle::exception_string());
       }
+      for (auto& flow: this->_flows)
+        for (auto* pending: flow.second.pending)
+          if (pending->orphan)
+            delete pending;
     }
 
     void
@@ -61,6 +118,11 @@ namespace elle
         {
           auto p = this->_backend.read();
           int channel_id = this->uint32_get(p, this->version());
+          if (this->_flow_control)
+          {
+            this->_receive(channel_id, std::move(p));
+            continue;
+          }
           // FIXME: The size of the packet isn't adjusted. This is cosmetic
           // though.
           if (auto it = elle::find(this->_channels, channel_id))
@@ -91,6 +153,59 @@ namespace elle
       }
     }
 
+    void
+    ChanneledStream::_receive(int id, elle::Buffer p)
+    {
+      if (p.empty())
+        elle::err("%s: empty packet on channel %s", this, id);
+      auto const frame = static_cast<Frame>(p[0]);
+      p.pop_front(1);
+      if (frame == Frame::credit)
+      {
+        auto const credit = this->uint32_get(p, this->version());
+        if (auto it = elle::find(this->_flows, id))
+        {
+          ELLE_DEBUG("%s: granted %s bytes on channel %s", this, credit, id);
+          it->second.credit += credit;
+          this->_sendable.signal();
+        }
+        return;
+      }
+      else if (frame != Frame::last && frame != Frame::more)
+        elle::err("%s: unknown frame %s on channel %s", this, int(frame), id);
+      auto channel = static_cast<Channel*>(nullptr);
+      if (auto it = elle::find(this->_channels, id))
+        channel = it->second;
+      else if ((this->_master && id > 0) || (!this->_master && id < 0))
+      {
+        ELLE_TRACE("discard orphaned packet on channel %s", id);
+        // Let the peer carry on, its packets are discarded too.
+        this->_updates.emplace_back(id, p.size());
+        this->_sendable.signal();
+        return;
+      }
+      else
+      {
+        ELLE_DEBUG("new channel %s", id);
+        // The accepted channel is moved, and registers itself anew.
+        this->_channels_new.put(Channel(*this, id));
+        channel = this->_channels.at(id);
+      }
+      auto& flow = this->_flows[id];
+      flow.granted -= p.size();
+      if (frame == Frame::more || !flow.partial.empty())
+        flow.partial.append(p.contents(), p.size());
+      if (frame == Frame::last)
+      {
+        auto packet =
+          flow.partial.empty() ? std::move(p) : std::move(flow.partial);
+        ELLE_DEBUG("received %f on channel %s", packet, *channel);
+        flow.queued += packet.size();
+        channel->_packets.put(std::move(packet));
+      }
+      this->_grant(id, flow);
+    }
+
     bool
     ChanneledStream::_handshake()
     {
@@ -101,8 +216,9 @@ namespace elle
         char his;
         {
           elle::Buffer p;
+          p.headroom(Stream::headroom);
           p.append(&mine, 1);
-          this->_backend.write(p);
+          this->_backend.write(std::move(p));
           ELLE_DEBUG("%s: my roll: %d", *this, (int)mine);
         }
         {
@@ -168,20 +284,224 @@ namespace elle
     `--------*/
 
     void
-    ChanneledStream::_write(elle::Buffer const& packet)
+    ChanneledStream::_write(elle::Buffer& packet)
     {
-      this->_default.write(packet);
+      this->_default.write(std::move(packet));
     }
 
     void
-    ChanneledStream::_write(elle::Buffer const& packet, int id)
+    ChanneledStream::_write(elle::Buffer& packet, int id)
     {
       ELLE_TRACE_SCOPE("%s: send %f on channel %s", *this, packet, id);
+      if (!this->_flow_control)
+      {
+        this->uint32_prepend(packet, id, this->version());
+        this->_backend.write(std::move(packet));
+        return;
+      }
+      if (this->_write_exception)
+        std::rethrow_exception(this->_write_exception);
+      Pending pending(packet);
+      {
+        auto& flow = this->_flows[id];
+        flow.pending.push_back(&pending);
+        if (flow.pending.size() == 1)
+        {
+          this->_ready.push_back(id);
+          this->_sendable.signal();
+        }
+      }
+      try
+      {
+        elle::reactor::wait(pending.sent);
+      }
+      catch (...)
+      {
+        if (!pending.sent.opened())
+        {
+          auto& flow = this->_flows.at(id);
+          auto it = std::find(flow.pending.begin(), flow.pending.end(),
+                              &pending);
+          if (!pending.started)
+          {
+            flow.pending.erase(it);
+            if (flow.pending.empty())
+            {
+              auto ready =
+                std::find(this->_ready.begin(), this->_ready.end(), id);
+              if (ready != this->_ready.end())
+                this->_ready.erase(ready);
+              if (flow.closed)
+                this->_flows.erase(id);
+            }
+          }
+          else
+          {
+            // Partly sent: the peer expects the rest.
+            auto orphan = new Pending(*pending.packet);
+            orphan->orphaned = std::move(*pending.packet);
+            orphan->packet = &orphan->orphaned;
+            orphan->offset = pending.offset;
+            orphan->started = true;
+            orphan->orphan = true;
+            *it = orphan;
+          }
+        }
+        throw;
+      }
+      if (pending.exception)
+        std::rethrow_exception(pending.exception);
+    }
 
-      auto backend_packet = elle::Buffer{};
-      this->uint32_put(backend_packet, id, this->version());
-      backend_packet.append(packet.contents(), packet.size());
-      this->_backend.write(backend_packet);
+    /*-------------.
+    | Flow control |
+    `-------------*/
+
+    void
+    ChanneledStream::_write_thread()
+    {
+      ELLE_TRACE_SCOPE("%s: write packets", this);
+      try
+      {
+        while (true)
+          if (!this->_updates.empty())
+          {
+            auto updates = std::move(this->_updates);
+            this->_updates.clear();
+            for (auto const& update: updates)
+            {
+              ELLE_DEBUG("%s: grant %s bytes on channel %s",
+                         this, update.second, update.first);
+              auto packet = elle::Buffer{};
+              packet.headroom(Stream::headroom);
+              this->uint32_put(packet, update.first, this->version());
+              auto const frame = Frame::credit;
+              packet.append(&frame, 1);
+              this->uint32_put(packet, update.second, this->version());
+              this->_backend.write(std::move(packet));
+            }
+          }
+          else
+          {
+            // Give its turn to the next channel with credit left.
+            auto sent = false;
+            for (auto n = this->_ready.size(); n && !sent; --n)
+            {
+              auto const id = this->_ready.front();
+              this->_ready.pop_front();
+              auto& flow = this->_flows.at(id);
+              if (flow.credit > 0)
+              {
+                for (auto i = 0;
+                     i < flow.weight && !flow.pending.empty() &&
+                       flow.credit > 0;
+                     ++i)
+                  this->_write_fragment(id, flow);
+                sent = true;
+              }
+              if (!flow.pending.empty())
+                this->_ready.push_back(id);
+              else if (flow.closed)
+                this->_flows.erase(id);
+            }
+            if (!sent)
+              elle::reactor::wait(this->_sendable);
+          }
+      }
+      catch (elle::Error const&)
+      {
+        ELLE_TRACE("%s: write failed: %s", this, elle::exception_string());
+        this->_write_exception = std::current_exception();
+        for (auto& flow: this->_flows)
+        {
+          for (auto* pending: flow.second.pending)
+            if (pending->orphan)
+              delete pending;
+            else
+            {
+              pending->exception = std::current_exception();
+              pending->sent.open();
+            }
+          flow.second.pending.clear();
+        }
+        this->_ready.clear();
+      }
+    }
+
+    void
+    ChanneledStream::_write_fragment(int id, Flow& flow)
+    {
+      auto* pending = flow.pending.front();
+      auto const remaining = int64_t(pending->packet->size() - pending->offset);
+      auto const size = std::min({remaining, int64_t(fragment), flow.credit});
+      auto const frame = size == remaining ? Frame::last : Frame::more;
+      auto packet = elle::Buffer{};
+      if (pending->offset == 0 && frame == Frame::last)
+        // Sent at once, take it over to prepend our header in place.
+        packet = std::move(*pending->packet);
+      else
+      {
+        packet.headroom(Stream::headroom);
+        packet.append(pending->packet->contents() + pending->offset, size);
+        Stream::_copied(size);
+      }
+      Stream::_prepend(packet, &frame, 1);
+      this->uint32_prepend(packet, id, this->version());
+      pending->offset += size;
+      pending->started = true;
+      flow.credit -= size;
+      ELLE_DEBUG("%s: send %s bytes on channel %s", this, size, id);
+      this->_backend.write(std::move(packet));
+      if (frame == Frame::last)
+      {
+        // Its writer may have left meanwhile, handing the packet over.
+        pending = flow.pending.front();
+        flow.pending.pop_front();
+        if (pending->orphan)
+          delete pending;
+        else
+          pending->sent.open();
+      }
+    }
+
+    void
+    ChanneledStream::_consumed(int id, int64_t size)
+    {
+      if (this->_flow_control)
+        if (auto it = elle::find(this->_flows, id))
+        {
+          it->second.queued -= size;
+          this->_grant(id, it->second);
+        }
+    }
+
+    void
+    ChanneledStream::_grant(int id, Flow& flow)
+    {
+      // Count the packet being reassembled only while others wait to be
+      // read: one larger than the window must get through once they are.
+      auto const used =
+        flow.queued ? flow.queued + int64_t(flow.partial.size()) : 0;
+      auto const credit = window - used - flow.granted;
+      // Batch grants, rather than sending one per packet read.
+      if (credit >= window / 2)
+      {
+        flow.granted += credit;
+        this->_updates.emplace_back(id, credit);
+        this->_sendable.signal();
+      }
+    }
+
+    void
+    ChanneledStream::_close(int id)
+    {
+      if (auto it = elle::find(this->_flows, id))
+      {
+        if (it->second.pending.empty())
+          this->_flows.erase(id);
+        else
+          it->second.closed = true;
+      }
     }
 
     /*--------.
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <deque>
 #include <unordered_map>
 
 #include <elle/protocol/Channel.hh>
@@ -20,6 +21,14 @@ namespace elle
     /// the socket to communicate through the same socket. Multiplexing and
     /// demultiplexing will be transparent for the user.
     ///
+    /// With flow control, channels are flow controlled: a peer may only send
+    /// `window` bytes on a channel before the receiver, as its user reads
+    /// them, grants it more. Pending packets of all channels are sent in
+    /// fragments of at most `fragment` bytes, round-robin, so a bulk
+    /// transfer neither fills the receiver memory nor delays packets of
+    /// other channels by more than a fragment per active channel. Both peers
+    /// must enable it.
+    ///
     /// @code{.cc}
     ///
     /// // Consider two peers, connected by an arbitrary socket s.
@@ -52,8 +61,12 @@ namespace elle
     | Construction |
     `-------------*/
     public:
-      ChanneledStream(elle::reactor::Scheduler& scheduler, Stream& backend);
-      ChanneledStream(Stream& backend);
+      /// @param flow_control Whether to flow control channels, which changes
+      ///                     the framing: the peer must enable it too.
+      ChanneledStream(elle::reactor::Scheduler& scheduler,
+                      Stream& backend,
+                      bool flow_control = false);
+      ChanneledStream(Stream& backend, bool flow_control = false);
       virtual
       ~ChanneledStream();
     private:
@@ -62,6 +75,8 @@ namespace elle
       ELLE_ATTRIBUTE(Stream&, backend);
       ELLE_ATTRIBUTE(reactor::Thread::unique_ptr, thread);
       ELLE_ATTRIBUTE(std::exception_ptr, exception);
+      /// Whether channels are flow controlled.
+      ELLE_ATTRIBUTE_R(bool, flow_control);
 
     /*--------.
     | Version |
@@ -101,10 +116,66 @@ namespace elle
     `--------*/
     protected:
       void
-      _write(elle::Buffer const& packet) override;
+      _write(elle::Buffer& packet) override;
+    private:
+      void
+      _write(elle::Buffer& packet, int id);
+
+    /*-------------.
+    | Flow control |
+    `-------------*/
+    public:
+      /// Bytes the peer may send on a channel before being granted more.
+      static constexpr int64_t window = 1 << 20;
+      /// Maximum size of the fragments packets are sent in.
+      static constexpr int fragment = 1 << 16;
     private:
+      /// A packet being sent.
+      struct Pending;
+      /// Flow control state of a channel.
+      struct Flow
+      {
+        /// Packets to send, in order.
+        std::deque<Pending*> pending;
+        /// Bytes we may still send.
+        int64_t credit = window;
+        /// Fragments sent per round.
+        int weight = 1;
+        /// Whether the channel was closed, pending packets still being sent.
+        bool closed = false;
+        /// Packet being reassembled.
+        elle::Buffer partial;
+        /// Bytes received and not read yet.
+        int64_t queued = 0;
+        /// Bytes the peer may still send.
+        int64_t granted = window;
+      };
+      /// Send pending packets and window updates.
+      void
+      _write_thread();
+      /// Send the next fragment of the first pending packet of channel @a id.
+      void
+      _write_fragment(int id, Flow& flow);
+      /// Handle a flow controlled packet read on channel @a id.
+      void
+      _receive(int id, elle::Buffer packet);
+      /// Account for @a size bytes read by the user of channel @a id.
+      void
+      _consumed(int id, int64_t size);
+      /// Grant the peer more credit on channel @a id if worth it.
+      void
+      _grant(int id, Flow& flow);
+      /// Forget channel @a id once its pending packets are sent.
       void
-      _write(elle::Buffer const& packet, int id);
+      _close(int id);
+      ELLE_ATTRIBUTE((std::unordered_map<int, Flow>), flows);
+      /// Channels with pending packets, in sending order.
+      ELLE_ATTRIBUTE(std::deque<int>, ready);
+      /// Credits to grant the peer, by channel.
+      ELLE_ATTRIBUTE((std::vector<std::pair<int, int64_t>>), updates);
+      ELLE_ATTRIBUTE(elle::reactor::Signal, sendable);
+      ELLE_ATTRIBUTE(std::exception_ptr, write_exception);
+      ELLE_ATTRIBUTE(reactor::Thread::unique_ptr, writer);
 
     /*----------.
     | Printable |
@@ -168,13 +168,14 @@ namespace elle
       Channel channel(this->_owner._channels);
       {
         elle::Buffer question;
+        question.headroom(Stream::headroom);
         {
           elle::IOStream outs(question.ostreambuf());
           OS output(outs);
           output << this->_id;
           put_args<OS, Args...>(output, args...);
         }
-        channel.write(question);
+        channel.write(std::move(question));
       }
       {
         elle::Buffer response(channel.read());
@@ -441,6 +442,7 @@ namespace elle
           auto proc = this->_procedures.find(id);
 
           elle::Buffer answer;
+          answer.headroom(Stream::headroom);
           elle::IOStream outs(answer.ostreambuf());
           OS output(outs);
           try
@@ -471,7 +473,7 @@ namespace elle
             stop_request = handle_exception(handler, output, std::current_exception());
           }
           outs.flush();
-          c.write(answer);
+          c.write(std::move(answer));
         }
       }
       catch (elle::reactor::network::ConnectionClosed const& e)
@@ -515,6 +517,7 @@ namespace elle
               auto proc = this->_procedures.find(id);
 
               elle::Buffer answer;
+              answer.headroom(Stream::headroom);
               elle::IOStream outs(answer.ostreambuf());
               OS output(outs);
               try
@@ -558,7 +561,7 @@ namespace elle
                        << uint16_t(0);
               }
               outs.flush();
-              chan->write(answer);
+              chan->write(std::move(answer));
             };
             scope.run_background(elle::sprintf("RPC %s", i), call_procedure);
           }
@@ -278,13 +278,32 @@ namespace elle
       }
 
       void
-      write(elle::Buffer const& packet)
+      write(elle::Buffer& packet)
       {
         elle::reactor::Lock lock(this->_lock_write);
         elle::IOStreamClear clearer(this->_stream);
         this->_write(packet);
       }
 
+      void
+      write(elle::Buffer const& packet)
+      {
+        if (this->_single(packet))
+        {
+          // Headers are prepended in place.
+          auto copy = elle::Buffer{};
+          copy.headroom(Serializer::headroom);
+          copy.append(packet.contents(), packet.size());
+          Serializer::_copied(packet.size());
+          this->write(copy);
+          return;
+        }
+        elle::reactor::Lock lock(this->_lock_write);
+        elle::IOStreamClear clearer(this->_stream);
+        this->_write_chunks(packet);
+        Serializer::_sent();
+      }
+
       void
       write_control(Control control)
       {
@@ -402,7 +421,61 @@ namespace elle
       ELLE_ATTRIBUTE_RX(boost::signals2::signal<void ()>, ping_timeout);
 
       void
-      _write(elle::Buffer const& packet)
+      _write(elle::Buffer& packet)
+      {
+        this->_write_packet(packet);
+        Serializer::_sent();
+      }
+
+      /// Whether @a packet is sent in one chunk, headers prepended.
+      bool
+      _single(elle::Buffer const& packet) const
+      {
+        return this->version() >= elle::Version(0, 2, 0) &&
+          packet.size() <= this->_chunk_size;
+      }
+
+      void
+      _write_packet(elle::Buffer& packet)
+      {
+        if (this->_single(packet))
+        {
+          // Sent in one chunk: prepend the headers in place and write the
+          // whole packet at once.
+          auto const size = packet.size();
+          if (this->_checksum)
+          {
+            auto hash = compute_checksum(packet);
+            ELLE_DEBUG("send checksum: 0x%x", hash);
+            Serializer::Super::uint32_prepend(packet, size, this->version());
+            Serializer::_prepend(packet, hash.contents(), hash.size());
+            Serializer::Super::uint32_prepend(
+              packet, hash.size(), this->version());
+          }
+          else
+            Serializer::Super::uint32_prepend(packet, size, this->version());
+          if (this->version() >= elle::Version(0, 3, 0))
+          {
+            this->write_pings_pongs(false);
+            auto const control = Control::keep_going;
+            Serializer::_prepend(packet, &control, 1);
+          }
+          elle::With<elle::reactor::Thread::NonInterruptible>() << [&]
+          {
+            ELLE_DEBUG("send packet of size %s", size)
+              this->_stream.write(
+                reinterpret_cast<char const*>(packet.contents()),
+                packet.size());
+            this->_stream.flush();
+          };
+        }
+        else
+          this->_write_chunks(packet);
+      }
+
+      /// Write @a packet and its headers separately.
+      void
+      _write_chunks(elle::Buffer const& packet)
       {
         if (this->version() >= elle::Version(0, 3, 0))
           this->write_control(Control::keep_going);
@@ -550,7 +623,13 @@ namespace elle
     `--------*/
 
     void
-    Serializer::_write(elle::Buffer const& packet)
+    Serializer::_write(elle::Buffer& packet)
+    {
+      this->_impl->write(packet);
+    }
+
+    void
+    Serializer::_write_const(elle::Buffer const& packet)
     {
       this->_impl->write(packet);
     }
@@ -88,9 +88,15 @@ namespace elle
     protected:
       /// Write data to the stream.
       ///
+      /// Packets sent in one chunk get their headers prepended in place and
+      /// are written at once.
+      ///
       /// @param packet The packet to write.
       void
-      _write(elle::Buffer const& packet) override;
+      _write(elle::Buffer& packet) override;
+      /// Write data to the stream, only copying packets sent in one chunk.
+      void
+      _write_const(elle::Buffer const& packet) override;
 
     /*----------.
     | Printable |
@@ -1,4 +1,5 @@
 #include <elle/log.hh>
+#include <elle/metrics.hh>
 
 #include <elle/protocol/Stream.hh>
 #include <elle/protocol/Serializer.hh>
@@ -52,13 +53,32 @@ namespace elle
     | Sending |
     `--------*/
 
+    constexpr elle::Buffer::Size Stream::headroom;
+
     void
     Stream::write(elle::Buffer const& packet)
+    {
+      ELLE_TRACE_SCOPE("%s: write packet (%s bytes)", this, packet.size());
+      this->_write_const(packet);
+    }
+
+    void
+    Stream::write(elle::Buffer&& packet)
     {
       ELLE_TRACE_SCOPE("%s: write packet (%s bytes)", this, packet.size());
       this->_write(packet);
     }
 
+    void
+    Stream::_write_const(elle::Buffer const& packet)
+    {
+      auto copy = elle::Buffer{};
+      copy.headroom(Stream::headroom);
+      copy.append(packet.contents(), packet.size());
+      Stream::_copied(packet.size());
+      this->_write(copy);
+    }
+
     /*------------------.
     | Int serialization |
     `------------------*/
@@ -98,6 +118,27 @@ namespace elle
       }
     }
 
+    void
+    Stream::uint32_prepend(elle::Buffer& b, uint32_t i, elle::Version const& v)
+    {
+      if (v >= elle::Version(0, 3, 0))
+      {
+        unsigned char bytes[9];
+        auto size = std::size_t(0);
+        {
+          auto buffer = elle::WeakBuffer(bytes);
+          elle::IOStream output(buffer.ostreambuf());
+          size = SerializerOut::serialize_number(output, i);
+        }
+        Stream::_prepend(b, bytes, size);
+      }
+      else
+      {
+        i = htonl(i);
+        Stream::_prepend(b, &i, 4);
+      }
+    }
+
     void
     Stream::uint32_put(std::ostream& s, uint32_t i, elle::Version const& v)
     {
@@ -140,5 +181,38 @@ namespace elle
         return ntohl(res);
       }
     }
+
+    /*-----------.
+    | Statistics |
+    `-----------*/
+
+    void
+    Stream::_prepend(elle::Buffer& packet,
+                     void const* data,
+                     elle::Buffer::Size size)
+    {
+      if (packet.headroom() < size)
+        Stream::_copied(packet.size());
+      packet.prepend(data, size);
+    }
+
+    void
+    Stream::_copied(elle::Buffer::Size size)
+    {
+      static auto const copies = metrics::registry().counter("protocol.copies");
+      static auto const bytes =
+        metrics::registry().counter("protocol.copies.bytes");
+      ELLE_DEBUG("copy packet of %s bytes", size);
+      copies->increment();
+      bytes->increment(size);
+    }
+
+    void
+    Stream::_sent()
+    {
+      static auto const packets =
+        metrics::registry().counter("protocol.packets");
+      packets->increment();
+    }
   }
 }
@@ -58,15 +58,35 @@ namespace elle
     | Sending |
     `--------*/
     public:
+      /// Room to reserve in front of packets for the headers of the layers
+      /// below, so they are never moved on their way down.
+      static constexpr elle::Buffer::Size headroom = 64;
       /// Write an packet.
       ///
+      /// The packet is copied first if headers are to be prepended to it,
+      /// prefer giving it away.
+      ///
       /// @param packet The buffer to write.
       void
       write(elle::Buffer const& packet);
+      /// Write an packet, prepending headers in its headroom.
+      ///
+      /// @param packet The buffer to write, whose content is unspecified
+      ///               afterwards.
+      void
+      write(elle::Buffer&& packet);
     protected:
+      /// Write a packet, whose content may be altered or given away.
+      virtual
+      void
+      _write(elle::Buffer& packet) = 0;
+      /// Write a packet that must be left untouched.
+      ///
+      /// Copies it with headroom and calls _write by default. Override to
+      /// spare the copy where no header is prepended to the packet.
       virtual
       void
-      _write(elle::Buffer const& packet) = 0;
+      _write_const(elle::Buffer const& packet);
 
     /*------------------.
     | Int serialization |
@@ -114,6 +134,37 @@ namespace elle
       static
       uint32_t
       uint32_get(elle::Buffer& s, elle::Version const& v);
+      /// Write an uint32_t in front of @a given buffer.
+      ///
+      /// @param buffer The buffer to prepend to, preferably with headroom.
+      /// @param i The int to write.
+      /// @param v The version.
+      static
+      void
+      uint32_prepend(elle::Buffer& buffer, uint32_t i, elle::Version const& v);
+
+    /*-----------.
+    | Statistics |
+    `-----------*/
+    protected:
+      /// Prepend @a data to @a packet, accounting for the copy if it lacks
+      /// headroom.
+      static
+      void
+      _prepend(elle::Buffer& packet, void const* data, elle::Buffer::Size size);
+      /// Account for a copy of @a size bytes of a packet.
+      ///
+      /// Copies are counted in the "protocol.copies" and
+      /// "protocol.copies.bytes" metrics. Compared to the "protocol.packets"
+      /// count of packets written by the lowest layer, they give how many
+      /// times each message is copied on its way down.
+      static
+      void
+      _copied(elle::Buffer::Size size);
+      /// Account for a packet written by the lowest layer.
+      static
+      void
+      _sent();
     };
   }
 }
@@ -1,5 +1,7 @@
 #include <elle/random.hh>
 
+#include <atomic>
+
 #ifdef VALGRIND
 # include <valgrind/valgrind.h>
 #else
@@ -10,21 +12,80 @@
 
 namespace elle
 {
-  /// A unique random device.
-  std::mt19937&
+  namespace
+  {
+    std::uint64_t
+    splitmix64(std::uint64_t& x)
+    {
+      auto z = (x += 0x9e3779b97f4a7c15);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+      return z ^ (z >> 31);
+    }
+
+    std::uint64_t
+    entropy(std::random_device& rd)
+    {
+      return (std::uint64_t(rd()) << 32) ^ rd();
+    }
+  }
+
+  /*-------------.
+  | RandomEngine |
+  `-------------*/
+
+  constexpr RandomEngine::result_type RandomEngine::default_seed;
+
+  RandomEngine::RandomEngine(result_type seed, std::uint64_t reseed)
+    : _state()
+    , _reseed(reseed)
+    , _countdown(reseed)
+  {
+    this->seed(seed);
+  }
+
+  void
+  RandomEngine::seed(result_type seed)
+  {
+    for (auto& s: this->_state)
+      s = splitmix64(seed);
+    this->_countdown = this->_reseed;
+  }
+
+  void
+  RandomEngine::_refresh()
+  {
+    std::random_device rd{};
+    auto seed = entropy(rd);
+    for (auto& s: this->_state)
+      s ^= splitmix64(seed);
+    // The only state xoshiro cannot leave.
+    if (this->_state == decltype(this->_state){})
+      this->seed(default_seed);
+    this->_countdown = this->_reseed;
+  }
+
+  /*--------------.
+  | random_engine |
+  `--------------*/
+
+  RandomEngine&
   random_engine()
   {
-    static auto res = []
+    static thread_local auto res = []
       {
+        static std::atomic<RandomEngine::result_type> threads{0};
+        auto const index = threads++;
         // Valgrind does not like the random_device.
         // http://stackoverflow.com/questions/37032339.
         if (os::getenv("ELLE_SEED", false)
             || RUNNING_ON_VALGRIND)
-          return std::mt19937{std::mt19937::default_seed};
+          // Deterministic, but distinct across threads.
+          return RandomEngine{RandomEngine::default_seed + index};
         else
         {
           std::random_device rd{};
-          return std::mt19937{rd()};
+          return RandomEngine{entropy(rd) ^ index, 1u << 20};
         }
       }();
     return res;
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <array>
 #include <cassert>
+#include <cstdint>
+#include <limits>
 #include <random>
 #include <vector>
 
@@ -10,10 +13,63 @@
 #include <boost/range/algorithm/sort.hpp>
 #include <boost/range/algorithm_ext/iota.hpp>
 
+#include <elle/attribute.hh>
+#include <elle/compiler.hh>
+
 namespace elle
 {
-  /// A unique random device.
-  std::mt19937&
+  /// A fast, non-cryptographic random engine: xoshiro256**.
+  ///
+  /// It satisfies UniformRandomBitGenerator and is thus usable with standard
+  /// distributions. It can mix fresh entropy in its state every so many
+  /// outputs, so long lived threads do not follow a single sequence forever.
+  /// Use elle::cryptography::random to generate secrets.
+  class ELLE_API RandomEngine
+  {
+  public:
+    using result_type = std::uint64_t;
+    static constexpr result_type default_seed = 5489u;
+
+    /// Construct an engine.
+    ///
+    /// @param seed The seed, @see seed.
+    /// @param reseed Number of outputs after which entropy from
+    ///               std::random_device is mixed in the state, 0 for never.
+    RandomEngine(result_type seed = default_seed, std::uint64_t reseed = 0);
+    /// Reset the state from @a seed, through splitmix64.
+    void
+    seed(result_type seed);
+    /// The next output.
+    result_type
+    operator ()();
+    static constexpr
+    result_type
+    min()
+    {
+      return 0;
+    }
+    static constexpr
+    result_type
+    max()
+    {
+      return std::numeric_limits<result_type>::max();
+    }
+
+  private:
+    void
+    _refresh();
+    ELLE_ATTRIBUTE((std::array<std::uint64_t, 4>), state);
+    ELLE_ATTRIBUTE_R(std::uint64_t, reseed);
+    ELLE_ATTRIBUTE(std::uint64_t, countdown);
+  };
+
+  /// The random engine of the current thread.
+  ///
+  /// Each thread gets its own engine, seeded from std::random_device and
+  /// reseeded periodically, so it can be used without locking. With
+  /// ELLE_SEED set, or under valgrind, engines are deterministic instead.
+  ELLE_API
+  RandomEngine&
   random_engine();
 
   /// A uniform distribution in [0, size(r) - 1].
@@ -30,7 +86,7 @@ namespace elle
   /// Random integer in [0, size-1].
   ///
   /// @return an iterator.
-  template <typename Gen = std::mt19937>
+  template <typename Gen = RandomEngine>
   auto
   pick_one(int size, Gen& gen = random_engine())
   {
@@ -41,7 +97,7 @@ namespace elle
   /// Random selection in a range.
   ///
   /// @return an iterator.
-  template <typename Range, typename Gen = std::mt19937>
+  template <typename Range, typename Gen = RandomEngine>
   auto
   pick_one(Range& r, Gen& gen = random_engine())
     -> decltype(gen.seed(0),  // sfinae
@@ -56,7 +112,7 @@ namespace elle
   /// Random selection in a range with a filter.
   ///
   /// @return an iterator.
-  template <typename Range, typename Pred, typename Gen = std::mt19937>
+  template <typename Range, typename Pred, typename Gen = RandomEngine>
   auto
   pick_one(Range& r, Pred pred, Gen& gen = random_engine())
     -> decltype(pred(*boost::begin(r)),  // sfinae
@@ -69,7 +125,7 @@ namespace elle
   /// A (sorted) range of n numbers to choose in [0, size - 1].
   ///
   /// @pre n < size(r).
-  template <typename Gen = std::mt19937>
+  template <typename Gen = RandomEngine>
   auto
   pick_n(int count, int size, Gen& gen = random_engine())
   {
@@ -119,10 +175,12 @@ namespace elle
   /// A (sorted) range of n iterators in a container.
   ///
   /// @pre n < size(r).
-  template <typename Range, typename Gen = std::mt19937>
+  template <typename Range, typename Gen = RandomEngine>
   auto
   pick_n(int count, Range& r, Gen& gen = random_engine())
   {
     return select(r, pick_n(count, boost::size(r), gen));
   }
 }
+
+#include <elle/random.hxx>
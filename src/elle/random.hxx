@@ -0,0 +1,30 @@
+#pragma once
+
+/*-------------.
+| RandomEngine |
+`-------------*/
+
+namespace elle
+{
+  inline
+  RandomEngine::result_type
+  RandomEngine::operator ()()
+  {
+    auto& s = this->_state;
+    auto const rotl = [] (std::uint64_t x, int k)
+      {
+        return (x << k) | (x >> (64 - k));
+      };
+    auto const res = rotl(s[1] * 5, 7) * 9;
+    auto const t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    if (this->_countdown && !--this->_countdown)
+      this->_refresh();
+    return res;
+  }
+}
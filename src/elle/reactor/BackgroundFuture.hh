@@ -35,7 +35,9 @@ namespace elle
       /// will be available when the Action is over.
       ///
       /// @param action The Action to perform.
-      BackgroundFuture(Action action);
+      /// @param kind Whether the Action blocks or computes, for this Action
+      ///             and the ones assigned later.
+      BackgroundFuture(Action action, Background kind = Background::blocking);
       ~BackgroundFuture();
       BackgroundFuture(BackgroundFuture<T> const& src);
       /// Return the value. If not yet available, block until it is.
@@ -65,6 +67,7 @@ namespace elle
       /// Whether the action is currently running.
       bool
       running() const;
+      ELLE_ATTRIBUTE(Background, kind);
       ELLE_ATTRIBUTE(boost::optional<BackgroundOperation<T>>, operation);
       ELLE_ATTRIBUTE(boost::optional<T>, value);
     private:
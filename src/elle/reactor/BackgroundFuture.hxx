@@ -10,7 +10,8 @@ namespace elle
     template <typename T>
     template <typename>
     BackgroundFuture<T>::BackgroundFuture()
-      : _operation()
+      : _kind(Background::blocking)
+      , _operation()
       , _value()
     {
       this->_value.emplace();
@@ -18,21 +19,25 @@ namespace elle
 
     template <typename T>
     BackgroundFuture<T>::BackgroundFuture(T value)
-      : _operation()
+      : _kind(Background::blocking)
+      , _operation()
       , _value(std::move(value))
     {}
 
     template <typename T>
-    BackgroundFuture<T>::BackgroundFuture(Action action)
-      : _operation(std::move(action))
+    BackgroundFuture<T>::BackgroundFuture(Action action, Background kind)
+      : _kind(kind)
+      , _operation()
       , _value()
     {
+      this->_operation.emplace(std::move(action), kind);
       this->_operation->start();
     }
 
     template <typename T>
     BackgroundFuture<T>::BackgroundFuture(BackgroundFuture<T> const& src)
-      : _operation()
+      : _kind(src._kind)
+      , _operation()
       , _value(src.value())
     {}
 
@@ -46,7 +51,7 @@ namespace elle
     {
       this->_operation.reset();
       this->_value.reset();
-      this->_operation.emplace(std::move(action));
+      this->_operation.emplace(std::move(action), this->_kind);
       this->_operation->start();
       return *this;
     }
@@ -2,6 +2,7 @@
 
 #include <elle/optional.hh>
 
+#include <elle/reactor/BackgroundPool.hh>
 #include <elle/reactor/Operation.hh>
 
 namespace elle
@@ -31,8 +32,8 @@ namespace elle
     /// BackgroundOperation is a specialized Operation to run background
     /// operations in the Scheduler.
     ///
-    /// BackgroundOperation run the action in an std::thread and handle the
-    /// locking for you.
+    /// BackgroundOperation run the action in a system thread of the Scheduler
+    /// BackgroundPool for its kind and handle the locking for you.
     template<typename T>
     class BackgroundOperation
       : public Operation
@@ -40,23 +41,24 @@ namespace elle
     {
     public:
       using Action = std::function<T ()>;
-      struct Status
-      {
-        bool aborted;
-      };
 
     public:
       /// Construct a BackgroundOperation from an Action.
       ///
       /// \param action The Action to perform.
-      BackgroundOperation(Action const& action);
+      /// \param kind Whether the action blocks or computes.
+      BackgroundOperation(Action action,
+                          Background kind = Background::blocking);
       ~BackgroundOperation();
       ELLE_ATTRIBUTE(Action, action);
-      ELLE_ATTRIBUTE(std::shared_ptr<Status>, status);
+      ELLE_ATTRIBUTE_R(Background, kind);
+    private:
+      class Job;
+      ELLE_ATTRIBUTE(std::shared_ptr<Job>, job);
 
     protected:
-      /// Start the Operation by running the Action via
-      /// Scheduler::_run_background.
+      /// Start the Operation by submitting the Action to the Scheduler
+      /// BackgroundPool.
       ///
       /// When the operation is over, store the in
       /// BackgroundOperationResult::_result and call Operation::done();
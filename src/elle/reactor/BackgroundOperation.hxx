@@ -1,7 +1,6 @@
 #include <elle/reactor/BackgroundOperation.hh>
 
 #include <elle/log.hh>
-#include <elle/utility/Move.hh>
 
 #include <elle/reactor/scheduler.hh>
 
@@ -10,13 +9,13 @@ namespace elle
   namespace reactor
   {
     template <typename T>
-    BackgroundOperation<T>::BackgroundOperation(Action const& action)
+    BackgroundOperation<T>::BackgroundOperation(Action action,
+                                                Background kind)
       : Operation(*Scheduler::scheduler())
-      , _action(action)
-      , _status(std::make_shared<Status>())
-    {
-      this->_status->aborted = false;
-    }
+      , _action(std::move(action))
+      , _kind(kind)
+      , _job()
+    {}
 
     template <typename T>
     BackgroundOperation<T>::~BackgroundOperation()
@@ -63,46 +62,61 @@ namespace elle
       };
     }
 
+    /// The action, its outcome, and the operation to report it to unless
+    /// it was aborted.
+    template <typename T>
+    class BackgroundOperation<T>::Job
+      : public BackgroundPool::Job
+    {
+    public:
+      Job(BackgroundOperation<T>& owner)
+        : owner(&owner)
+        , action(std::move(owner._action))
+        , value()
+        , exception()
+      {}
+
+      void
+      run() noexcept override
+      {
+        ELLE_LOG_COMPONENT("elle.reactor.BackgroundOperation");
+        try
+        {
+          ELLE_TRACE_SCOPE("run background operation");
+          this->value.emplace(result<T>::call(this->action));
+        }
+        catch (...)
+        {
+          ELLE_TRACE("background operation threw: %s",
+                     elle::exception_string());
+          this->exception = std::current_exception();
+        }
+      }
+
+      void
+      complete() override
+      {
+        if (!this->owner)
+          return;
+        if (this->exception)
+          this->owner->_raise(this->exception);
+        else
+          this->owner->_result_set(std::move(*this->value));
+        this->owner->done();
+      }
+
+      BackgroundOperation<T>* owner;
+      Action action;
+      boost::optional<decltype(result<T>::call(std::declval<Action>()))> value;
+      std::exception_ptr exception;
+    };
+
     template <typename T>
     void
     BackgroundOperation<T>::_start()
     {
-      ELLE_LOG_COMPONENT("elle.reactor.BackgroundOperation");
-      auto status = this->_status;
-      auto action = this->_action;
-      auto& sched = reactor::scheduler();
-      sched._run_background(
-        [this, status, action, &sched] () -> std::function<void ()>
-        {
-          try
-          {
-            ELLE_TRACE_SCOPE("%s: run background operation", sched);
-            auto res = elle::utility::move_on_copy(result<T>::call(action));
-            ELLE_TRACE("%s: background operation finished", sched);
-            return [this, status, res]
-            {
-              if (!status->aborted)
-              {
-                this->_result_set(std::move(*res));
-                this->done();
-              }
-            };
-          }
-          catch (...)
-          {
-            ELLE_TRACE("%s: background operation threw: %s",
-                       sched, elle::exception_string());
-            auto e = std::current_exception();
-            return [this, status, e]
-            {
-              if (!status->aborted)
-              {
-                this->_raise(e);
-                this->done();
-              }
-            };
-          }
-        });
+      this->_job = std::make_shared<Job>(*this);
+      this->sched().background_pool(this->_kind).submit(this->_job);
     }
 
     template <typename T>
@@ -110,9 +124,9 @@ namespace elle
     BackgroundOperation<T>::_abort()
     {
       ELLE_LOG_COMPONENT("elle.reactor.BackgroundOperation");
-      auto& sched = *Scheduler::scheduler();
-      ELLE_TRACE_SCOPE("%s: abort background operation", sched);
-      this->_status->aborted = true;
+      ELLE_TRACE_SCOPE("%s: abort background operation", this->sched());
+      if (this->_job)
+        this->_job->owner = nullptr;
       this->_signal();
     }
   }
@@ -0,0 +1,346 @@
+#include <algorithm>
+
+#include <elle/log.hh>
+#include <elle/os/environ.hh>
+#include <elle/reactor/BackgroundPool.hh>
+
+ELLE_LOG_COMPONENT("elle.reactor.BackgroundPool");
+
+namespace elle
+{
+  namespace reactor
+  {
+    using Clock = std::chrono::steady_clock;
+
+    /*-----.
+    | Jobs |
+    `-----*/
+
+    BackgroundPool::Job::~Job()
+    {}
+
+    BackgroundPool::BackgroundPool(boost::asio::io_service& service)
+      : _service(service)
+      , _completed_mutex()
+      , _completed()
+    {}
+
+    BackgroundPool::~BackgroundPool()
+    {}
+
+    void
+    BackgroundPool::submit(std::shared_ptr<Job> job)
+    {
+      this->submit(Jobs{std::move(job)});
+    }
+
+    void
+    BackgroundPool::_done(std::shared_ptr<Job> job)
+    {
+      bool post = false;
+      {
+        std::unique_lock<std::mutex> lock(this->_completed_mutex);
+        post = this->_completed.empty();
+        this->_completed.emplace_back(std::move(job));
+      }
+      // Jobs done until the scheduler gets to it are completed at once.
+      if (post)
+        this->_service.post([this] { this->_complete(); });
+    }
+
+    void
+    BackgroundPool::_complete()
+    {
+      auto jobs = Jobs{};
+      {
+        std::unique_lock<std::mutex> lock(this->_completed_mutex);
+        std::swap(jobs, this->_completed);
+      }
+      for (auto it = jobs.begin(); it != jobs.end(); ++it)
+        try
+        {
+          (*it)->complete();
+        }
+        catch (...)
+        {
+          // Let the scheduler handle the exception, complete the others
+          // later.
+          std::unique_lock<std::mutex> lock(this->_completed_mutex);
+          if (this->_completed.empty() && it + 1 != jobs.end())
+            this->_service.post([this] { this->_complete(); });
+          this->_completed.insert(this->_completed.begin(), it + 1, jobs.end());
+          throw;
+        }
+    }
+
+    /*--------------.
+    | Blocking pool |
+    `--------------*/
+
+    BlockingPool::BlockingPool(boost::asio::io_service& service)
+      : BackgroundPool(service)
+      , _max_threads(std::max(
+                       elle::os::getenv("ELLE_REACTOR_BLOCKING_THREADS", 64),
+                       1))
+      , _idle_timeout(boost::posix_time::seconds(
+                        elle::os::getenv("ELLE_REACTOR_BLOCKING_IDLE", 60)))
+      , _busy(0)
+      , _jobs(0)
+      , _stop(false)
+    {}
+
+    BlockingPool::~BlockingPool()
+    {
+      this->stop();
+    }
+
+    void
+    BlockingPool::submit(Jobs jobs)
+    {
+      auto const now = Clock::now();
+      std::unique_lock<std::mutex> lock(this->_mutex);
+      this->_join_reaped(lock);
+      for (auto& job: jobs)
+      {
+        job->_submitted = now;
+        this->_queue.emplace_back(std::move(job));
+      }
+      this->_busy += jobs.size();
+      // Threads reaped meanwhile are not joined yet.
+      auto live = this->_threads.size() - this->_reaped.size();
+      for (; this->_busy > live && live < this->_max_threads; ++live)
+      {
+        ELLE_DEBUG("%s: spawn thread %s", this, live + 1);
+        this->_threads.emplace_back([this] { this->_work(); });
+      }
+      if (jobs.size() == 1)
+        this->_available.notify_one();
+      else
+        this->_available.notify_all();
+    }
+
+    void
+    BlockingPool::_work()
+    {
+      auto const idle = std::chrono::microseconds(
+        this->_idle_timeout.total_microseconds());
+      std::unique_lock<std::mutex> lock(this->_mutex);
+      while (true)
+      {
+        if (!this->_available.wait_for(
+              lock, idle,
+              [this] { return !this->_queue.empty() || this->_stop; }))
+        {
+          ELLE_DEBUG("%s: reap idle thread", this);
+          this->_reaped.emplace_back(std::this_thread::get_id());
+          return;
+        }
+        if (this->_queue.empty())
+          return;
+        auto job = std::move(this->_queue.front());
+        this->_queue.pop_front();
+        this->_wait.record(Clock::now() - job->_submitted);
+        ++this->_jobs;
+        lock.unlock();
+        job->run();
+        lock.lock();
+        // Free the thread before the job completes, so that a job submitted
+        // upon completion reuses it.
+        --this->_busy;
+        lock.unlock();
+        this->_done(std::move(job));
+        lock.lock();
+      }
+    }
+
+    void
+    BlockingPool::_join_reaped(std::unique_lock<std::mutex>& lock)
+    {
+      if (this->_reaped.empty())
+        return;
+      auto reaped = std::list<std::thread>{};
+      for (auto id: this->_reaped)
+      {
+        auto it = std::find_if(
+          this->_threads.begin(), this->_threads.end(),
+          [id] (std::thread const& t) { return t.get_id() == id; });
+        reaped.splice(reaped.end(), this->_threads, it);
+      }
+      this->_reaped.clear();
+      lock.unlock();
+      for (auto& t: reaped)
+        t.join();
+      lock.lock();
+    }
+
+    void
+    BlockingPool::stop()
+    {
+      auto threads = std::list<std::thread>{};
+      {
+        std::unique_lock<std::mutex> lock(this->_mutex);
+        this->_stop = true;
+        this->_available.notify_all();
+        std::swap(threads, this->_threads);
+        this->_reaped.clear();
+      }
+      for (auto& t: threads)
+        t.join();
+      std::unique_lock<std::mutex> lock(this->_mutex);
+      this->_stop = false;
+    }
+
+    BackgroundPool::Statistics
+    BlockingPool::statistics() const
+    {
+      std::unique_lock<std::mutex> lock(this->_mutex);
+      return Statistics{
+        this->_threads.size() - this->_reaped.size(),
+        this->_queue.size(),
+        this->_jobs,
+        this->_wait,
+      };
+    }
+
+    std::size_t
+    BlockingPool::size() const
+    {
+      std::unique_lock<std::mutex> lock(this->_mutex);
+      return this->_threads.size() - this->_reaped.size();
+    }
+
+    /*-------------.
+    | Compute pool |
+    `-------------*/
+
+    ComputePool::Worker::Worker()
+      : jobs(0)
+    {}
+
+    ComputePool::ComputePool(boost::asio::io_service& service)
+      : BackgroundPool(service)
+      , _size(std::max(
+                elle::os::getenv(
+                  "ELLE_REACTOR_COMPUTE_THREADS",
+                  int(std::thread::hardware_concurrency())),
+                1))
+      , _next(0)
+      , _queued(0)
+      , _stop(false)
+    {}
+
+    ComputePool::~ComputePool()
+    {
+      this->stop();
+    }
+
+    void
+    ComputePool::submit(Jobs jobs)
+    {
+      if (this->_workers.empty())
+      {
+        ELLE_TRACE("%s: start %s threads", this, this->_size);
+        for (std::size_t i = 0; i < this->_size; ++i)
+          this->_workers.emplace_back(std::make_unique<Worker>());
+        for (std::size_t i = 0; i < this->_size; ++i)
+          this->_workers[i]->thread = std::thread([this, i] { this->_work(i); });
+      }
+      auto const now = Clock::now();
+      // Count jobs first, so workers never see more jobs than counted.
+      this->_queued += jobs.size();
+      // Spread jobs round robin, idle threads steal the rest.
+      for (auto& job: jobs)
+      {
+        job->_submitted = now;
+        auto& worker = *this->_workers[this->_next++ % this->_size];
+        std::unique_lock<std::mutex> lock(worker.mutex);
+        worker.queue.emplace_back(std::move(job));
+      }
+      std::unique_lock<std::mutex> lock(this->_mutex);
+      if (jobs.size() == 1)
+        this->_available.notify_one();
+      else
+        this->_available.notify_all();
+    }
+
+    std::shared_ptr<BackgroundPool::Job>
+    ComputePool::_pop(std::size_t index)
+    {
+      auto const size = this->_workers.size();
+      // Own jobs first, in order, then steal the newest of the others.
+      for (std::size_t i = 0; i < size; ++i)
+      {
+        auto& victim = *this->_workers[(index + i) % size];
+        std::unique_lock<std::mutex> lock(victim.mutex);
+        if (victim.queue.empty())
+          continue;
+        auto job = std::shared_ptr<Job>{};
+        if (i == 0)
+        {
+          job = std::move(victim.queue.front());
+          victim.queue.pop_front();
+        }
+        else
+        {
+          job = std::move(victim.queue.back());
+          victim.queue.pop_back();
+        }
+        --this->_queued;
+        return job;
+      }
+      return nullptr;
+    }
+
+    void
+    ComputePool::_work(std::size_t index)
+    {
+      auto& self = *this->_workers[index];
+      while (true)
+      {
+        if (auto job = this->_pop(index))
+        {
+          {
+            std::unique_lock<std::mutex> lock(self.mutex);
+            self.wait.record(Clock::now() - job->_submitted);
+            ++self.jobs;
+          }
+          job->run();
+          this->_done(std::move(job));
+          continue;
+        }
+        std::unique_lock<std::mutex> lock(this->_mutex);
+        this->_available.wait(
+          lock, [this] { return this->_queued > 0 || this->_stop; });
+        if (this->_stop && this->_queued == 0)
+          return;
+      }
+    }
+
+    void
+    ComputePool::stop()
+    {
+      {
+        std::unique_lock<std::mutex> lock(this->_mutex);
+        this->_stop = true;
+        this->_available.notify_all();
+      }
+      for (auto& w: this->_workers)
+        w->thread.join();
+      this->_workers.clear();
+      this->_stop = false;
+    }
+
+    BackgroundPool::Statistics
+    ComputePool::statistics() const
+    {
+      auto res = Statistics{this->_workers.size(), this->_queued, 0, {}};
+      for (auto& w: this->_workers)
+      {
+        std::unique_lock<std::mutex> lock(w->mutex);
+        res.jobs += w->jobs;
+        res.wait.merge(w->wait);
+      }
+      return res;
+    }
+  }
+}
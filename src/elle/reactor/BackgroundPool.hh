@@ -0,0 +1,200 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <elle/attribute.hh>
+#include <elle/reactor/Latency.hh>
+#include <elle/reactor/asio.hh>
+#include <elle/reactor/duration.hh>
+
+namespace elle
+{
+  namespace reactor
+  {
+    /// What a background job spends its time on, to pick the pool it runs
+    /// on.
+    enum class Background
+    {
+      /// Blocking system calls: name resolution, file I/O, ...
+      blocking,
+      /// Computations: cryptography, compression, ...
+      compute,
+    };
+
+    /// System threads running jobs on behalf of a Scheduler.
+    ///
+    /// Jobs run in a pool thread, then complete in the Scheduler. Jobs done
+    /// meanwhile are completed together, by a single asio handler.
+    ///
+    /// Pools are only submitted to from their Scheduler.
+    class BackgroundPool
+    {
+    /*------.
+    | Types |
+    `------*/
+    public:
+      /// Something to run in the background.
+      class Job
+      {
+      public:
+        virtual
+        ~Job();
+        /// Run in a pool thread.
+        virtual
+        void
+        run() noexcept = 0;
+        /// Run in the Scheduler once run returned.
+        virtual
+        void
+        complete() = 0;
+      private:
+        friend class BackgroundPool;
+        friend class BlockingPool;
+        friend class ComputePool;
+        ELLE_ATTRIBUTE(std::chrono::steady_clock::time_point, submitted);
+      };
+      using Jobs = std::vector<std::shared_ptr<Job>>;
+      struct Statistics
+      {
+        /// Running system threads.
+        std::size_t threads;
+        /// Jobs waiting for a thread.
+        std::size_t queued;
+        /// Jobs run so far.
+        std::size_t jobs;
+        /// Delays between jobs submission and start.
+        Latency wait;
+      };
+
+    /*-------------.
+    | Construction |
+    `-------------*/
+    public:
+      /// A pool completing jobs through @a service.
+      BackgroundPool(boost::asio::io_service& service);
+      BackgroundPool(BackgroundPool const&) = delete;
+      virtual
+      ~BackgroundPool();
+
+    /*-----.
+    | Jobs |
+    `-----*/
+    public:
+      void
+      submit(std::shared_ptr<Job> job);
+      /// Submit several jobs at once.
+      virtual
+      void
+      submit(Jobs jobs) = 0;
+      /// Run queued jobs and join threads.
+      virtual
+      void
+      stop() = 0;
+      virtual
+      Statistics
+      statistics() const = 0;
+    protected:
+      /// Hand @a job over for completion once it ran.
+      void
+      _done(std::shared_ptr<Job> job);
+    private:
+      void
+      _complete();
+      ELLE_ATTRIBUTE(boost::asio::io_service&, service);
+      ELLE_ATTRIBUTE(std::mutex, completed_mutex);
+      ELLE_ATTRIBUTE(Jobs, completed);
+    };
+
+    /// A pool for blocking calls.
+    ///
+    /// A thread is spawned whenever all are busy, up to
+    /// ELLE_REACTOR_BLOCKING_THREADS, 64 by default. Threads idle for
+    /// ELLE_REACTOR_BLOCKING_IDLE seconds, 60 by default, exit.
+    class BlockingPool
+      : public BackgroundPool
+    {
+    public:
+      BlockingPool(boost::asio::io_service& service);
+      ~BlockingPool();
+      using BackgroundPool::submit;
+      void
+      submit(Jobs jobs) override;
+      void
+      stop() override;
+      Statistics
+      statistics() const override;
+      /// Running threads.
+      std::size_t
+      size() const;
+      ELLE_ATTRIBUTE_R(std::size_t, max_threads);
+      ELLE_ATTRIBUTE_R(Duration, idle_timeout);
+    private:
+      void
+      _work();
+      /// Join threads that exited, with the mutex held.
+      void
+      _join_reaped(std::unique_lock<std::mutex>& lock);
+      ELLE_ATTRIBUTE(mutable std::mutex, mutex);
+      ELLE_ATTRIBUTE(std::condition_variable, available);
+      ELLE_ATTRIBUTE(std::deque<std::shared_ptr<Job>>, queue);
+      ELLE_ATTRIBUTE(std::list<std::thread>, threads);
+      ELLE_ATTRIBUTE(std::vector<std::thread::id>, reaped);
+      /// Jobs queued or running.
+      ELLE_ATTRIBUTE(std::size_t, busy);
+      ELLE_ATTRIBUTE(std::size_t, jobs);
+      ELLE_ATTRIBUTE(Latency, wait);
+      ELLE_ATTRIBUTE(bool, stop);
+    };
+
+    /// A pool for computations.
+    ///
+    /// Runs ELLE_REACTOR_COMPUTE_THREADS threads, one per core by default,
+    /// started upon first submission. Jobs are spread over per thread queues;
+    /// threads that run out of jobs steal from the others.
+    class ComputePool
+      : public BackgroundPool
+    {
+    public:
+      ComputePool(boost::asio::io_service& service);
+      ~ComputePool();
+      using BackgroundPool::submit;
+      void
+      submit(Jobs jobs) override;
+      void
+      stop() override;
+      Statistics
+      statistics() const override;
+      ELLE_ATTRIBUTE_R(std::size_t, size);
+    private:
+      struct Worker
+      {
+        Worker();
+        mutable std::mutex mutex;
+        std::deque<std::shared_ptr<Job>> queue;
+        std::size_t jobs;
+        Latency wait;
+        std::thread thread;
+      };
+      void
+      _work(std::size_t index);
+      /// A job from the queue of worker @a index, or stolen from another.
+      std::shared_ptr<Job>
+      _pop(std::size_t index);
+      ELLE_ATTRIBUTE(std::vector<std::unique_ptr<Worker>>, workers);
+      ELLE_ATTRIBUTE(std::size_t, next);
+      ELLE_ATTRIBUTE(std::atomic<std::size_t>, queued);
+      ELLE_ATTRIBUTE(std::mutex, mutex);
+      ELLE_ATTRIBUTE(std::condition_variable, available);
+      ELLE_ATTRIBUTE(bool, stop);
+    };
+  }
+}
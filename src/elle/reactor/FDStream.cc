@@ -1,3 +1,6 @@
+#include <cerrno>
+#include <cstring>
+
 #include <elle/assert.hh>
 #include <elle/Buffer.hh>
 #include <elle/reactor/FDStream.hh>
@@ -16,6 +19,20 @@ namespace elle
     elle::PlainStreamBuffer::Size
     FDStream::StreamBuffer::read(char* buffer, elle::PlainStreamBuffer::Size size)
     {
+#ifdef ELLE_LINUX
+      // Unlike epoll, io_uring supports regular files.
+      if (auto ring = reactor::scheduler().io_uring())
+      {
+        auto const res = ring->pread(this->_handle, buffer, size, -1);
+        if (res >= 0)
+          return res;
+        // Non-blocking descriptors are not waited for, let asio poll them.
+        else if (errno != EAGAIN)
+          throw elle::Error(
+            elle::sprintf("unable to read from %s: %s",
+                          this->_handle, std::strerror(errno)));
+      }
+#endif
       Buffer::Size read = 0;
       boost::system::error_code error;
       reactor::Barrier done("read done");
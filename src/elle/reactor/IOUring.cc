@@ -0,0 +1,384 @@
+#include <elle/reactor/IOUring.hh>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <elle/With.hh>
+#include <elle/assert.hh>
+#include <elle/err.hh>
+#include <elle/finally.hh>
+#include <elle/log.hh>
+#include <elle/reactor/Barrier.hh>
+#include <elle/reactor/Thread.hh>
+#include <elle/reactor/scheduler.hh>
+
+ELLE_LOG_COMPONENT("elle.reactor.IOUring");
+
+namespace elle
+{
+  namespace reactor
+  {
+    namespace
+    {
+      int
+      io_uring_setup(unsigned entries, io_uring_params* params)
+      {
+        return ::syscall(__NR_io_uring_setup, entries, params);
+      }
+
+      int
+      io_uring_enter(int fd, unsigned submit, unsigned complete, unsigned flags)
+      {
+        return ::syscall(
+          __NR_io_uring_enter, fd, submit, complete, flags, nullptr, 0);
+      }
+
+      int
+      io_uring_register(int fd, unsigned opcode, void* arg, unsigned count)
+      {
+        return ::syscall(__NR_io_uring_register, fd, opcode, arg, count);
+      }
+
+      template <typename T>
+      T*
+      at(void* base, std::uint32_t offset)
+      {
+        return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+      }
+
+      /// An operation waited for by a Thread.
+      struct Pending
+      {
+        Pending()
+          : done("io_uring operation")
+          , result(0)
+        {}
+
+        Barrier done;
+        int result;
+      };
+    }
+
+    /*-----.
+    | Impl |
+    `-----*/
+
+    class IOUring::Impl
+    {
+    public:
+      Impl(boost::asio::io_service& service, unsigned entries)
+        : _fd(-1)
+        , _event(-1)
+        , _events(service)
+        , _event_count(0)
+        , _polling(false)
+        , _ring(MAP_FAILED)
+        , _ring_size(0)
+        , _sqes(static_cast<io_uring_sqe*>(MAP_FAILED))
+        , _sqes_size(0)
+        , _queued(0)
+        , _inflight(0)
+        , _statistics{0, 0, 0}
+      {
+        elle::SafeFinally cleanup([this] { this->_release(); });
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        this->_fd = io_uring_setup(entries, &params);
+        if (this->_fd < 0)
+          elle::err("unable to set up io_uring: %s", std::strerror(errno));
+        // Keep the mapping simple, and read at the current position.
+        auto const features = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_RW_CUR_POS;
+        if ((params.features & features) != features)
+          elle::err("io_uring is too old: features %x", params.features);
+        this->_ring_size = std::max(
+          params.sq_off.array + params.sq_entries * sizeof(std::uint32_t),
+          params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+        this->_ring = ::mmap(nullptr, this->_ring_size,
+                             PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                             this->_fd, IORING_OFF_SQ_RING);
+        if (this->_ring == MAP_FAILED)
+          elle::err("unable to map io_uring: %s", std::strerror(errno));
+        this->_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        this->_sqes = static_cast<io_uring_sqe*>(
+          ::mmap(nullptr, this->_sqes_size,
+                 PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                 this->_fd, IORING_OFF_SQES));
+        if (this->_sqes == MAP_FAILED)
+          elle::err("unable to map io_uring entries: %s", std::strerror(errno));
+        this->_sq_head = at<unsigned>(this->_ring, params.sq_off.head);
+        this->_sq_tail = at<unsigned>(this->_ring, params.sq_off.tail);
+        this->_sq_mask = *at<unsigned>(this->_ring, params.sq_off.ring_mask);
+        this->_sq_entries = params.sq_entries;
+        this->_sq_array = at<unsigned>(this->_ring, params.sq_off.array);
+        this->_cq_head = at<unsigned>(this->_ring, params.cq_off.head);
+        this->_cq_tail = at<unsigned>(this->_ring, params.cq_off.tail);
+        this->_cq_mask = *at<unsigned>(this->_ring, params.cq_off.ring_mask);
+        this->_cqes = at<io_uring_cqe>(this->_ring, params.cq_off.cqes);
+        this->_event = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (this->_event < 0)
+          elle::err("unable to create eventfd: %s", std::strerror(errno));
+        if (io_uring_register(
+              this->_fd, IORING_REGISTER_EVENTFD, &this->_event, 1) < 0)
+          elle::err("unable to register io_uring eventfd: %s",
+                    std::strerror(errno));
+        this->_events.assign(this->_event);
+        cleanup.abort();
+        ELLE_TRACE("%s: created with %s entries", this, params.sq_entries);
+      }
+
+      ~Impl()
+      {
+        ELLE_ASSERT_EQ(this->_inflight, 0u);
+        this->_release();
+      }
+
+      template <typename Prepare>
+      int
+      run(Prepare prepare)
+      {
+        Pending op;
+        auto& sqe = this->_sqe();
+        prepare(sqe);
+        sqe.user_data = reinterpret_cast<std::uint64_t>(&op);
+        this->_push();
+        try
+        {
+          reactor::wait(op.done);
+        }
+        catch (...)
+        {
+          ELLE_TRACE("%s: cancel %s", this, &op);
+          // The kernel may access the buffer until the operation completes.
+          // Acquiring an entry may wait for room in the submission queue:
+          // it must not be interrupted either.
+          elle::With<Thread::NonInterruptible>() << [&]
+          {
+            auto& cancel = this->_sqe();
+            cancel.opcode = IORING_OP_ASYNC_CANCEL;
+            cancel.addr = reinterpret_cast<std::uint64_t>(&op);
+            this->_push();
+            reactor::wait(op.done);
+          };
+          throw;
+        }
+        if (op.result < 0)
+        {
+          errno = -op.result;
+          return -1;
+        }
+        return op.result;
+      }
+
+      void
+      submit()
+      {
+        if (this->_queued == 0)
+          return;
+        ELLE_DEBUG("%s: submit %s operations", this, this->_queued);
+        ++this->_statistics.submissions;
+        auto const res = io_uring_enter(this->_fd, this->_queued, 0, 0);
+        if (res < 0)
+        {
+          // Try again on the next round.
+          if (errno != EAGAIN && errno != EBUSY && errno != EINTR)
+            ELLE_ERR("%s: unable to submit: %s", this, std::strerror(errno));
+          return;
+        }
+        this->_queued -= res;
+        // Operations served from cache complete right away.
+        this->_reap();
+      }
+
+      /// The next submission queue entry, cleared.
+      io_uring_sqe&
+      _sqe()
+      {
+        auto full = [this]
+          {
+            return *this->_sq_tail -
+              __atomic_load_n(this->_sq_head, __ATOMIC_ACQUIRE) >=
+              this->_sq_entries;
+          };
+        while (full())
+        {
+          this->submit();
+          if (full())
+            reactor::yield();
+        }
+        auto& res = this->_sqes[*this->_sq_tail & this->_sq_mask];
+        std::memset(&res, 0, sizeof(res));
+        return res;
+      }
+
+      /// Queue the entry returned by _sqe.
+      void
+      _push()
+      {
+        auto const tail = *this->_sq_tail;
+        this->_sq_array[tail & this->_sq_mask] = tail & this->_sq_mask;
+        __atomic_store_n(this->_sq_tail, tail + 1, __ATOMIC_RELEASE);
+        ++this->_queued;
+        ++this->_inflight;
+        ++this->_statistics.operations;
+        this->_poll();
+      }
+
+      /// Wait for completions while operations are in flight, so the
+      /// io_service is not kept busy otherwise.
+      void
+      _poll()
+      {
+        if (this->_polling || this->_inflight == 0)
+          return;
+        this->_polling = true;
+        this->_events.async_read_some(
+          boost::asio::buffer(&this->_event_count, sizeof(this->_event_count)),
+          [this] (boost::system::error_code const& error, std::size_t)
+          {
+            if (error == boost::asio::error::operation_aborted)
+              return;
+            this->_polling = false;
+            this->_reap();
+            this->_poll();
+          });
+      }
+
+      void
+      _reap()
+      {
+        auto head = *this->_cq_head;
+        auto const tail = __atomic_load_n(this->_cq_tail, __ATOMIC_ACQUIRE);
+        for (; head != tail; ++head)
+        {
+          auto const& cqe = this->_cqes[head & this->_cq_mask];
+          // Cancellations have no operation.
+          if (auto op = reinterpret_cast<Pending*>(cqe.user_data))
+          {
+            op->result = cqe.res;
+            op->done.open();
+          }
+          --this->_inflight;
+          ++this->_statistics.completions;
+        }
+        __atomic_store_n(this->_cq_head, head, __ATOMIC_RELEASE);
+      }
+
+      void
+      _release()
+      {
+        boost::system::error_code erc;
+        this->_events.close(erc);
+        if (this->_event >= 0)
+          ::close(this->_event);
+        if (this->_sqes != MAP_FAILED)
+          ::munmap(this->_sqes, this->_sqes_size);
+        if (this->_ring != MAP_FAILED)
+          ::munmap(this->_ring, this->_ring_size);
+        if (this->_fd >= 0)
+          ::close(this->_fd);
+      }
+
+      ELLE_ATTRIBUTE(int, fd);
+      ELLE_ATTRIBUTE(int, event);
+      ELLE_ATTRIBUTE(boost::asio::posix::stream_descriptor, events);
+      ELLE_ATTRIBUTE(std::uint64_t, event_count);
+      ELLE_ATTRIBUTE(bool, polling);
+      ELLE_ATTRIBUTE(void*, ring);
+      ELLE_ATTRIBUTE(std::size_t, ring_size);
+      ELLE_ATTRIBUTE(io_uring_sqe*, sqes);
+      ELLE_ATTRIBUTE(std::size_t, sqes_size);
+      ELLE_ATTRIBUTE(unsigned*, sq_head);
+      ELLE_ATTRIBUTE(unsigned*, sq_tail);
+      ELLE_ATTRIBUTE(unsigned, sq_mask);
+      ELLE_ATTRIBUTE(unsigned, sq_entries);
+      ELLE_ATTRIBUTE(unsigned*, sq_array);
+      ELLE_ATTRIBUTE(unsigned*, cq_head);
+      ELLE_ATTRIBUTE(unsigned*, cq_tail);
+      ELLE_ATTRIBUTE(unsigned, cq_mask);
+      ELLE_ATTRIBUTE(io_uring_cqe*, cqes);
+      /// Entries pushed but not submitted yet.
+      ELLE_ATTRIBUTE(unsigned, queued);
+      ELLE_ATTRIBUTE(unsigned, inflight);
+    public:
+      ELLE_ATTRIBUTE_R(Statistics, statistics);
+    };
+
+    /*-------------.
+    | Construction |
+    `-------------*/
+
+    IOUring::IOUring(boost::asio::io_service& service, unsigned entries)
+      : _impl(std::make_unique<Impl>(service, entries))
+    {}
+
+    IOUring::~IOUring() = default;
+
+    /*-----------.
+    | Operations |
+    `-----------*/
+
+    ssize_t
+    IOUring::pread(int fd, void* data, std::size_t size, off_t offset)
+    {
+      ELLE_DEBUG("%s: read %s bytes from %s at %s", this, size, fd, offset);
+      return this->_impl->run(
+        [&] (io_uring_sqe& sqe)
+        {
+          sqe.opcode = IORING_OP_READ;
+          sqe.fd = fd;
+          sqe.addr = reinterpret_cast<std::uint64_t>(data);
+          sqe.len = size;
+          sqe.off = offset;
+        });
+    }
+
+    ssize_t
+    IOUring::pwrite(int fd, void const* data, std::size_t size, off_t offset)
+    {
+      ELLE_DEBUG("%s: write %s bytes to %s at %s", this, size, fd, offset);
+      return this->_impl->run(
+        [&] (io_uring_sqe& sqe)
+        {
+          sqe.opcode = IORING_OP_WRITE;
+          sqe.fd = fd;
+          sqe.addr = reinterpret_cast<std::uint64_t>(data);
+          sqe.len = size;
+          sqe.off = offset;
+        });
+    }
+
+    int
+    IOUring::fsync(int fd, bool datasync)
+    {
+      ELLE_DEBUG("%s: sync %s", this, fd);
+      return this->_impl->run(
+        [&] (io_uring_sqe& sqe)
+        {
+          sqe.opcode = IORING_OP_FSYNC;
+          sqe.fd = fd;
+          if (datasync)
+            sqe.fsync_flags = IORING_FSYNC_DATASYNC;
+        });
+    }
+
+    void
+    IOUring::submit()
+    {
+      this->_impl->submit();
+    }
+
+    IOUring::Statistics
+    IOUring::statistics() const
+    {
+      return this->_impl->statistics();
+    }
+  }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include <sys/types.h>
+
+#include <elle/attribute.hh>
+#include <elle/reactor/asio.hh>
+
+namespace elle
+{
+  namespace reactor
+  {
+    /// Asynchronous file descriptor I/O through a Linux io_uring.
+    ///
+    /// Schedulers own a ring if the kernel supports it, see
+    /// Scheduler::io_uring. Threads queue operations that are submitted all at
+    /// once at the end of the scheduler round, with a single io_uring_enter.
+    /// Completions are signaled through an eventfd polled by the scheduler
+    /// io_service. Unlike readiness based asio descriptors, regular file reads
+    /// and writes are then asynchronous without resorting to a system thread.
+    ///
+    /// Operations mirror their POSIX counterparts: they return -1 and set
+    /// errno on error. The calling Thread waits for the completion. If it is
+    /// terminated meanwhile, the operation is canceled and waited for: the
+    /// kernel may still access the buffer until then.
+    ///
+    /// The ring is not thread safe: use it from its Scheduler only.
+    class IOUring
+    {
+    public:
+      struct Statistics
+      {
+        /// Operations queued.
+        std::size_t operations;
+        /// io_uring_enter calls.
+        std::size_t submissions;
+        /// Completions reaped.
+        std::size_t completions;
+      };
+
+    /*-------------.
+    | Construction |
+    `-------------*/
+    public:
+      /// Create a ring.
+      ///
+      /// @param service The io_service polling completions.
+      /// @param entries The submission queue size.
+      /// @throw elle::Error if io_uring is unavailable.
+      IOUring(boost::asio::io_service& service, unsigned entries = 256);
+      IOUring(IOUring const&) = delete;
+      ~IOUring();
+
+    /*-----------.
+    | Operations |
+    `-----------*/
+    public:
+      /// Read at @a offset, or from the current position if it is -1.
+      ssize_t
+      pread(int fd, void* data, std::size_t size, off_t offset);
+      /// Write at @a offset, or at the current position if it is -1.
+      ssize_t
+      pwrite(int fd, void const* data, std::size_t size, off_t offset);
+      int
+      fsync(int fd, bool datasync = false);
+      /// Submit queued operations.
+      ///
+      /// Called by the Scheduler after every round.
+      void
+      submit();
+      Statistics
+      statistics() const;
+    private:
+      class Impl;
+      ELLE_ATTRIBUTE(std::unique_ptr<Impl>, impl);
+    };
+  }
+}
@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <cmath>
+
+#include <elle/reactor/Latency.hh>
+
+namespace elle
+{
+  namespace reactor
+  {
+    namespace
+    {
+      // Delays below 4ns have their own bucket. Others fall in one of the
+      // four buckets splitting the power of two below them.
+      int
+      _bucket(std::uint64_t delay)
+      {
+        if (delay < 4)
+          return int(delay);
+        int const e = 63 - __builtin_clzll(delay);
+        return 4 * (e - 1) + int((delay >> (e - 2)) & 3);
+      }
+
+      std::uint64_t
+      _bucket_bound(int bucket)
+      {
+        if (bucket < 4)
+          return bucket;
+        int const e = bucket / 4 + 1;
+        return (std::uint64_t(5 + bucket % 4) << (e - 2)) - 1;
+      }
+    }
+
+    Latency::Latency()
+      : _maximum(0)
+      , _buckets()
+    {}
+
+    void
+    Latency::record(std::chrono::nanoseconds delay)
+    {
+      auto const ns = std::max<std::int64_t>(delay.count(), 0);
+      ++this->_buckets[_bucket(ns)];
+      if (delay > this->_maximum)
+        this->_maximum = delay;
+    }
+
+    void
+    Latency::merge(Latency const& other)
+    {
+      for (int i = 0; i < int(this->_buckets.size()); ++i)
+        this->_buckets[i] += other._buckets[i];
+      this->_maximum = std::max(this->_maximum, other._maximum);
+    }
+
+    void
+    Latency::reset()
+    {
+      this->_buckets.fill(0);
+      this->_maximum = std::chrono::nanoseconds(0);
+    }
+
+    std::size_t
+    Latency::count() const
+    {
+      std::size_t res = 0;
+      for (auto n: this->_buckets)
+        res += n;
+      return res;
+    }
+
+    std::chrono::nanoseconds
+    Latency::percentile(double quantile) const
+    {
+      auto const target =
+        std::max<std::uint64_t>(std::ceil(quantile * this->count()), 1);
+      std::uint64_t seen = 0;
+      for (int i = 0; i < int(this->_buckets.size()); ++i)
+        if ((seen += this->_buckets[i]) >= target)
+          return std::min(std::chrono::nanoseconds(_bucket_bound(i)),
+                          this->_maximum);
+      return this->_maximum;
+    }
+  }
+}
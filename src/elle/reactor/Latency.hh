@@ -0,0 +1,45 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <elle/attribute.hh>
+
+namespace elle
+{
+  namespace reactor
+  {
+    /// A histogram of delays, to follow their quantiles.
+    ///
+    /// Buckets split every power of two nanoseconds in four, so quantiles
+    /// are within 25% of the exact value. Recording is constant time and
+    /// allocation free.
+    ///
+    /// Not thread safe.
+    class Latency
+    {
+    public:
+      Latency();
+      void
+      record(std::chrono::nanoseconds delay);
+      /// Add the delays recorded by @a other.
+      void
+      merge(Latency const& other);
+      /// Forget recorded delays.
+      void
+      reset();
+      /// Number of recorded delays.
+      std::size_t
+      count() const;
+      /// Upper bound of the @a quantile, between 0 and 1.
+      std::chrono::nanoseconds
+      percentile(double quantile) const;
+      /// The longest recorded delay.
+      ELLE_ATTRIBUTE_R(std::chrono::nanoseconds, maximum);
+    private:
+      ELLE_ATTRIBUTE((std::array<std::uint64_t, 256>), buckets);
+    };
+  }
+}
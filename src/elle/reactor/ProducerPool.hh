@@ -0,0 +1,139 @@
+#pragma once
+
+#include <deque>
+#include <exception>
+#include <functional>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include <elle/Printable.hh>
+#include <elle/attribute.hh>
+#include <elle/optional.hh>
+
+#include <elle/reactor/Barrier.hh>
+#include <elle/reactor/Thread.hh>
+
+namespace elle
+{
+  namespace reactor
+  {
+    /// A pool of precomputed values, refilled in the background.
+    ///
+    /// Unlike elle::ProducerPool, fetching a value never blocks the OS thread:
+    /// if the pool is empty the calling reactor::Thread waits while other
+    /// coroutines keep running. Values are produced on the compute
+    /// reactor::background pool by a set of refilling threads, which wake up
+    /// whenever the pool size falls under the low watermark and produce
+    /// until the high watermark is reached.
+    ///
+    /// Typical use is to keep a stock of freshly generated keys:
+    ///
+    /// @code{.cc}
+    ///
+    /// reactor::ProducerPool<rsa::KeyPair> keys(
+    ///   "rsa keys", [] { return rsa::keypair::generate(2048); }, 4, 16);
+    /// keys.load(path); // Restore the pool saved on the previous run.
+    /// auto k = keys.get();
+    /// ...
+    /// keys.save(path);
+    ///
+    /// @endcode
+    ///
+    /// The same goes for DSA and DH keypairs or SecretKeys, given the
+    /// relevant generation function.
+    template <typename T>
+    class ProducerPool
+      : public elle::Printable
+    {
+    /*------.
+    | Types |
+    `------*/
+    public:
+      using Self = ProducerPool<T>;
+      using Produce = std::function<T ()>;
+
+    /*-------------.
+    | Construction |
+    `-------------*/
+    public:
+      /// Create a pool and start filling it.
+      ///
+      /// @param name A descriptive name, for debugging.
+      /// @param produce The production function, run in a system thread.
+      /// @param low Refill once fewer than this many values are pooled.
+      /// @param high Stop refilling once this many values are pooled.
+      /// @param workers The number of values produced in parallel.
+      ProducerPool(std::string name,
+                   Produce produce,
+                   int low,
+                   int high,
+                   int workers = 1);
+      /// Stop refilling and drop pooled values.
+      ~ProducerPool();
+
+    /*--------.
+    | Content |
+    `--------*/
+    public:
+      /// Get a value from the pool, waiting for one to be produced if needed.
+      ///
+      /// @throw The error the production function failed with, if any.
+      T
+      get();
+      /// Get a value from the pool if one is available, without yielding.
+      boost::optional<T>
+      try_get();
+      /// Add a value to the pool, e.g. one that is not needed anymore.
+      void
+      put(T value);
+      /// The number of pooled values.
+      int
+      size() const;
+    private:
+      void
+      _refill();
+      void
+      _check_low();
+      ELLE_ATTRIBUTE_R(std::string, name);
+      ELLE_ATTRIBUTE(Produce, produce);
+      ELLE_ATTRIBUTE_R(int, low);
+      ELLE_ATTRIBUTE_R(int, high);
+      ELLE_ATTRIBUTE(std::deque<T>, pool);
+      /// Number of values being produced right now.
+      ELLE_ATTRIBUTE(int, producing);
+      /// Why production failed, until a consumer gets it.
+      ELLE_ATTRIBUTE(std::exception_ptr, error);
+      /// Opened when values are available.
+      ELLE_ATTRIBUTE(Barrier, available);
+      /// Opened when the pool needs refilling.
+      ELLE_ATTRIBUTE(Barrier, starving);
+      ELLE_ATTRIBUTE(std::vector<Thread::unique_ptr>, workers);
+
+    /*------------.
+    | Persistence |
+    `------------*/
+    public:
+      /// Save pooled values to @a path, atomically.
+      ///
+      /// @pre T is serializable.
+      void
+      save(boost::filesystem::path const& path) const;
+      /// Add values saved to @a path to the pool, if it exists.
+      ///
+      /// @pre T is deserializable.
+      /// @returns The number of restored values.
+      int
+      load(boost::filesystem::path const& path);
+
+    /*----------.
+    | Printable |
+    `----------*/
+    public:
+      void
+      print(std::ostream& stream) const override;
+    };
+  }
+}
+
+#include <elle/reactor/ProducerPool.hxx>
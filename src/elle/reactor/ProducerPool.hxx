@@ -0,0 +1,217 @@
+#pragma once
+
+#include <elle/AtomicFile.hh>
+#include <elle/Exception.hh>
+#include <elle/With.hh>
+#include <elle/finally.hh>
+#include <elle/log.hh>
+#include <elle/print.hh>
+#include <elle/serialization/binary.hh>
+
+#include <elle/reactor/exception.hh>
+#include <elle/reactor/scheduler.hh>
+
+namespace elle
+{
+  namespace reactor
+  {
+    /*-------------.
+    | Construction |
+    `-------------*/
+
+    template <typename T>
+    ProducerPool<T>::ProducerPool(std::string name,
+                                  Produce produce,
+                                  int low,
+                                  int high,
+                                  int workers)
+      : _name(std::move(name))
+      , _produce(std::move(produce))
+      , _low(low)
+      , _high(high)
+      , _pool()
+      , _producing(0)
+      , _error()
+      , _available(elle::print("%s available", this->_name))
+      , _starving(elle::print("%s starving", this->_name))
+      , _workers()
+    {
+      ELLE_ASSERT_GTE(low, 0);
+      ELLE_ASSERT_GT(high, 0);
+      ELLE_ASSERT_LTE(low, high);
+      ELLE_ASSERT_GT(workers, 0);
+      this->_starving.open();
+      for (int i = 0; i < workers; ++i)
+        this->_workers.emplace_back(
+          new Thread(elle::print("%s refill %s", this->_name, i),
+                     [this] { this->_refill(); }));
+    }
+
+    template <typename T>
+    ProducerPool<T>::~ProducerPool()
+    {
+      // Terminate refilling threads before the pool they feed is destroyed.
+      this->_workers.clear();
+    }
+
+    /*--------.
+    | Content |
+    `--------*/
+
+    template <typename T>
+    T
+    ProducerPool<T>::get()
+    {
+      ELLE_LOG_COMPONENT("elle.reactor.ProducerPool");
+      while (this->_pool.empty())
+      {
+        if (this->_error)
+        {
+          ELLE_TRACE("%s: production failed", this);
+          auto error = std::move(this->_error);
+          this->_error = nullptr;
+          this->_available.close();
+          std::rethrow_exception(error);
+        }
+        ELLE_TRACE("%s: pool is empty, wait", this);
+        this->_starving.open();
+        reactor::wait(this->_available);
+      }
+      return *this->try_get();
+    }
+
+    template <typename T>
+    boost::optional<T>
+    ProducerPool<T>::try_get()
+    {
+      if (this->_pool.empty())
+      {
+        this->_starving.open();
+        return boost::none;
+      }
+      auto res = std::move(this->_pool.front());
+      this->_pool.pop_front();
+      if (this->_pool.empty())
+        this->_available.close();
+      this->_check_low();
+      return boost::optional<T>(std::move(res));
+    }
+
+    template <typename T>
+    void
+    ProducerPool<T>::put(T value)
+    {
+      this->_pool.emplace_back(std::move(value));
+      this->_available.open();
+    }
+
+    template <typename T>
+    int
+    ProducerPool<T>::size() const
+    {
+      return this->_pool.size();
+    }
+
+    template <typename T>
+    void
+    ProducerPool<T>::_check_low()
+    {
+      if (signed(this->_pool.size()) + this->_producing < this->_low)
+        this->_starving.open();
+    }
+
+    template <typename T>
+    void
+    ProducerPool<T>::_refill()
+    {
+      ELLE_LOG_COMPONENT("elle.reactor.ProducerPool");
+      while (true)
+      {
+        reactor::wait(this->_starving);
+        if (signed(this->_pool.size()) + this->_producing >= this->_high)
+        {
+          this->_starving.close();
+          continue;
+        }
+        ELLE_DEBUG("%s: produce value", this);
+        ++this->_producing;
+        // The system thread may outlive us if we are terminated: make it
+        // share ownership of everything it touches.
+        auto value = std::make_shared<boost::optional<T>>();
+        try
+        {
+          elle::SafeFinally done([&] { --this->_producing; });
+          reactor::background(
+            [value, produce = this->_produce] { value->emplace(produce()); },
+            Background::compute);
+        }
+        catch (reactor::Terminate const&)
+        {
+          throw;
+        }
+        catch (...)
+        {
+          // Hand the error to a consumer, and wait for one to retry.
+          ELLE_WARN("%s: production failed: %s",
+                    this, elle::exception_string());
+          this->_error = std::current_exception();
+          this->_starving.close();
+          this->_available.open();
+          continue;
+        }
+        this->put(std::move(value->get()));
+      }
+    }
+
+    /*------------.
+    | Persistence |
+    `------------*/
+
+    template <typename T>
+    void
+    ProducerPool<T>::save(boost::filesystem::path const& path) const
+    {
+      ELLE_LOG_COMPONENT("elle.reactor.ProducerPool");
+      ELLE_TRACE_SCOPE("%s: save to %s", this, path);
+      auto values = std::vector<T>(this->_pool.begin(), this->_pool.end());
+      elle::AtomicFile file(path);
+      file.write() << [&] (elle::AtomicFile::Write& write)
+      {
+        elle::serialization::binary::serialize(values, write.stream());
+      };
+    }
+
+    template <typename T>
+    int
+    ProducerPool<T>::load(boost::filesystem::path const& path)
+    {
+      ELLE_LOG_COMPONENT("elle.reactor.ProducerPool");
+      ELLE_TRACE_SCOPE("%s: load from %s", this, path);
+      elle::AtomicFile file(path);
+      if (!file.exists())
+        return 0;
+      auto values = std::vector<T>();
+      file.read() << [&] (elle::AtomicFile::Read& read)
+      {
+        values = elle::serialization::binary::deserialize<std::vector<T>>(
+          read.stream());
+      };
+      for (auto& v: values)
+        this->put(std::move(v));
+      ELLE_DEBUG("%s: restored %s values", this, values.size());
+      return values.size();
+    }
+
+    /*----------.
+    | Printable |
+    `----------*/
+
+    template <typename T>
+    void
+    ProducerPool<T>::print(std::ostream& stream) const
+    {
+      elle::print(stream, "ProducerPool(%s, %s/%s)",
+                  this->_name, this->_pool.size(), this->_high);
+    }
+  }
+}
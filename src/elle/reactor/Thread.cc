@@ -33,7 +33,8 @@ namespace elle
       , _exception()
       , _waited()
       , _timeout(false)
-      , _timeout_timer(scheduler.io_service())
+      , _timeout_waitables(nullptr)
+      , _timeout_timer([this] { this->_wait_timeout(); })
       , _thread(scheduler._manager->make_thread(
                   name,
                   [this, a=std::move(action)] ()
@@ -43,7 +44,13 @@ namespace elle
       , _scheduler(scheduler)
       , _terminating(false)
       , _interruptible(true)
+      , _priority(Priority::normal)
+      , _runnable(std::chrono::steady_clock::now())
     {
+      // Only read the current thread from its own system thread.
+      if (Scheduler::scheduler() == &scheduler)
+        if (auto current = scheduler.current())
+          this->_priority = current->_priority;
       _scheduler._thread_register(*this);
     }
 
@@ -81,16 +88,20 @@ namespace elle
                      this, this->state());
         this->terminate_now(false);
       }
-      this->_destructed();
+      if (this->_destructed)
+        (*this->_destructed)();
     }
 
     void
     Thread::_scheduler_release()
     {
       ELLE_DUMP("%s: scheduler_release, dispose=%s", *this, this->_dispose);
-      this->_released();
-      this->_released.disconnect_all_slots();
-      this->_released();
+      if (this->_released)
+      {
+        (*this->_released)();
+        this->_released->disconnect_all_slots();
+        (*this->_released)();
+      }
       if (this->_dispose)
         delete this;
       else if (this->_self)
@@ -111,8 +122,30 @@ namespace elle
     {
       if (this == reactor::scheduler().current())
         return elle::Backtrace::current();
+      else if (this->_yield_backtrace)
+        return *this->_yield_backtrace;
       else
-        return this->_yield_backtrace;
+        return elle::Backtrace();
+    }
+
+    /*---------.
+    | Tracking |
+    `---------*/
+
+    Thread::Tracker&
+    Thread::destructed()
+    {
+      if (!this->_destructed)
+        this->_destructed = std::make_unique<Tracker>();
+      return *this->_destructed;
+    }
+
+    Thread::Tracker&
+    Thread::released()
+    {
+      if (!this->_released)
+        this->_released = std::make_unique<Tracker>();
+      return *this->_released;
     }
 
     /*-------.
@@ -199,7 +232,7 @@ namespace elle
       {
         if (DBG)
           ELLE_ERR("%s: terminate exception was swallowed: %s",
-                   *this, this->_yield_backtrace);
+                   *this, this->backtrace());
         static bool reraise = elle::os::inenv("REACTOR_RE_RAISE_SWALLOWED_TERMINATE");
         if (reraise)
         {
@@ -223,7 +256,8 @@ namespace elle
       ELLE_TRACE("%s: yield", *this)
       {
         if (DBG)
-          this->_yield_backtrace = elle::Backtrace::current();
+          this->_yield_backtrace =
+            std::make_unique<elle::Backtrace>(elle::Backtrace::current());
         this->_thread->yield();
         ELLE_TRACE_SCOPE("%s: back from yield", *this);
         if (_injection)
@@ -254,7 +288,8 @@ namespace elle
             // FIXME: Only the latest backtrace will be stored, but this is still
             // better than the creation time backtrace, I suppose.
             static bool keep = elle::os::inenv("ELLE_KEEP_ORIGINAL_BACKTRACE");
-            if (!keep)
+            // Do not capture for exceptions that chose not to.
+            if (!keep && !e.backtrace().empty())
               e.backtrace(elle::Backtrace::current());
           }
           catch (...)
@@ -340,7 +375,8 @@ namespace elle
             // FIXME: Only the latest backtrace will be stored, but this is still
             // better than the creation time backtrace, I suppose.
             static bool keep = elle::os::getenv("ELLE_KEEP_ORIGINAL_BACKTRACE", false);
-            if (!keep)
+            // Do not capture for exceptions that chose not to.
+            if (!keep && !e.backtrace().empty())
               e.backtrace(elle::Backtrace::current());
             throw;
           }
@@ -349,20 +385,14 @@ namespace elle
       {
         if (timeout)
         {
-          this->_timeout_timer.expires_from_now(*timeout);
           this->_timeout = false;
-          auto repr = elle::sprintf("%s", waitables);
-          this->_timeout_timer.async_wait(
-            [this, repr]
-            (boost::system::error_code const& e)
-            {
-              this->_wait_timeout(e, repr);
-            });
+          this->_timeout_waitables = &waitables;
+          this->_scheduler.timer_wheel().arm(this->_timeout_timer, *timeout);
           auto cancel_timeout = [this]
             {
               ELLE_DUMP("%s: cancel timeout", *this);
-              if (!this->_timeout)
-                this->_timeout_timer.cancel();
+              this->_timeout_timer.cancel();
+              this->_timeout_waitables = nullptr;
             };
           return elle::With<elle::Finally>(cancel_timeout) << [&]
           {
@@ -404,7 +434,8 @@ namespace elle
 
     static
     std::ostream&
-    operator <<(std::ostream& output, std::set<Waitable*> waitables)
+    operator <<(std::ostream& output,
+                boost::container::flat_set<Waitable*> const& waitables)
     {
       if (waitables.size() == 1)
         output << **waitables.begin();
@@ -425,11 +456,8 @@ namespace elle
     }
 
     void
-    Thread::_wait_timeout(boost::system::error_code const& e,
-                          std::string const& waited)
+    Thread::_wait_timeout()
     {
-      if (e == boost::system::errc::operation_canceled)
-        return;
       // If we're not frozen anymore, the task must have ended in the same asio
       // poll than the timeout: Thread::_wake was just called. Ignore the timeout.
       if (state() != State::frozen)
@@ -441,7 +469,8 @@ namespace elle
           dynamic_cast<elle::reactor::http::Request*>(*this->_waited.begin()))
         ELLE_WARN("DEBUG: timeout on HTTP request: %s", this->_waited);
       this->_wait_abort(elle::sprintf("wait timeout for %s (waiting %s)",
-                                      waited, this->_waited));
+                                      *this->_timeout_waitables,
+                                      this->_waited));
     }
 
     void
@@ -480,8 +509,12 @@ namespace elle
         if (this->_waited.empty())
         {
           ELLE_TRACE("%s: nothing to wait on, waking up", *this);
+          // Only pay for the reason if someone listens.
           this->_scheduler._unfreeze(
-            *this, elle::sprintf("wait for %s ended", *waitable));
+            *this,
+            this->_unfrozen
+            ? elle::sprintf("wait for %s ended", *waitable)
+            : std::string());
           this->_state = State::running;
         }
         else
@@ -490,6 +523,35 @@ namespace elle
       }
     }
 
+    /*------.
+    | Hooks |
+    `------*/
+
+    Thread::Frozen&
+    Thread::frozen()
+    {
+      if (!this->_frozen)
+        this->_frozen = std::make_unique<Frozen>();
+      return *this->_frozen;
+    }
+
+    Thread::Unfrozen&
+    Thread::unfrozen()
+    {
+      if (!this->_unfrozen)
+        this->_unfrozen = std::make_unique<Unfrozen>();
+      return *this->_unfrozen;
+    }
+
+    /*--------------.
+    | Local storage |
+    `--------------*/
+
+    Thread::StorageSlot::StorageSlot()
+      : id(0)
+      , value(nullptr, nullptr)
+    {}
+
     /*--------.
     | Backend |
     `--------*/
@@ -572,6 +634,24 @@ namespace elle
       return s;
     }
 
+    std::ostream&
+    operator <<(std::ostream& s, Priority priority)
+    {
+      switch (priority)
+      {
+      case Priority::latency:
+        s << "latency";
+        break;
+      case Priority::normal:
+        s << "normal";
+        break;
+      case Priority::bulk:
+        s << "bulk";
+        break;
+      }
+      return s;
+    }
+
     /*------.
     | Every |
     `------*/
@@ -1,5 +1,11 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <boost/container/flat_set.hpp>
 #include <boost/signals2.hpp>
 #include <boost/system/error_code.hpp>
 
@@ -12,6 +18,7 @@
 #include <elle/reactor/duration.hh>
 #include <elle/reactor/fwd.hh>
 #include <elle/reactor/signals.hh>
+#include <elle/reactor/TimerWheel.hh>
 #include <elle/reactor/Waitable.hh>
 
 namespace elle
@@ -23,6 +30,22 @@ namespace elle
     ELLE_DAS_SYMBOL(dispose);
     ELLE_DAS_SYMBOL(managed);
 
+    /// Scheduling classes, from the most to the least latency sensitive.
+    ///
+    /// Runnable threads of every class are stepped at least once per
+    /// Scheduler round, but higher classes are served first and latency
+    /// threads catch up within the round when it overruns its budget. See
+    /// Scheduler::weight and Scheduler::round_budget.
+    enum class Priority
+    {
+      /// Request handlers and anything a peer is waiting for.
+      latency,
+      /// The default.
+      normal,
+      /// Background transfers and maintenance.
+      bulk,
+    };
+
     /// Thread represent a coroutine in a Scheduler environment.
     ///
     /// A Thread is a sequence of instructions to be executed. In the
@@ -173,18 +196,25 @@ namespace elle
     public:
       elle::Backtrace
       backtrace() const;
-      ELLE_ATTRIBUTE(elle::Backtrace, yield_backtrace);
+      /// Where the thread last yielded, only captured in debug mode.
+      ELLE_ATTRIBUTE(std::unique_ptr<elle::Backtrace>, yield_backtrace);
 
       /*---------.
       | Tracking |
       `---------*/
     public:
       using Tracker = boost::signals2::signal<void ()>;
+      /// Signal invoked when Thread object is being destroyed.
+      Tracker&
+      destructed();
+      /// Signal invoked when Thread is released by the Scheduler.
+      Tracker&
+      released();
     private:
-      /// signal invoked when Thread object is being destroyed.
-      ELLE_ATTRIBUTE_X(Tracker, destructed);
-      // signal invoked when Thread is released by the Scheduler.
-      ELLE_ATTRIBUTE_X(Tracker, released);
+      /// Signals are only created when first connected to: few threads are
+      /// tracked, and each signal costs several allocations.
+      ELLE_ATTRIBUTE(std::unique_ptr<Tracker>, destructed);
+      ELLE_ATTRIBUTE(std::unique_ptr<Tracker>, released);
 
     /*-------.
     | Status |
@@ -301,25 +331,36 @@ namespace elle
       friend class TimeoutGuard;
       friend class Waitable;
       void
-      _wait_timeout(boost::system::error_code const& e,
-                    std::string const& waited);
+      _wait_timeout();
       void
       _wait_abort(std::string const& reason);
       void
       _freeze();
       void
       _wake(Waitable* waitable);
-      ELLE_ATTRIBUTE_R(std::set<Waitable*>, waited);
+      /// A flat set keeps its storage across waits.
+      ELLE_ATTRIBUTE_R(boost::container::flat_set<Waitable*>, waited);
       ELLE_ATTRIBUTE(bool, timeout);
-      ELLE_ATTRIBUTE(boost::asio::deadline_timer, timeout_timer);
+      /// What the thread is waiting for with a timeout, for error reports.
+      ELLE_ATTRIBUTE(Waitables const*, timeout_waitables);
+      ELLE_ATTRIBUTE(TimerWheel::Entry, timeout_timer);
 
     /*------.
     | Hooks |
     `------*/
     public:
-      ELLE_ATTRIBUTE_RX(boost::signals2::signal<void ()>, frozen);
-      ELLE_ATTRIBUTE_RX(
-        boost::signals2::signal<void (std::string const&)>, unfrozen);
+      using Frozen = boost::signals2::signal<void ()>;
+      using Unfrozen = boost::signals2::signal<void (std::string const&)>;
+      /// Signal invoked when the thread freezes.
+      Frozen&
+      frozen();
+      /// Signal invoked when the thread wakes up, with the reason why.
+      Unfrozen&
+      unfrozen();
+    private:
+      /// Created when first connected to, like trackers.
+      ELLE_ATTRIBUTE(std::unique_ptr<Frozen>, frozen);
+      ELLE_ATTRIBUTE(std::unique_ptr<Unfrozen>, unfrozen);
 
     /*---------.
     | Contexts |
@@ -358,6 +399,23 @@ namespace elle
         friend class elle::With<Interruptible>;
       };
 
+    /*--------------.
+    | Local storage |
+    `--------------*/
+    private:
+      template <typename T>
+      friend class LocalStorage;
+      /// A LocalStorage value, tagged with the id of its storage.
+      struct StorageSlot
+      {
+        using Value = std::unique_ptr<void, void (*)(void*)>;
+        StorageSlot();
+        std::uint64_t id;
+        Value value;
+      };
+      /// Indexed by LocalStorage slots, destroyed with the thread.
+      ELLE_ATTRIBUTE((std::vector<StorageSlot>), storage);
+
     /*--------.
     | Backend |
     `--------*/
@@ -370,6 +428,18 @@ namespace elle
       ELLE_ATTRIBUTE_R(bool, terminating);
       /// If set to false, do not rethrow Terminate exception.
       ELLE_ATTRIBUTE_Rw(bool, interruptible);
+
+    /*----------.
+    | Priority |
+    `----------*/
+    public:
+      /// The class this thread is scheduled in, inherited from the thread
+      /// that created it.
+      ELLE_ATTRIBUTE_RW(Priority, priority);
+    private:
+      /// When the thread last became runnable, to measure its scheduling
+      /// delay.
+      ELLE_ATTRIBUTE(std::chrono::steady_clock::time_point, runnable);
     };
 
     template <typename R>
@@ -405,6 +475,7 @@ namespace elle
     `----------------*/
 
     std::ostream& operator << (std::ostream& s, Thread::State state);
+    std::ostream& operator << (std::ostream& s, Priority priority);
 
     /*------.
     | Every |
@@ -10,26 +10,11 @@ namespace elle
 
     TimeoutGuard::TimeoutGuard(reactor::Duration delay)
       : _delay(delay)
-      , _timer(reactor::scheduler().io_service(), delay)
+      , _thread(reactor::scheduler().current())
+      , _timer([this] { this->_timed_out(); })
     {
       ELLE_TRACE_SCOPE("%s: start", *this);
-      auto current = reactor::scheduler().current();
-      auto timeout_msg = elle::sprintf("%s: timeout %s", *this, *current);
-      this->_timer.async_wait(
-        [delay, current, timeout_msg]
-        (boost::system::error_code const& e)
-        {
-          if (e == boost::system::errc::operation_canceled)
-            return;
-          else if (e)
-            ELLE_ABORT("unexpected timer error: %s", e);
-          {
-            ELLE_TRACE_SCOPE("%s", timeout_msg);
-            current->raise<reactor::Timeout>(delay);
-            if (current->state() == Thread::State::frozen)
-              current->_wait_abort("guard timed out");
-          }
-        });
+      reactor::scheduler().timer_wheel().arm(this->_timer, delay);
     }
 
     TimeoutGuard::~TimeoutGuard()
@@ -38,6 +23,15 @@ namespace elle
       this->_timer.cancel();
     }
 
+    void
+    TimeoutGuard::_timed_out()
+    {
+      ELLE_TRACE_SCOPE("%s: timeout %s", *this, *this->_thread);
+      this->_thread->raise<reactor::Timeout>(this->_delay);
+      if (this->_thread->state() == Thread::State::frozen)
+        this->_thread->_wait_abort("guard timed out");
+    }
+
     void
     TimeoutGuard::print(std::ostream& output) const
     {
@@ -1,10 +1,10 @@
 #pragma once
 
-#include <boost/asio/deadline_timer.hpp>
-
 #include <elle/Printable.hh>
 #include <elle/attribute.hh>
+#include <elle/reactor/TimerWheel.hh>
 #include <elle/reactor/duration.hh>
+#include <elle/reactor/fwd.hh>
 
 namespace elle
 {
@@ -41,7 +41,10 @@ namespace elle
       print(std::ostream& output) const override;
 
     private:
-      ELLE_ATTRIBUTE(boost::asio::deadline_timer, timer);
+      void
+      _timed_out();
+      ELLE_ATTRIBUTE(Thread*, thread);
+      ELLE_ATTRIBUTE(TimerWheel::Entry, timer);
     };
   }
 }
@@ -0,0 +1,249 @@
+#include <elle/reactor/TimerWheel.hh>
+
+#include <algorithm>
+#include <limits>
+
+#include <elle/assert.hh>
+#include <elle/log.hh>
+
+ELLE_LOG_COMPONENT("elle.reactor.TimerWheel");
+
+namespace elle
+{
+  namespace reactor
+  {
+    namespace
+    {
+      auto constexpr never = std::numeric_limits<std::uint64_t>::max();
+    }
+
+    /*------.
+    | Entry |
+    `------*/
+
+    TimerWheel::Entry::Entry(Action action)
+      : _action(std::move(action))
+      , _wheel(nullptr)
+      , _expiry(0)
+      , _level(0)
+    {}
+
+    TimerWheel::Entry::~Entry()
+    {
+      this->cancel();
+    }
+
+    void
+    TimerWheel::Entry::cancel()
+    {
+      if (this->_wheel)
+        this->_wheel->_cancel(*this);
+    }
+
+    bool
+    TimerWheel::Entry::armed() const
+    {
+      return this->_wheel;
+    }
+
+    /*-------------.
+    | Construction |
+    `-------------*/
+
+    TimerWheel::TimerWheel(boost::asio::io_service& service,
+                           Duration resolution)
+      : _size(0)
+      , _resolution(std::chrono::duration_cast<Clock::duration>(
+                      std::chrono::microseconds(
+                        std::max<std::int64_t>(
+                          resolution.total_microseconds(), 1))))
+      , _epoch(Clock::now())
+      , _now(0)
+      , _wheels()
+      , _counts()
+      , _wake(never)
+      , _driver(service)
+    {}
+
+    TimerWheel::~TimerWheel()
+    {
+      for (auto& level: this->_wheels)
+        for (auto& slot: level)
+          for (auto& entry: slot)
+            entry._wheel = nullptr;
+    }
+
+    /*-------.
+    | Timers |
+    `-------*/
+
+    void
+    TimerWheel::arm(Entry& entry, Duration delay)
+    {
+      entry.cancel();
+      // Nothing is pending, skip the ticks elapsed since the last wake up.
+      if (this->_size == 0)
+        this->_now = std::max(this->_now, this->_tick(Clock::now()));
+      auto const deadline = Clock::now() + std::chrono::microseconds(
+        std::max<std::int64_t>(delay.total_microseconds(), 0));
+      // Round up so the action never runs early.
+      auto const since = deadline - this->_epoch;
+      entry._expiry = std::max<std::uint64_t>(
+        (since + this->_resolution - Clock::duration(1)) / this->_resolution,
+        this->_now);
+      entry._wheel = this;
+      ++this->_size;
+      this->_insert(entry);
+      if (entry._expiry < this->_wake)
+        this->_wake_at(entry._expiry);
+    }
+
+    void
+    TimerWheel::idle()
+    {
+      if (this->_size == 0 && this->_wake != never)
+      {
+        ELLE_DUMP("%s: disarm driving timer", this);
+        this->_wake = never;
+        this->_driver.cancel();
+      }
+    }
+
+    std::uint64_t
+    TimerWheel::_tick(Clock::time_point t) const
+    {
+      return (t - this->_epoch) / this->_resolution;
+    }
+
+    void
+    TimerWheel::_insert(Entry& entry)
+    {
+      auto const delta = entry._expiry - this->_now;
+      // Entries beyond the wheel range wait in the last bucket and are pushed
+      // back again when it is cascaded.
+      auto const expiry = std::min(
+        entry._expiry, this->_now + (std::uint64_t(1) << (bits * levels)) - 1);
+      int level = 0;
+      while (level < levels - 1 &&
+             delta >= (std::uint64_t(1) << (bits * (level + 1))))
+        ++level;
+      entry._level = level;
+      ++this->_counts[level];
+      this->_wheels[level][(expiry >> (bits * level)) & mask].push_back(entry);
+    }
+
+    void
+    TimerWheel::_cancel(Entry& entry)
+    {
+      entry.unlink();
+      entry._wheel = nullptr;
+      --this->_counts[entry._level];
+      --this->_size;
+    }
+
+    void
+    TimerWheel::_expired()
+    {
+      this->_wake = never;
+      this->_advance(this->_tick(Clock::now()));
+      this->_schedule();
+    }
+
+    void
+    TimerWheel::_advance(std::uint64_t tick)
+    {
+      while (this->_now <= tick && this->_size > 0)
+      {
+        // Redistribute coarser buckets whose time has come, coarsest first.
+        for (int level = levels - 1; level > 0; --level)
+          if ((this->_now & ((std::uint64_t(1) << (bits * level)) - 1)) == 0)
+            this->_cascade(level);
+        if (this->_counts[0] == 0)
+        {
+          // Nothing expires before the next cascade.
+          this->_now = std::min((this->_now | mask) + 1, tick + 1);
+          continue;
+        }
+        Slot expired;
+        expired.splice(expired.end(), this->_wheels[0][this->_now & mask]);
+        ++this->_now;
+        while (!expired.empty())
+        {
+          auto& entry = expired.front();
+          this->_cancel(entry);
+          try
+          {
+            entry._action();
+          }
+          catch (...)
+          {
+            // Leave the remaining entries for the next wake up.
+            this->_wheels[0][this->_now & mask].splice(
+              this->_wheels[0][this->_now & mask].end(), expired);
+            for (auto& e: this->_wheels[0][this->_now & mask])
+              e._expiry = std::max(e._expiry, this->_now);
+            this->_schedule();
+            throw;
+          }
+        }
+      }
+      // Nothing is armed: jump straight to the present.
+      this->_now = std::max(this->_now, tick + 1);
+    }
+
+    void
+    TimerWheel::_cascade(int level)
+    {
+      Slot cascaded;
+      cascaded.splice(
+        cascaded.end(),
+        this->_wheels[level][(this->_now >> (bits * level)) & mask]);
+      while (!cascaded.empty())
+      {
+        auto& entry = cascaded.front();
+        cascaded.pop_front();
+        --this->_counts[level];
+        this->_insert(entry);
+      }
+    }
+
+    void
+    TimerWheel::_schedule()
+    {
+      if (this->_size == 0)
+        return;
+      // The first non-empty bucket of the finest non-empty level is the next
+      // thing to do: either expire it or cascade it. If all its buckets have
+      // wrapped around, wake up when the level itself wraps around.
+      for (int level = 0; level < levels; ++level)
+      {
+        if (this->_counts[level] == 0)
+          continue;
+        auto const shift = bits * level;
+        auto const base =
+          this->_now >> (shift + bits) << (shift + bits);
+        auto const current = (this->_now >> shift) & mask;
+        for (auto i = level == 0 ? current : current + 1; i < slots; ++i)
+          if (!this->_wheels[level][i].empty())
+            return this->_wake_at(base + (i << shift));
+        return this->_wake_at(base + (slots << shift));
+      }
+    }
+
+    void
+    TimerWheel::_wake_at(std::uint64_t tick)
+    {
+      if (tick >= this->_wake)
+        return;
+      this->_wake = tick;
+      this->_driver.expires_at(this->_epoch + this->_resolution * tick);
+      this->_driver.async_wait(
+        [this] (boost::system::error_code const& error)
+        {
+          // The wheel may be gone if the wait was aborted.
+          if (error != boost::asio::error::operation_aborted)
+            this->_expired();
+        });
+    }
+  }
+}
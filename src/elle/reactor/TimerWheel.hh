@@ -0,0 +1,135 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+#include <boost/intrusive/list.hpp>
+
+#include <elle/attribute.hh>
+#include <elle/reactor/asio.hh>
+#include <elle/reactor/duration.hh>
+
+namespace elle
+{
+  namespace reactor
+  {
+    /// A hierarchical timing wheel, driven by a single asio timer.
+    ///
+    /// Every Scheduler owns one, through which Thread wait timeouts, Sleep,
+    /// TimeoutGuard and Timer are armed. Deadlines are rounded up to the wheel
+    /// resolution and hashed into buckets, so arming and canceling an Entry
+    /// are constant time and allocation free. This matters for timeouts, which
+    /// are armed and canceled all the time but almost never fire.
+    ///
+    /// Entries whose deadline is more than 256 ticks ahead live in coarser
+    /// buckets and are cascaded to finer ones as time passes. The asio timer
+    /// is only rearmed when an entry expires before the current wake up.
+    ///
+    /// The wheel is not thread safe: use it from its Scheduler only.
+    class TimerWheel
+    {
+    /*------.
+    | Types |
+    `------*/
+    public:
+      using Self = TimerWheel;
+      using Clock = std::chrono::steady_clock;
+      /// Something to run when a delay is elapsed.
+      ///
+      /// The action is given once upon construction, the entry can then be
+      /// armed and canceled any number of times. It is canceled upon
+      /// destruction.
+      class Entry
+        : public boost::intrusive::list_base_hook<
+            boost::intrusive::link_mode<boost::intrusive::auto_unlink>>
+      {
+      public:
+        using Action = std::function<void ()>;
+        Entry(Action action);
+        Entry(Entry const&) = delete;
+        ~Entry();
+        /// Cancel the entry if it is armed.
+        void
+        cancel();
+        /// Whether the entry is armed and not expired yet.
+        bool
+        armed() const;
+      private:
+        friend class TimerWheel;
+        ELLE_ATTRIBUTE(Action, action);
+        ELLE_ATTRIBUTE(TimerWheel*, wheel);
+        ELLE_ATTRIBUTE(std::uint64_t, expiry);
+        ELLE_ATTRIBUTE(int, level);
+      };
+
+    /*-------------.
+    | Construction |
+    `-------------*/
+    public:
+      /// Create a wheel.
+      ///
+      /// @param service The io_service whose timer drives the wheel.
+      /// @param resolution The duration of one tick.
+      TimerWheel(boost::asio::io_service& service,
+                 Duration resolution = boost::posix_time::milliseconds(1));
+      TimerWheel(TimerWheel const&) = delete;
+      ~TimerWheel();
+
+    /*-------.
+    | Timers |
+    `-------*/
+    public:
+      /// Arm @a entry to run its action once @a delay is elapsed.
+      ///
+      /// The action is never run early, and may run up to one tick late. It is
+      /// run from an asio callback, not from a Thread. Rearming an armed entry
+      /// cancels it first.
+      void
+      arm(Entry& entry, Duration delay);
+      /// Stop the driving timer if no entry is armed.
+      ///
+      /// Canceling entries leaves the driving timer alone, this releases it so
+      /// it does not keep the io_service busy.
+      void
+      idle();
+      /// The number of armed entries.
+      ELLE_ATTRIBUTE_R(std::size_t, size);
+    private:
+      static int constexpr bits = 8;
+      static int constexpr levels = 4;
+      static std::uint64_t constexpr slots = 1 << bits;
+      static std::uint64_t constexpr mask = slots - 1;
+      using Slot = boost::intrusive::list<
+        Entry, boost::intrusive::constant_time_size<false>>;
+      std::uint64_t
+      _tick(Clock::time_point t) const;
+      void
+      _insert(Entry& entry);
+      void
+      _cancel(Entry& entry);
+      void
+      _expired();
+      void
+      _advance(std::uint64_t tick);
+      void
+      _cascade(int level);
+      void
+      _schedule();
+      void
+      _wake_at(std::uint64_t tick);
+      /// The resolution, as a clock duration.
+      ELLE_ATTRIBUTE(Clock::duration, resolution);
+      /// Ticks are counted from this point in time.
+      ELLE_ATTRIBUTE(Clock::time_point, epoch);
+      /// The next tick to process.
+      ELLE_ATTRIBUTE(std::uint64_t, now);
+      ELLE_ATTRIBUTE((std::array<std::array<Slot, slots>, levels>), wheels);
+      ELLE_ATTRIBUTE((std::array<std::size_t, levels>), counts);
+      /// The tick the driving timer wakes up at, if armed.
+      ELLE_ATTRIBUTE(std::uint64_t, wake);
+      ELLE_ATTRIBUTE(boost::asio::steady_timer, driver);
+    };
+  }
+}
@@ -201,8 +201,15 @@ namespace elle
     | Events |
     `-------*/
     public:
+      using OnSignaled = boost::signals2::signal<void ()>;
       /// Signal triggered when the waitable wakes its waiting threads.
-      ELLE_ATTRIBUTE_RX(boost::signals2::signal<void ()>, on_signaled);
+      OnSignaled&
+      on_signaled();
+    private:
+      /// Created when first connected to, as few waitables are watched.
+      ELLE_ATTRIBUTE(std::unique_ptr<OnSignaled>, on_signaled);
+      void
+      _signaled();
 
     /*----------.
     | Printable |
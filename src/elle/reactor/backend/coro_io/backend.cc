@@ -42,7 +42,7 @@ namespace elle
                  Action action)
             : Super(name, std::move(action))
             , _backend(backend)
-            , _coro(Coro_new())
+            , _coro(backend._acquire())
             , _root(false)
           {}
 
@@ -54,7 +54,10 @@ namespace elle
             ELLE_TRACE("%s: die", *this);
             if (_coro)
             {
-              Coro_free(_coro);
+              if (this->_root)
+                Coro_free(_coro);
+              else
+                this->_backend._release(_coro);
               _coro = nullptr;
             }
           }
@@ -204,12 +207,43 @@ namespace elle
         `--------*/
 
         Backend::Backend()
-          : _self(new Thread(*this))
+          : _pool()
+          , _self(new Thread(*this))
           , _current(_self.get())
         {}
 
         Backend::~Backend()
-        {}
+        {
+          for (auto coro: this->_pool)
+            Coro_free(coro);
+        }
+
+        namespace
+        {
+          /// How many finished coroutines to keep: enough to absorb bursts of
+          /// short lived threads without pinning too many stacks.
+          std::size_t constexpr pool_size = 64;
+        }
+
+        Coro*
+        Backend::_acquire()
+        {
+          if (this->_pool.empty())
+            return Coro_new();
+          // Coro_startCoro_ sets the context up anew on the kept stack.
+          auto res = this->_pool.back();
+          this->_pool.pop_back();
+          return res;
+        }
+
+        void
+        Backend::_release(Coro* coro)
+        {
+          if (this->_pool.size() < pool_size)
+            this->_pool.emplace_back(coro);
+          else
+            Coro_free(coro);
+        }
 
         std::unique_ptr<backend::Thread>
         Backend::make_thread(const std::string& name, Action action)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <elle/reactor/backend/backend.hh>
 
 struct Coro;
@@ -46,6 +47,15 @@ namespace elle
         private:
           /// Let threads manipulate the current thread and the root thread.
           friend class Thread;
+          /// Take a coroutine from the pool, or create one.
+          Coro*
+          _acquire();
+          /// Give back a finished coroutine, keeping its stack around.
+          void
+          _release(Coro* coro);
+          /// Coroutines of finished threads, recycled by new threads. Comes
+          /// first as the root thread is built from it.
+          std::vector<Coro*> _pool;
           /// Root thread, which instantiated the Backend.
           std::unique_ptr<Thread> _self;
           /// Current thread.
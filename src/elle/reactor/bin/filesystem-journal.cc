@@ -0,0 +1,46 @@
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include <elle/Error.hh>
+#include <elle/err.hh>
+
+#include <elle/reactor/filesystem_journal.hh>
+
+namespace journal = elle::reactor::filesystem::journal;
+
+/// Print the JSON view of a filesystem journal, as written by the
+/// INFINIT_FILESYSTEM_JOURNAL mode.
+///
+/// Usage: filesystem-journal JOURNAL [in|out]
+
+int
+main(int argc, char** argv)
+{
+  if (argc < 2 || argc > 3 ||
+      (argc == 3 &&
+       std::strcmp(argv[2], "in") && std::strcmp(argv[2], "out")))
+  {
+    std::cerr << "Usage: " << argv[0] << " JOURNAL [in|out]" << std::endl;
+    return 1;
+  }
+  try
+  {
+    std::ifstream input(argv[1], std::ios::binary);
+    if (!input)
+      elle::err("unable to open %s", argv[1]);
+    journal::Reader reader(input);
+    while (auto record = reader.next())
+    {
+      if (argc == 3 &&
+          (record->kind == journal::Kind::in) != !std::strcmp(argv[2], "in"))
+        continue;
+      record->json(std::cout);
+    }
+  }
+  catch (elle::Error const& e)
+  {
+    std::cerr << argv[0] << ": " << e.what() << std::endl;
+    return 1;
+  }
+}
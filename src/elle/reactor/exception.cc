@@ -18,12 +18,13 @@ namespace elle
     {}
 
     Timeout::Timeout(reactor::Duration const& delay)
-      : Super(elle::sprintf("timeout %s", delay))
+      : Super(elle::Backtrace(), elle::sprintf("timeout %s", delay))
       , _delay(delay)
     {}
 
     Terminate::Terminate(const std::string& message)
-      : Super(elle::sprintf("thread termination: %s", message))
+      : Super(elle::Backtrace(),
+              elle::sprintf("thread termination: %s", message))
     {}
   }
 }
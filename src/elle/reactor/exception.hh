@@ -26,6 +26,8 @@ namespace elle
     };
 
     /// Exception representing an action timing out.
+    ///
+    /// Timeouts are routine: no Backtrace is captured.
     class Timeout
       : public elle::Error
     {
@@ -44,7 +46,8 @@ namespace elle
     /// a Thread execution.
     ///
     /// This exception is used by Scheduler::terminate and
-    /// Scheduler::terminate_now.
+    /// Scheduler::terminate_now. Being control flow, it captures no
+    /// Backtrace.
     class Terminate
       : public elle::Exception
     {
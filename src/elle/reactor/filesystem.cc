@@ -5,9 +5,13 @@
 #include <fcntl.h>
 #include <unistd.h>
 
+#include <elle/With.hh>
 #include <elle/assert.hh>
 #include <elle/log.hh>
 #include <elle/reactor/filesystem.hh>
+#include <elle/reactor/lockable.hh>
+#include <elle/reactor/scheduler.hh>
+#include <elle/reactor/semaphore.hh>
 
 ELLE_LOG_COMPONENT("elle.reactor.filesystem");
 
@@ -49,12 +53,11 @@ namespace elle
       {
         path = normalize(path);
         ELLE_DEBUG_SCOPE("%s: fetch_recurse \"%s\"", *this, path);
-        ELLE_DUMP("from %s", _cache);
-        auto it = _cache.find(path);
-        if (it != _cache.end())
+        ELLE_DUMP("from %s entries", this->_cache.size());
+        if (auto res = this->_cache.lookup(path))
         {
-          ELLE_DEBUG("%s: hit on '%s': %s", *this, path, it->second.get());
-          return it->second;
+          ELLE_DEBUG("%s: hit on '%s': %s", *this, path, res.get());
+          return res;
         }
         else
         {
@@ -64,14 +67,14 @@ namespace elle
             ELLE_DEBUG("%s: root fetch", *this);
             auto p = _operations->path("/");
             if (p->allow_cache())
-              _cache[path] = p;
+              this->_cache.set(path, p);
             return p;
           }
           auto bpath = bfs::path(path);
           auto parent = this->fetch_recurse(bpath.parent_path().string());
           auto p = parent->child(bpath.filename().string());
           if (p->allow_cache())
-            _cache[path] = p;
+            this->_cache.set(path, p);
           return p;
         }
       }
@@ -89,16 +92,12 @@ namespace elle
         }
         else
         {
-          auto it = this->_cache.find(spath);
-          if (it == this->_cache.end())
-          {
-            auto res = this->_operations->path(spath);
-            if (res->allow_cache())
-              this->_cache[spath] = res;
+          if (auto res = this->_cache.lookup(spath))
             return res;
-          }
-          else
-            return it->second;
+          auto res = this->_operations->path(spath);
+          if (res->allow_cache())
+            this->_cache.set(spath, res);
+          return res;
         }
       }
 
@@ -106,12 +105,10 @@ namespace elle
       FileSystem::extract(std::string const& path_)
       {
         auto path = normalize(path_);
-        auto it = this->_cache.find(path);
-        if (it == this->_cache.end())
+        if (auto res = this->_cache.extract(path))
+          return res->unwrap();
+        else
           return {};
-        auto res = it->second;
-        this->_cache.erase(path);
-        return res->unwrap();
       }
 
       std::shared_ptr<Path>
@@ -120,20 +117,187 @@ namespace elle
       {
         auto path = normalize(path_);
         std::shared_ptr<Path> res = extract(path);
-        this->_cache[path] =
-          this->_operations->wrap(path, new_content);
+        this->_cache.set(path, this->_operations->wrap(path, new_content));
         return res;
       }
 
       std::shared_ptr<Path>
       FileSystem::get(std::string const& path_)
       {
-        auto path = normalize(path_);
-        auto it = this->_cache.find(path);
-        if (it == this->_cache.end())
+        return this->_cache.get(normalize(path_));
+      }
+
+      void
+      FileSystem::invalidate(std::string const& path)
+      {
+        ELLE_DEBUG("%s: invalidate %s", *this, path);
+        this->_cache.invalidate(normalize(path));
+      }
+
+      bool
+      FileSystem::missing(std::string const& path)
+      {
+        return this->_cache.missing(normalize(path));
+      }
+
+      void
+      FileSystem::set_missing(std::string const& path)
+      {
+        this->_cache.set_missing(normalize(path));
+      }
+
+      /*----------.
+      | PathCache |
+      `----------*/
+
+      PathCache::PathCache(std::size_t capacity, Duration negative_ttl)
+        : _capacity(std::max<std::size_t>(capacity, 1))
+        , _negative_ttl(negative_ttl)
+        , _statistics()
+        , _entries()
+      {}
+
+      PathCache::Entries::nth_index<1>::type::iterator
+      PathCache::_find(std::string const& path)
+      {
+        auto& index = this->_entries.get<1>();
+        auto it = index.find(path);
+        if (it != index.end() && !it->content &&
+            it->expiration <= Clock::now())
+        {
+          index.erase(it);
+          return index.end();
+        }
+        return it;
+      }
+
+      std::shared_ptr<Path>
+      PathCache::lookup(std::string const& path)
+      {
+        auto& index = this->_entries.get<1>();
+        auto it = this->_find(path);
+        if (it == index.end() || !it->content)
+        {
+          ++this->_statistics.misses;
+          return nullptr;
+        }
+        ++this->_statistics.hits;
+        this->_entries.relocate(this->_entries.begin(),
+                                this->_entries.project<0>(it));
+        return it->content;
+      }
+
+      bool
+      PathCache::missing(std::string const& path)
+      {
+        auto it = this->_find(path);
+        if (it == this->_entries.get<1>().end() || it->content)
+          return false;
+        ++this->_statistics.negative_hits;
+        return true;
+      }
+
+      std::shared_ptr<Path>
+      PathCache::get(std::string const& path) const
+      {
+        auto& index = this->_entries.get<1>();
+        auto it = index.find(path);
+        if (it == index.end())
           return nullptr;
         else
-          return it->second;
+          return it->content;
+      }
+
+      void
+      PathCache::set(std::string const& path, std::shared_ptr<Path> content)
+      {
+        ELLE_ASSERT(content);
+        this->_insert(Entry{path, std::move(content), {}});
+      }
+
+      void
+      PathCache::set_missing(std::string const& path)
+      {
+        auto const ttl = std::chrono::microseconds(
+          this->_negative_ttl.total_microseconds());
+        if (ttl <= ttl.zero())
+          return;
+        this->_insert(Entry{path, nullptr, Clock::now() + ttl});
+      }
+
+      void
+      PathCache::_insert(Entry entry)
+      {
+        auto& index = this->_entries.get<1>();
+        auto it = index.find(entry.path);
+        if (it != index.end())
+        {
+          index.replace(it, std::move(entry));
+          this->_entries.relocate(this->_entries.begin(),
+                                  this->_entries.project<0>(it));
+        }
+        else
+        {
+          this->_entries.push_front(std::move(entry));
+          this->_evict();
+        }
+      }
+
+      void
+      PathCache::_evict()
+      {
+        while (this->_entries.size() > this->_capacity)
+        {
+          ELLE_DUMP("evict %s", this->_entries.back().path);
+          this->_entries.pop_back();
+          ++this->_statistics.evictions;
+        }
+      }
+
+      std::shared_ptr<Path>
+      PathCache::extract(std::string const& path)
+      {
+        auto& index = this->_entries.get<1>();
+        auto it = index.find(path);
+        if (it == index.end())
+          return nullptr;
+        auto res = it->content;
+        index.erase(it);
+        return res;
+      }
+
+      void
+      PathCache::invalidate(std::string const& path)
+      {
+        if (path == "/")
+          return this->clear();
+        auto& index = this->_entries.get<1>();
+        index.erase(path);
+        // Descendants sort right after their "/"-terminated prefix.
+        auto const prefix = path + "/";
+        auto it = index.lower_bound(prefix);
+        while (it != index.end() &&
+               it->path.compare(0, prefix.size(), prefix) == 0)
+          it = index.erase(it);
+      }
+
+      void
+      PathCache::clear()
+      {
+        this->_entries.clear();
+      }
+
+      std::size_t
+      PathCache::size() const
+      {
+        return this->_entries.size();
+      }
+
+      void
+      PathCache::capacity(std::size_t capacity)
+      {
+        this->_capacity = std::max<std::size_t>(capacity, 1);
+        this->_evict();
       }
 
       std::unique_ptr<Handle>
@@ -227,6 +391,12 @@ namespace elle
         throw Error(EPERM, "Not implemented");
       }
 
+      int
+      Handle::fd()
+      {
+        return -1;
+      }
+
       void
       Path::setxattr(std::string const& name, std::string const& value,
                      int flags)
@@ -260,10 +430,37 @@ namespace elle
       Handle::fsyncdir(int datasync)
       {}
 
-      BindOperations::BindOperations(bfs::path  source)
+      BindOperations::BindOperations(bfs::path source, int io_threads)
         : _source(std::move(source))
+        , _io_threads(io_threads)
+        , _stat_entries(false)
+        , _io_slots(io_threads > 0
+                    ? std::make_unique<Semaphore>(io_threads)
+                    : nullptr)
+      {
+        ELLE_ASSERT_GTE(io_threads, 0);
+      }
+
+      BindOperations::~BindOperations()
       {}
 
+      void
+      BindOperations::run(std::function<void ()> const& action,
+                          bool interruptible)
+      {
+        // Outside of a reactor thread there is no one to yield to.
+        if (!this->_io_slots || !Scheduler::scheduler())
+          return action();
+        Lock lock(*this->_io_slots);
+        if (interruptible)
+          reactor::background(action);
+        else
+          elle::With<Thread::NonInterruptible>() << [&]
+          {
+            reactor::background(action);
+          };
+      }
+
       BindPath::BindPath(bfs::path const& path, BindOperations& ops)
         : _where(ops.source() / path)
         , _ops(ops)
@@ -272,105 +469,175 @@ namespace elle
       void
       BindPath::stat(struct stat* st)
       {
-        int res = ::stat(this->_where.string().c_str(), st);
-        if (res < 0)
-          throw Error(errno, strerror(errno));
+        auto res = std::make_shared<struct stat>();
+        this->_ops.run(
+          [res, where = this->_where.string()]
+          {
+            if (::stat(where.c_str(), res.get()) < 0)
+              throw Error(errno, strerror(errno));
+          });
+        *st = *res;
+      }
+
+      namespace
+      {
+        struct Entry
+        {
+          std::string name;
+          struct stat st;
+          bool stat;
+        };
       }
 
       void
       BindPath::list_directory(OnDirectoryEntry cb)
       {
-        bfs::directory_iterator it(this->_where);
-        for(;it != bfs::directory_iterator(); ++it)
-        {
-          cb(it->path().filename().string(), nullptr);
-        }
+        // Read the whole directory, and stat entries if requested, in one
+        // go: the callback must run on the scheduler thread.
+        auto entries = std::make_shared<std::vector<Entry>>();
+        this->_ops.run(
+          [entries, where = this->_where, stat = this->_ops.stat_entries()]
+          {
+            boost::system::error_code erc;
+            bfs::directory_iterator it(where, erc);
+            for (; !erc && it != bfs::directory_iterator(); it.increment(erc))
+            {
+              entries->emplace_back();
+              auto& entry = entries->back();
+              entry.name = it->path().filename().string();
+              entry.stat = stat &&
+                ::stat(it->path().string().c_str(), &entry.st) == 0;
+            }
+            if (erc)
+              throw Error(erc.value(), erc.message());
+          });
+        for (auto& entry: *entries)
+          cb(entry.name, entry.stat ? &entry.st : nullptr);
       }
 
       std::unique_ptr<Handle>
       BindPath::open(int flags, mode_t mode)
       {
-        int fd = ::open(this->_where.string().c_str(), flags, mode);
-        return make_handle(this->_where, fd);
+        auto fd = std::make_shared<int>(-1);
+        this->_ops.run(
+          [fd, flags, mode, where = this->_where.string()]
+          {
+            *fd = ::open(where.c_str(), flags, mode);
+            if (*fd < 0)
+              throw Error(errno, strerror(errno));
+          });
+        return make_handle(this->_where, *fd);
       }
 
       void
       BindPath::unlink()
       {
-        boost::system::error_code erc;
-        bfs::remove(this->_where, erc);
-        if (erc)
-          throw Error(erc.value(), erc.message());
+        this->_ops.run(
+          [where = this->_where]
+          {
+            boost::system::error_code erc;
+            bfs::remove(where, erc);
+            if (erc)
+              throw Error(erc.value(), erc.message());
+          });
       }
 
       void
       BindPath::mkdir(mode_t mode)
       {
-        boost::system::error_code erc;
-        bfs::create_directory(this->_where, erc);
-        if (erc)
-          throw Error(erc.value(), erc.message());
+        this->_ops.run(
+          [where = this->_where]
+          {
+            boost::system::error_code erc;
+            bfs::create_directory(where, erc);
+            if (erc)
+              throw Error(erc.value(), erc.message());
+          });
       }
 
       void
       BindPath::rmdir()
       {
-        boost::system::error_code erc;
-        if (bfs::is_directory(this->_where, erc))
-        {
-          bfs::remove(this->_where, erc);
-          if (erc)
-            throw Error(erc.value(), erc.message());
-        }
-        else
-          throw Error(ENOTDIR, "Not a directory");
+        this->_ops.run(
+          [where = this->_where]
+          {
+            boost::system::error_code erc;
+            if (bfs::is_directory(where, erc))
+            {
+              bfs::remove(where, erc);
+              if (erc)
+                throw Error(erc.value(), erc.message());
+            }
+            else
+              throw Error(ENOTDIR, "Not a directory");
+          });
       }
 
       void
       BindPath::rename(bfs::path const& localtarget)
       {
-        bfs::path target = this->ops().source() / localtarget;
-        boost::system::error_code erc;
-        bfs::rename(this->_where, target, erc);
-        if (erc)
-          throw Error(erc.value(), erc.message());
+        this->_ops.run(
+          [where = this->_where, target = this->ops().source() / localtarget]
+          {
+            boost::system::error_code erc;
+            bfs::rename(where, target, erc);
+            if (erc)
+              throw Error(erc.value(), erc.message());
+          });
       }
 
       bfs::path
       BindPath::readlink()
       {
-        boost::system::error_code erc;
-        bfs::path target = bfs::read_symlink(this->_where, erc);
-        if (erc)
-          throw Error(erc.value(), erc.message());
-        return target;
+        auto target = std::make_shared<bfs::path>();
+        this->_ops.run(
+          [target, where = this->_where]
+          {
+            boost::system::error_code erc;
+            *target = bfs::read_symlink(where, erc);
+            if (erc)
+              throw Error(erc.value(), erc.message());
+          });
+        return *target;
       }
 
       void
       BindPath::symlink(bfs::path const& target)
       {
-        boost::system::error_code erc;
-        bfs::create_symlink(target, this->_where, erc);
-        if (erc)
-          throw Error(erc.value(), erc.message());
+        this->_ops.run(
+          [target, where = this->_where]
+          {
+            boost::system::error_code erc;
+            bfs::create_symlink(target, where, erc);
+            if (erc)
+              throw Error(erc.value(), erc.message());
+          });
       }
 
       void
       BindPath::link(bfs::path const& target)
       {
-        boost::system::error_code erc;
-        bfs::create_hard_link(target, this->_where, erc);
-        if (erc)
-          throw Error(erc.value(), erc.message());
+        this->_ops.run(
+          [target, where = this->_where]
+          {
+            boost::system::error_code erc;
+            bfs::create_hard_link(target, where, erc);
+            if (erc)
+              throw Error(erc.value(), erc.message());
+          });
       }
 
       void
       BindPath::chmod(mode_t mode)
       {
-        boost::system::error_code erc;
-        bfs::permissions(this->_where, (bfs::perms)mode, erc);
-        if (erc)
-          throw Error(erc.value(), erc.message());
+        this->_ops.run(
+          [mode, where = this->_where]
+          {
+            boost::system::error_code erc;
+            bfs::permissions(where, (bfs::perms)mode, erc);
+            if (erc)
+              throw Error(erc.value(), erc.message());
+          });
       }
 
       void
@@ -379,9 +646,12 @@ namespace elle
   #ifdef ELLE_WINDOWS
         throw Error(EPERM, "Not implemented");
   #else
-        int res = ::chown(this->_where.string().c_str(), uid, gid);
-        if (res < 0)
-          throw Error(errno, strerror(errno));
+        this->_ops.run(
+          [uid, gid, where = this->_where.string()]
+          {
+            if (::chown(where.c_str(), uid, gid) < 0)
+              throw Error(errno, strerror(errno));
+          });
   #endif
       }
 
@@ -391,9 +661,14 @@ namespace elle
   #if defined(ELLE_WINDOWS) || defined(ELLE_ANDROID)
         throw Error(EPERM, "Not implemented");
   #else
-       int res = ::statvfs(this->_where.string().c_str(), s);
-       if (res < 0)
-         throw Error(errno, strerror(errno));
+        auto res = std::make_shared<struct statvfs>();
+        this->_ops.run(
+          [res, where = this->_where.string()]
+          {
+            if (::statvfs(where.c_str(), res.get()) < 0)
+              throw Error(errno, strerror(errno));
+          });
+        *s = *res;
   #endif
       }
 
@@ -401,9 +676,13 @@ namespace elle
       BindPath::utimens(const struct timespec tv[2])
       {
   #ifdef ELLE_LINUX
-        int res = ::utimensat(0, this->_where.string().c_str(), tv, 0);
-        if (res < 0)
-          throw Error(errno, strerror(errno));
+        this->_ops.run(
+          [atime = tv[0], mtime = tv[1], where = this->_where.string()]
+          {
+            struct timespec const tv[2] = {atime, mtime};
+            if (::utimensat(0, where.c_str(), tv, 0) < 0)
+              throw Error(errno, strerror(errno));
+          });
   #else
         throw Error(EPERM, "Not implemented");
   #endif
@@ -412,10 +691,14 @@ namespace elle
       void
       BindPath::truncate(off_t new_size)
       {
-        boost::system::error_code erc;
-        bfs::resize_file(this->_where, new_size, erc);
-        if (erc)
-          throw Error(erc.value(), erc.message());
+        this->_ops.run(
+          [new_size, where = this->_where]
+          {
+            boost::system::error_code erc;
+            bfs::resize_file(where, new_size, erc);
+            if (erc)
+              throw Error(erc.value(), erc.message());
+          });
       }
 
       /// Return a Path for given child name.
@@ -428,12 +711,17 @@ namespace elle
       std::unique_ptr<BindHandle>
       BindPath::make_handle(bfs::path& where, int fd)
       {
-        return std::make_unique<BindHandle>(fd, where);
+        auto res = std::make_unique<BindHandle>(fd, where, &this->_ops);
+        // Plain bound files are served as is.
+        res->splice(true);
+        return res;
       }
 
-      BindHandle::BindHandle(int fd, bfs::path  where)
-        : _fd(fd)
+      BindHandle::BindHandle(int fd, bfs::path where, BindOperations* ops)
+        : _splice(false)
+        , _fd(fd)
         , _where(std::move(where))
+        , _ops(ops)
       {}
 
       void
@@ -442,18 +730,96 @@ namespace elle
         ::close(this->_fd);
       }
 
+      int
+      BindHandle::fd()
+      {
+        if (this->_splice && (!this->_ops || this->_ops->io_threads() == 0))
+          return this->_fd;
+        else
+          return -1;
+      }
+
+#ifdef ELLE_LINUX
+      IOUring*
+      BindHandle::_ring()
+      {
+        // Unless I/O is meant to run on the scheduler thread.
+        if (this->_ops->io_threads() == 0)
+          return nullptr;
+        auto sched = Scheduler::scheduler();
+        return sched ? sched->io_uring() : nullptr;
+      }
+#endif
+
+      namespace
+      {
+        // Positioned reads and writes: concurrent operations on the same
+        // handle may run in parallel in the I/O pool and must not share a
+        // file offset. Windows has none, fall back on seeking.
+
+        ssize_t
+        _pread(int fd, void* data, size_t size, off_t offset)
+        {
+  #ifdef ELLE_WINDOWS
+          ::lseek(fd, offset, SEEK_SET);
+          return ::read(fd, data, size);
+  #else
+          return ::pread(fd, data, size, offset);
+  #endif
+        }
+
+        ssize_t
+        _pwrite(int fd, void const* data, size_t size, off_t offset)
+        {
+  #ifdef ELLE_WINDOWS
+          ::lseek(fd, offset, SEEK_SET);
+          return ::write(fd, data, size);
+  #else
+          return ::pwrite(fd, data, size, offset);
+  #endif
+        }
+      }
+
+      // The buffer belongs to the caller and is accessed from the system
+      // thread: the caller must not be terminated, and free it, before the
+      // system call returns.
+
       int
       BindHandle::read(elle::WeakBuffer buffer, size_t size, off_t offset)
       {
-        lseek(this->_fd, offset, SEEK_SET);
-        return ::read(this->_fd, (void*)buffer.contents(), size);
+        if (!this->_ops)
+          return _pread(this->_fd, buffer.mutable_contents(), size, offset);
+#ifdef ELLE_LINUX
+        if (auto ring = this->_ring())
+          return ring->pread(this->_fd, buffer.mutable_contents(), size, offset);
+#endif
+        auto res = std::make_shared<ssize_t>(0);
+        this->_ops->run(
+          [res, fd = this->_fd, data = buffer.mutable_contents(), size, offset]
+          {
+            *res = _pread(fd, data, size, offset);
+          },
+          false);
+        return *res;
       }
 
       int
       BindHandle::write(elle::ConstWeakBuffer buffer, size_t size, off_t offset)
       {
-        lseek(this->_fd, offset, SEEK_SET);
-        return ::write(this->_fd, buffer.contents(), size);
+        if (!this->_ops)
+          return _pwrite(this->_fd, buffer.contents(), size, offset);
+#ifdef ELLE_LINUX
+        if (auto ring = this->_ring())
+          return ring->pwrite(this->_fd, buffer.contents(), size, offset);
+#endif
+        auto res = std::make_shared<ssize_t>(0);
+        this->_ops->run(
+          [res, fd = this->_fd, data = buffer.contents(), size, offset]
+          {
+            *res = _pwrite(fd, data, size, offset);
+          },
+          false);
+        return *res;
       }
 
       std::shared_ptr<Path>
@@ -464,9 +830,15 @@ namespace elle
 
       void BindHandle::ftruncate(off_t sz)
       {
-        int res = ::ftruncate(this->_fd, sz);
-        if (res != 0)
-          throw Error(errno, strerror(errno));
+        auto truncate = [fd = this->_fd, sz]
+          {
+            if (::ftruncate(fd, sz) != 0)
+              throw Error(errno, strerror(errno));
+          };
+        if (this->_ops)
+          this->_ops->run(truncate);
+        else
+          truncate();
       }
     }
   }
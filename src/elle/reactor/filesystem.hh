@@ -4,15 +4,21 @@
 
 #include <sys/types.h>
 
+#include <chrono>
 #include <string>
 #include <unordered_map>
 
 #include <boost/filesystem.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index_container.hpp>
 
 #include <elle/Buffer.hh>
 #include <elle/Exception.hh>
 #include <elle/filesystem.hh>
 #include <elle/reactor/Waitable.hh>
+#include <elle/reactor/duration.hh>
 #include <elle/reactor/exception.hh>
 #include <elle/reactor/fwd.hh>
 
@@ -83,6 +89,13 @@ namespace elle
         virtual
         void
         close() = 0;
+
+        /// A file descriptor reads can be served from directly, at the same
+        /// offsets, or -1. Lets FUSE splice file content to the kernel
+        /// instead of copying it through read().
+        virtual
+        int
+        fd();
       };
 
       class Path
@@ -217,6 +230,97 @@ namespace elle
         ELLE_ATTRIBUTE_R(FileSystem*, filesystem, protected);
       };
 
+      /// A bounded cache of Paths by normalized full path.
+      ///
+      /// When full, the least recently used entries are evicted. The cache
+      /// also remembers, for a limited time, paths found not to exist, so
+      /// repeated lookups of missing files do not resolve them every time.
+      ///
+      /// Entries are keyed by full path rather than by parent and name: Path
+      /// implementations such as BindPath hold their location, so whatever
+      /// lies below a moved directory must be dropped anyway.
+      class PathCache
+      {
+      public:
+        using Clock = std::chrono::steady_clock;
+        struct Statistics
+        {
+          /// Lookups of a cached Path.
+          std::size_t hits = 0;
+          /// Lookups of a path known to be missing.
+          std::size_t negative_hits = 0;
+          /// Lookups of a path that was not cached, or expired.
+          std::size_t misses = 0;
+          /// Entries dropped to make room.
+          std::size_t evictions = 0;
+        };
+
+        /// @param capacity The maximum number of entries, negative ones
+        ///                 included.
+        /// @param negative_ttl How long a path is known to be missing.
+        PathCache(std::size_t capacity = 65536,
+                  Duration negative_ttl = boost::posix_time::seconds(1));
+
+        /// The Path cached for @a path, if any, marking it as recently used.
+        std::shared_ptr<Path>
+        lookup(std::string const& path);
+        /// Whether @a path is known to be missing.
+        bool
+        missing(std::string const& path);
+        /// The Path cached for @a path, if any, without affecting statistics
+        /// nor eviction order.
+        std::shared_ptr<Path>
+        get(std::string const& path) const;
+        /// Cache @a content for @a path, replacing any previous entry.
+        void
+        set(std::string const& path, std::shared_ptr<Path> content);
+        /// Remember that @a path does not exist, for negative_ttl.
+        void
+        set_missing(std::string const& path);
+        /// Remove and return the Path cached for @a path, if any.
+        std::shared_ptr<Path>
+        extract(std::string const& path);
+        /// Drop @a path and every entry below it.
+        void
+        invalidate(std::string const& path);
+        void
+        clear();
+        /// The number of entries.
+        std::size_t
+        size() const;
+        /// Change the maximum number of entries, evicting if needed.
+        void
+        capacity(std::size_t capacity);
+        ELLE_ATTRIBUTE_R(std::size_t, capacity);
+        ELLE_ATTRIBUTE_RW(Duration, negative_ttl);
+        ELLE_ATTRIBUTE_R(Statistics, statistics);
+
+      private:
+        struct Entry
+        {
+          std::string path;
+          /// Null for a missing path.
+          std::shared_ptr<Path> content;
+          /// When a missing path entry expires.
+          Clock::time_point expiration;
+        };
+        using Entries = boost::multi_index::multi_index_container<
+          Entry,
+          boost::multi_index::indexed_by<
+            boost::multi_index::sequenced<>,
+            boost::multi_index::ordered_unique<
+              boost::multi_index::member<Entry, std::string, &Entry::path>>>>;
+        /// Find the entry for @a path, dropping it if expired.
+        Entries::nth_index<1>::type::iterator
+        _find(std::string const& path);
+        void
+        _insert(Entry entry);
+        void
+        _evict();
+        /// Most recently used first.
+        ELLE_ATTRIBUTE(Entries, entries);
+      };
+
       class FileSystemImpl;
       class FileSystem
         : public reactor::Waitable
@@ -261,6 +365,18 @@ namespace elle
         std::shared_ptr<Path>
         get(std::string const& path);
 
+        /// Forget @a path and everything below it, once removed or moved.
+        void
+        invalidate(std::string const& path);
+
+        /// Whether @a path was recently found not to exist.
+        bool
+        missing(std::string const& path);
+
+        /// Remember that @a path does not exist.
+        void
+        set_missing(std::string const& path);
+
       /*---------.
       | Waitable |
       `---------*/
@@ -280,15 +396,19 @@ namespace elle
         ELLE_ATTRIBUTE_R(std::vector<std::string>, mount_options);
         ELLE_ATTRIBUTE_RW(bool, full_tree);
         std::string _where;
-        std::unordered_map<std::string, std::shared_ptr<Path>> _cache;
+        ELLE_ATTRIBUTE_RX(PathCache, cache);
       };
 
 
+      class BindOperations;
+
       /// Handle implementation reading/writing to the local filesystem
       class BindHandle: public Handle
       {
       public:
-        BindHandle(int fd, bfs::path);
+        /// @param ops If given, run reads and writes according to its I/O
+        ///            policy, otherwise on the scheduler thread.
+        BindHandle(int fd, bfs::path, BindOperations* ops = nullptr);
         int
         read(elle::WeakBuffer buffer, size_t size, off_t offset) override;
         int
@@ -297,22 +417,66 @@ namespace elle
         ftruncate(off_t offset) override;
         void
         close() override;
+        /// The file descriptor, if splice is set and I/O runs on the
+        /// scheduler thread: serving reads from it would otherwise block the
+        /// scheduler.
+        int
+        fd() override;
+        /// Whether reads may be served straight from the file descriptor,
+        /// bypassing read(). Only set it for handles that do not transform
+        /// the file content. Unset by default.
+        ELLE_ATTRIBUTE_RW(bool, splice);
 
       protected:
+#ifdef ELLE_LINUX
+        /// The scheduler io_uring, if reads and writes should use it.
+        IOUring*
+        _ring();
+#endif
         int _fd;
         bfs::path _where;
+        BindOperations* _ops;
       };
 
+      /// Operations mirroring a local directory.
+      ///
+      /// Given `io_threads`, blocking system calls are run in system threads
+      /// through reactor::background, at most `io_threads` at a time, the
+      /// calling reactor::Thread yielding meanwhile so a slow disk does not
+      /// stall the whole scheduler. Where the scheduler has an io_uring, file
+      /// reads and writes go through it instead.
       class BindOperations
         : public Operations
       {
       public:
-        BindOperations(bfs::path source);
+        /// @param source The directory to mirror.
+        /// @param io_threads The maximum number of system calls run in
+        ///                   parallel. Zero, the default, runs them on the
+        ///                   scheduler thread.
+        BindOperations(bfs::path source, int io_threads = 0);
+        ~BindOperations();
 
         std::shared_ptr<Path>
         path(std::string const& path) override;
 
+        /// Run a blocking @a action according to the I/O policy.
+        ///
+        /// @a action is copied and may outlive the caller if it is
+        /// terminated: it must not capture local state by reference.
+        ///
+        /// @param interruptible Whether the caller may be terminated while
+        ///                      @a action runs. Actions using memory of the
+        ///                      caller, such as its buffers, must not be.
+        void
+        run(std::function<void ()> const& action, bool interruptible = true);
+
         ELLE_ATTRIBUTE_R(bfs::path, source);
+        ELLE_ATTRIBUTE_R(int, io_threads);
+        /// Whether list_directory stats entries along, in the same background
+        /// batch, so the kernel does not look them up one by one afterwards.
+        ELLE_ATTRIBUTE_RW(bool, stat_entries);
+      private:
+        ELLE_ATTRIBUTE(std::unique_ptr<Semaphore>, io_slots);
       };
 
       /// Default Path implementation acting on the local filesystem.
@@ -52,15 +52,22 @@ namespace elle
         BENCH("getattr");
         ELLE_ASSERT(path);
         ELLE_TRACE_SCOPE("fusop_getattr %s", path);
+        auto* fs = (FileSystem*)fuse_get_context()->private_data;
+        if (fs->missing(path))
+        {
+          ELLE_TRACE("%s is known to be missing", path);
+          return -ENOENT;
+        }
         try
         {
-          auto* fs = (FileSystem*)fuse_get_context()->private_data;
           PathPtr p = fs->path(path);
           p->stat(stbuf);
         }
         catch (Error const& e)
         {
           ELLE_TRACE("filesystem error statting %s: %s", path, e.what());
+          if (e.error_code() == ENOENT)
+            fs->set_missing(path);
           return -e.error_code();
         }
         return 0;
@@ -130,6 +137,8 @@ namespace elle
           auto* fs = (FileSystem*)fuse_get_context()->private_data;
           PathPtr p = fs->path(path);
           auto handle = p->create(fi->flags, mode);
+          // Whether or not the path is cached, drop a cached absence.
+          fs->invalidate(path);
           fi->fh = (decltype(fi->fh)) handle.release();
         }
         catch (Error const& e)
@@ -152,6 +161,7 @@ namespace elle
           auto* fs = (FileSystem*)fuse_get_context()->private_data;
           PathPtr p = fs->path(path);
           p->unlink();
+          fs->invalidate(path);
         }
         catch (Error const& e)
         {
@@ -173,6 +183,7 @@ namespace elle
           auto* fs = (FileSystem*)fuse_get_context()->private_data;
           PathPtr p = fs->path(path);
           p->mkdir(mode);
+          fs->invalidate(path);
         }
         catch (Error const& e)
         {
@@ -194,6 +205,7 @@ namespace elle
           auto* fs = (FileSystem*)fuse_get_context()->private_data;
           PathPtr p = fs->path(path);
           p->rmdir();
+          fs->invalidate(path);
         }
         catch (Error const& e)
         {
@@ -216,6 +228,8 @@ namespace elle
           auto* fs = (FileSystem*)fuse_get_context()->private_data;
           PathPtr p = fs->path(path);
           p->rename(to);
+          fs->invalidate(path);
+          fs->invalidate(to);
         }
         catch (Error const& e)
         {
@@ -249,6 +263,67 @@ namespace elle
         return 0;
       }
 
+#if FUSE_VERSION >= 29
+      static
+      int
+      fusop_read_buf(const char* path,
+                     struct fuse_bufvec** bufp,
+                     size_t size,
+                     off_t offset,
+                     struct fuse_file_info* fi)
+      {
+        BENCH("read_buf");
+        ELLE_TRACE_SCOPE("fusop_read_buf %s sz=%s, offset=%s",
+                         check_path(path), size, offset);
+        // Freed by libfuse once replied, along with memory buffers.
+        auto res = (fuse_bufvec*)malloc(sizeof(fuse_bufvec));
+        if (!res)
+          return -ENOMEM;
+        *res = FUSE_BUFVEC_INIT(size);
+        auto* handle = (Handle*)fi->fh;
+        auto const fd = handle->fd();
+        if (fd >= 0)
+        {
+          // Let libfuse splice the content from the file when possible.
+          res->buf[0].flags =
+            fuse_buf_flags(FUSE_BUF_IS_FD | FUSE_BUF_FD_SEEK);
+          res->buf[0].fd = fd;
+          res->buf[0].pos = offset;
+          *bufp = res;
+          return 0;
+        }
+        res->buf[0].mem = malloc(size);
+        *bufp = res;
+        if (!res->buf[0].mem)
+          return -ENOMEM;
+        try
+        {
+          auto const read = handle->read(
+            elle::WeakBuffer(res->buf[0].mem, size), size, offset);
+          if (read < 0)
+            return read;
+          res->buf[0].size = read;
+        }
+        catch (Error const& e)
+        {
+          ELLE_TRACE("Filesystem error reading %s: %s", check_path(path), e);
+          return -e.error_code();
+        }
+        return 0;
+      }
+
+      static
+      void*
+      fusop_init(struct fuse_conn_info* conn)
+      {
+        // Move file content to the kernel with splice where supported.
+        conn->want |=
+          conn->capable & (FUSE_CAP_SPLICE_WRITE | FUSE_CAP_SPLICE_MOVE);
+        // Our return value replaces the file system private data.
+        return fuse_get_context()->private_data;
+      }
+#endif
+
       static
       int
       fusop_write(const char* path,
@@ -372,6 +447,7 @@ namespace elle
           auto* fs = (FileSystem*)fuse_get_context()->private_data;
           PathPtr p = fs->path(where);
           p->symlink(target);
+          fs->invalidate(where);
         }
         catch (Error const& e)
         {
@@ -394,6 +470,7 @@ namespace elle
           auto* fs = (FileSystem*)fuse_get_context()->private_data;
           PathPtr p = fs->path(path);
           p->link(to);
+          fs->invalidate(to);
         }
         catch (Error const& e)
         {
@@ -727,6 +804,8 @@ namespace elle
         ops.fsyncdir = fusop_fsyncdir;
   #if FUSE_VERSION >= 29
         ops.flag_nullpath_ok = true;
+        ops.read_buf = fusop_read_buf;
+        ops.init = fusop_init;
   #endif
         _impl->create(where.string(), options, &ops, sizeof(ops), this);
         _impl->on_loop_exited([this]
@@ -3,10 +3,20 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
-#include <fstream>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <istream>
 #include <utility>
+#ifdef ELLE_WINDOWS
+# include <io.h>
+#endif
 
+#include <elle/err.hh>
+#include <elle/os/environ.hh>
 #include <elle/reactor/filesystem.hh>
+#include <elle/reactor/filesystem_journal.hh>
 #include <elle/serialization/json.hh>
 
 ELLE_LOG_COMPONENT("elle.reactor.filesystem.journal");
@@ -17,7 +27,559 @@ namespace elle
   {
     namespace filesystem
     {
-      static bool True = true;
+      namespace journal
+      {
+        namespace
+        {
+          char const magic[] = "elle.reactor.filesystem.journal.1\n";
+
+          /// Field value types.
+          enum Type: std::uint8_t
+          {
+            boolean = 'b',
+            integer = 'i',
+            unsigned_integer = 'u',
+            string = 's',
+            buffer = 'x',
+            strings = 'l',
+          };
+
+          template <typename T>
+          void
+          put_integer(elle::Buffer& output, T value)
+          {
+            std::uint8_t bytes[sizeof(T)];
+            for (unsigned i = 0; i < sizeof(T); ++i)
+              bytes[i] = std::uint8_t(value >> (8 * i));
+            output.append(bytes, sizeof(T));
+          }
+
+          void
+          put_bytes(elle::Buffer& output, elle::ConstWeakBuffer bytes)
+          {
+            put_integer(output, std::uint32_t(bytes.size()));
+            output.append(bytes.contents(), bytes.size());
+          }
+
+          template <typename T>
+          T
+          get_integer(std::uint8_t const* bytes)
+          {
+            auto res = T(0);
+            for (unsigned i = 0; i < sizeof(T); ++i)
+              res |= T(bytes[i]) << (8 * i);
+            return res;
+          }
+
+          /// Decode a record.
+          class Cursor
+          {
+          public:
+            Cursor(elle::ConstWeakBuffer data)
+              : _data(data)
+              , _position(0)
+            {}
+
+            bool
+            done() const
+            {
+              return this->_position == this->_data.size();
+            }
+
+            template <typename T>
+            T
+            integer()
+            {
+              this->_need(sizeof(T));
+              auto res =
+                get_integer<T>(this->_data.contents() + this->_position);
+              this->_position += sizeof(T);
+              return res;
+            }
+
+            elle::ConstWeakBuffer
+            bytes()
+            {
+              auto const size = this->integer<std::uint32_t>();
+              this->_need(size);
+              auto res = elle::ConstWeakBuffer(
+                this->_data.contents() + this->_position, size);
+              this->_position += size;
+              return res;
+            }
+
+            std::string
+            string()
+            {
+              return this->bytes().string();
+            }
+
+          private:
+            void
+            _need(std::size_t size)
+            {
+              if (this->_data.size() - this->_position < size)
+                elle::err("truncated filesystem journal record");
+            }
+
+            ELLE_ATTRIBUTE(elle::ConstWeakBuffer, data);
+            ELLE_ATTRIBUTE(std::size_t, position);
+          };
+
+          class JSON
+            : public boost::static_visitor<void>
+          {
+          public:
+            JSON(elle::serialization::json::SerializerOut& serializer,
+                 std::string const& name)
+              : _serializer(serializer)
+              , _name(name)
+            {}
+
+            template <typename T>
+            void
+            operator ()(T const& value) const
+            {
+              auto v = value;
+              this->_serializer.serialize(this->_name, v);
+            }
+
+          private:
+            ELLE_ATTRIBUTE(elle::serialization::json::SerializerOut&,
+                           serializer);
+            ELLE_ATTRIBUTE(std::string const&, name);
+          };
+        }
+
+        /*-------.
+        | Record |
+        `-------*/
+
+        void
+        Record::json(std::ostream& output) const
+        {
+          elle::serialization::json::SerializerOut serializer(output);
+          if (this->path)
+          {
+            auto path = *this->path;
+            serializer.serialize("path", path);
+          }
+          else
+          {
+            auto handle = std::to_string(this->handle.get());
+            serializer.serialize("handle", handle);
+          }
+          auto operation = this->operation;
+          serializer.serialize("operation", operation);
+          for (auto const& field: this->fields)
+            boost::apply_visitor(JSON(serializer, field.first), field.second);
+        }
+
+        /*-------.
+        | Writer |
+        `-------*/
+
+        Writer::Configuration::Configuration()
+          : buffer_size(1 << 20)
+          , delay(boost::posix_time::seconds(0))
+          , sync(0)
+        {}
+
+        Writer::Writer(std::string const& path, Configuration configuration)
+          : _configuration(std::move(configuration))
+          , _file(std::fopen(path.c_str(), "ab"))
+          , _mutex()
+          , _pending_available()
+          , _written_available()
+          , _pending()
+          , _writing()
+          , _appended(0)
+          , _synced(0)
+          , _sync_requested(false)
+          , _stop(false)
+          , _statistics{0, 0, 0, 0}
+          , _thread()
+        {
+          if (!this->_file)
+            elle::err("unable to open filesystem journal %s: %s",
+                      path, std::strerror(errno));
+          ELLE_TRACE_SCOPE("%s: open %s", this, path);
+          // Records are batched already.
+          std::setvbuf(this->_file, nullptr, _IONBF, 0);
+          this->_pending.capacity(this->_configuration.buffer_size);
+          this->_writing.capacity(this->_configuration.buffer_size);
+          std::fseek(this->_file, 0, SEEK_END);
+          if (std::ftell(this->_file) == 0)
+            this->_pending.append(magic, sizeof(magic) - 1);
+          this->_thread = std::thread([this] { this->_run(); });
+        }
+
+        Writer::~Writer()
+        {
+          ELLE_TRACE_SCOPE("%s: close", this);
+          {
+            std::unique_lock<std::mutex> lock(this->_mutex);
+            this->_stop = true;
+          }
+          this->_pending_available.notify_one();
+          this->_thread.join();
+          std::fclose(this->_file);
+        }
+
+        Writer::Push
+        Writer::in(std::string const& path, std::string const& operation)
+        {
+          return Push(*this, Kind::in, operation, path);
+        }
+
+        Writer::Push
+        Writer::in(void const* handle, std::string const& operation)
+        {
+          return Push(*this, Kind::in, operation, handle);
+        }
+
+        Writer::Push
+        Writer::out(std::string const& path, std::string const& operation)
+        {
+          return Push(*this, Kind::out, operation, path);
+        }
+
+        Writer::Push
+        Writer::out(void const* handle, std::string const& operation)
+        {
+          return Push(*this, Kind::out, operation, handle);
+        }
+
+        void
+        Writer::flush()
+        {
+          std::unique_lock<std::mutex> lock(this->_mutex);
+          auto const target = this->_appended;
+          this->_sync_requested = true;
+          this->_pending_available.notify_one();
+          this->_written_available.wait(
+            lock, [&] { return this->_synced >= target; });
+        }
+
+        Writer::Statistics
+        Writer::statistics() const
+        {
+          std::unique_lock<std::mutex> lock(this->_mutex);
+          return this->_statistics;
+        }
+
+        void
+        Writer::_run()
+        {
+          auto const& config = this->_configuration;
+          auto const delay =
+            std::chrono::microseconds(config.delay.total_microseconds());
+          std::unique_lock<std::mutex> lock(this->_mutex);
+          while (true)
+          {
+            this->_pending_available.wait(
+              lock,
+              [this]
+              {
+                return this->_stop || this->_sync_requested ||
+                  this->_pending.size() > 0;
+              });
+            // Give concurrent operations a chance to join the batch.
+            if (delay.count() > 0 && !this->_stop && !this->_sync_requested)
+              this->_pending_available.wait_for(
+                lock, delay,
+                [&]
+                {
+                  return this->_stop || this->_sync_requested ||
+                    this->_pending.size() >= config.buffer_size / 2;
+                });
+            auto const sync = this->_sync_requested ||
+              (config.sync > 0 &&
+               (this->_stop ||
+                (this->_statistics.batches + 1) % config.sync == 0));
+            if (this->_pending.size() == 0 &&
+                (!sync || this->_synced == this->_appended))
+            {
+              this->_sync_requested = false;
+              this->_synced = this->_appended;
+              this->_written_available.notify_all();
+              if (this->_stop)
+                break;
+              continue;
+            }
+            std::swap(this->_pending, this->_writing);
+            auto const appended = this->_appended;
+            this->_sync_requested = false;
+            lock.unlock();
+            ELLE_DEBUG("%s: write %s bytes%s", this, this->_writing.size(),
+                       sync ? " and sync" : "");
+            this->_write(this->_writing, sync);
+            auto const batch = this->_writing.size() > 0;
+            this->_writing.reset();
+            lock.lock();
+            if (batch)
+              ++this->_statistics.batches;
+            if (sync)
+            {
+              ++this->_statistics.syncs;
+              this->_synced = appended;
+            }
+            this->_written_available.notify_all();
+          }
+        }
+
+        void
+        Writer::_write(elle::Buffer const& batch, bool sync)
+        {
+          if (batch.size() > 0 &&
+              std::fwrite(batch.contents(), 1, batch.size(), this->_file)
+              != batch.size())
+            ELLE_ERR("%s: unable to write journal: %s",
+                     this, std::strerror(errno));
+#ifdef ELLE_WINDOWS
+          if (sync && ::_commit(::_fileno(this->_file)))
+#else
+          if (sync && ::fsync(::fileno(this->_file)))
+#endif
+            ELLE_ERR("%s: unable to sync journal: %s",
+                     this, std::strerror(errno));
+        }
+
+        /*-----.
+        | Push |
+        `-----*/
+
+        Writer::Push::Push(Writer& writer, Kind kind)
+          : _writer(&writer)
+          , _lock(writer._mutex)
+          , _start(writer._pending.size())
+        {
+          // The size is filled upon commit.
+          put_integer(writer._pending, std::uint32_t(0));
+          put_integer(writer._pending, std::uint8_t(kind));
+        }
+
+        Writer::Push::Push(Writer& writer,
+                           Kind kind,
+                           std::string const& operation,
+                           std::string const& path)
+          : Push(writer, kind)
+        {
+          put_integer(writer._pending, std::uint8_t('p'));
+          put_bytes(writer._pending, path);
+          put_bytes(writer._pending, operation);
+        }
+
+        Writer::Push::Push(Writer& writer,
+                           Kind kind,
+                           std::string const& operation,
+                           void const* handle)
+          : Push(writer, kind)
+        {
+          put_integer(writer._pending, std::uint8_t('h'));
+          put_integer(writer._pending, std::uint64_t(handle));
+          put_bytes(writer._pending, operation);
+        }
+
+        Writer::Push::Push(Push&& source)
+          : _writer(source._writer)
+          , _lock(std::move(source._lock))
+          , _start(source._start)
+        {
+          source._writer = nullptr;
+        }
+
+        Writer::Push::~Push()
+        {
+          if (!this->_writer)
+            return;
+          auto& writer = *this->_writer;
+          auto& pending = writer._pending;
+          auto const size = pending.size() - this->_start;
+          auto const size_ = std::uint32_t(size - sizeof(std::uint32_t));
+          for (unsigned i = 0; i < sizeof(size_); ++i)
+            pending.mutable_contents()[this->_start + i] =
+              std::uint8_t(size_ >> (8 * i));
+          writer._appended += size;
+          ++writer._statistics.records;
+          writer._statistics.bytes += size;
+          // Only wake the writer up when there is something new for it.
+          auto const threshold = writer._configuration.buffer_size / 2;
+          auto const notify = this->_start == 0 ||
+            (this->_start < threshold && pending.size() >= threshold);
+          this->_lock.unlock();
+          if (notify)
+            writer._pending_available.notify_one();
+        }
+
+        Writer::Push&
+        Writer::Push::operator ()(std::string const& name, bool value)
+        {
+          auto& pending = this->_writer->_pending;
+          put_bytes(pending, name);
+          put_integer(pending, std::uint8_t(Type::boolean));
+          put_integer(pending, std::uint8_t(value));
+          return *this;
+        }
+
+        Writer::Push&
+        Writer::Push::operator ()(std::string const& name,
+                                  std::string const& value)
+        {
+          auto& pending = this->_writer->_pending;
+          put_bytes(pending, name);
+          put_integer(pending, std::uint8_t(Type::string));
+          put_bytes(pending, value);
+          return *this;
+        }
+
+        Writer::Push&
+        Writer::Push::operator ()(std::string const& name, char const* value)
+        {
+          auto& pending = this->_writer->_pending;
+          put_bytes(pending, name);
+          put_integer(pending, std::uint8_t(Type::string));
+          put_bytes(pending, elle::ConstWeakBuffer(value, std::strlen(value)));
+          return *this;
+        }
+
+        Writer::Push&
+        Writer::Push::operator ()(std::string const& name,
+                                  elle::ConstWeakBuffer value)
+        {
+          auto& pending = this->_writer->_pending;
+          put_bytes(pending, name);
+          put_integer(pending, std::uint8_t(Type::buffer));
+          put_bytes(pending, value);
+          return *this;
+        }
+
+        Writer::Push&
+        Writer::Push::operator ()(std::string const& name,
+                                  std::vector<std::string> const& value)
+        {
+          auto& pending = this->_writer->_pending;
+          put_bytes(pending, name);
+          put_integer(pending, std::uint8_t(Type::strings));
+          put_integer(pending, std::uint32_t(value.size()));
+          for (auto const& s: value)
+            put_bytes(pending, s);
+          return *this;
+        }
+
+        Writer::Push&
+        Writer::Push::_integer(std::string const& name, std::int64_t value)
+        {
+          auto& pending = this->_writer->_pending;
+          put_bytes(pending, name);
+          put_integer(pending, std::uint8_t(Type::integer));
+          put_integer(pending, std::uint64_t(value));
+          return *this;
+        }
+
+        Writer::Push&
+        Writer::Push::_integer(std::string const& name, std::uint64_t value)
+        {
+          auto& pending = this->_writer->_pending;
+          put_bytes(pending, name);
+          put_integer(pending, std::uint8_t(Type::unsigned_integer));
+          put_integer(pending, value);
+          return *this;
+        }
+
+        /*-------.
+        | Reader |
+        `-------*/
+
+        Reader::Reader(std::istream& input)
+          : _input(input)
+        {
+          char header[sizeof(magic) - 1];
+          if (!this->_input.read(header, sizeof(header)) ||
+              !std::equal(header, header + sizeof(header), magic))
+            elle::err("not a filesystem journal");
+        }
+
+        boost::optional<Record>
+        Reader::next()
+        {
+          std::uint8_t size_bytes[sizeof(std::uint32_t)] = {};
+          this->_input.read(reinterpret_cast<char*>(size_bytes),
+                            sizeof(size_bytes));
+          if (this->_input.gcount() == 0)
+            return boost::none;
+          if (this->_input.gcount() != sizeof(size_bytes))
+          {
+            ELLE_WARN("ignore truncated filesystem journal record");
+            return boost::none;
+          }
+          auto const size = get_integer<std::uint32_t>(size_bytes);
+          auto data = elle::Buffer(size);
+          this->_input.read(reinterpret_cast<char*>(data.mutable_contents()),
+                            size);
+          if (this->_input.gcount() != std::streamsize(size))
+          {
+            ELLE_WARN("ignore truncated filesystem journal record");
+            return boost::none;
+          }
+          auto cursor = Cursor(data);
+          auto res = Record{};
+          auto const kind = cursor.integer<std::uint8_t>();
+          if (kind > std::uint8_t(Kind::out))
+            elle::err("invalid filesystem journal record kind: %s", int(kind));
+          res.kind = Kind(kind);
+          switch (auto const subject = cursor.integer<std::uint8_t>())
+          {
+            case 'p':
+              res.path = cursor.string();
+              break;
+            case 'h':
+              res.handle = cursor.integer<std::uint64_t>();
+              break;
+            default:
+              elle::err("invalid filesystem journal record subject: %s",
+                        int(subject));
+          }
+          res.operation = cursor.string();
+          while (!cursor.done())
+          {
+            auto name = cursor.string();
+            auto value = Value{};
+            switch (auto const type = cursor.integer<std::uint8_t>())
+            {
+              case Type::boolean:
+                value = bool(cursor.integer<std::uint8_t>());
+                break;
+              case Type::integer:
+                value = std::int64_t(cursor.integer<std::uint64_t>());
+                break;
+              case Type::unsigned_integer:
+                value = cursor.integer<std::uint64_t>();
+                break;
+              case Type::string:
+                value = cursor.string();
+                break;
+              case Type::buffer:
+                value = elle::Buffer(cursor.bytes());
+                break;
+              case Type::strings:
+              {
+                auto strings = std::vector<std::string>{};
+                auto count = cursor.integer<std::uint32_t>();
+                while (count--)
+                  strings.emplace_back(cursor.string());
+                value = std::move(strings);
+                break;
+              }
+              default:
+                elle::err("invalid filesystem journal field type: %s",
+                          int(type));
+            }
+            res.fields.emplace_back(std::move(name), std::move(value));
+          }
+          return res;
+        }
+      }
 
 #define REACTOR_FILESYSTEM_ERROR(name)                                  \
       catch (Error const& e)                                            \
@@ -29,62 +591,21 @@ namespace elle
 #define REACTOR_FILESYSTEM_HERROR(name)                                 \
       catch(Error const& e)                                             \
       {                                                                 \
-        bool fail = false;                                              \
-        int erc = e.error_code();                                       \
-        std::string message = e.what();                                 \
-        _owner.push_out(PushSerializer(this, name)("success", fail)     \
-                        ("code", erc)("message", message)());           \
+        _owner.journal().out(this, name)("success", false)              \
+          ("code", e.error_code())("message", e.what());                \
         throw;                                                          \
       }                                                                 \
 
-      class PushSerializer
-      {
-      public:
-        PushSerializer(std::string const& path, std::string const& op)
-        : ios(b.ostreambuf())
-        , _serializer(new elle::serialization::json::SerializerOut(ios))
-        {
-          _serializer->serialize("path", path);
-          _serializer->serialize("operation", op);
-        }
-        PushSerializer(void* handle, std::string const& op)
-        : ios(b.ostreambuf())
-        , _serializer(new elle::serialization::json::SerializerOut(ios))
-        {
-          std::string shandle = std::to_string((uint64_t)handle);
-          _serializer->serialize("handle", shandle);
-          _serializer->serialize("operation", op);
-        }
-        PushSerializer(PushSerializer const& b) = delete;
-        PushSerializer(PushSerializer&& b) = default;
-        template<typename T>
-        PushSerializer& operator()(std::string const& k, T& v)
-        {
-          _serializer->serialize(k, v);
-          return *this;
-        }
-        elle::Buffer
-        operator()()
-        {
-          _serializer.reset();
-          ios.flush();
-          return std::move(b);
-        }
-        elle::Buffer b;
-        elle::IOStream ios;
-        std::unique_ptr<elle::serialization::json::SerializerOut> _serializer;
-      };
-
       class JournalOperations: public Operations
       {
       public:
-        JournalOperations(std::unique_ptr<Operations> backend, std::string const& path)
-        : _backend(std::move(backend))
-        , _in_op(0)
-        {
-          _in.reset(new std::ofstream(path + "in"));
-          _out.reset(new std::ofstream(path + "out"));
-        }
+        JournalOperations(std::unique_ptr<Operations> backend,
+                          std::string const& path,
+                          journal::Writer::Configuration configuration)
+          : _backend(std::move(backend))
+          , _journal(path + "journal", std::move(configuration))
+          , _in_op(0)
+        {}
         void
         filesystem(FileSystem* fs) override
         {
@@ -97,33 +618,21 @@ namespace elle
         wrap(std::string const& path, std::shared_ptr<Path> in) override;
         void push_op(std::string const& path, std::string const& op)
         {
-          push_in(PushSerializer(path, op)());
+          this->_journal.in(path, op);
         }
         void push_ok(std::string const& path, std::string const& op)
         {
-          push_out(PushSerializer(path, op)("success", True)());
+          this->_journal.out(path, op)("success", true);
         }
         void push_fail(std::string const& path, std::string const& op,
                        int erc, std::string const& msg)
         {
-          bool False = false;
-          push_out(PushSerializer(path, op)("success", False)("code", erc)
-            ("message", msg)());
-        }
-        void push_out(elle::Buffer buf)
-        {
-          _out->write((const char*)buf.contents(), buf.size());
-          _out->flush();
-        }
-        void push_in(elle::Buffer buf)
-        {
-          _in->write((const char*)buf.contents(), buf.size());
-          _in->flush();
+          this->_journal.out(path, op)("success", false)("code", erc)
+            ("message", msg);
         }
       private:
         std::unique_ptr<Operations> _backend;
-        std::shared_ptr<std::ostream> _in;
-        std::shared_ptr<std::ostream> _out;
+        ELLE_ATTRIBUTE_X(journal::Writer, journal);
         ELLE_ATTRIBUTE_R(int, in_op);
         friend class InOp;
       };
@@ -144,7 +653,13 @@ namespace elle
       std::unique_ptr<Operations> install_journal(std::unique_ptr<Operations> backend,
                                                   std::string const& path)
       {
-        return std::make_unique<JournalOperations>(std::move(backend), path);
+        auto configuration = journal::Writer::Configuration{};
+        configuration.delay = boost::posix_time::milliseconds(
+          elle::os::getenv("INFINIT_FILESYSTEM_JOURNAL_DELAY", 0));
+        configuration.sync =
+          elle::os::getenv("INFINIT_FILESYSTEM_JOURNAL_SYNC", 0);
+        return std::make_unique<JournalOperations>(
+          std::move(backend), path, std::move(configuration));
       }
 
       class JournalHandle: public Handle
@@ -161,70 +676,59 @@ namespace elle
       public:
         ~JournalHandle() override
         {
-          _owner.push_in(
-            PushSerializer(this, "dispose")()
-          );
-          _owner.push_out(PushSerializer(this, "dispose")("success", True)());
+          _owner.journal().in(this, "dispose");
+          _owner.journal().out(this, "dispose")("success", true);
         }
         void close() override
         {
-          _owner.push_in(
-            PushSerializer(this, "close")()
-          );
+          _owner.journal().in(this, "close");
           try
           {
             _backend->close();
-            _owner.push_out(PushSerializer(this, "close")("success", True)());
+            _owner.journal().out(this, "close")("success", true);
           }
           REACTOR_FILESYSTEM_HERROR("close")
         }
         void fsyncdir(int datasync) override
         {
-          _owner.push_in(
-            PushSerializer(this, "fsyncdir")("datasync", datasync)()
-          );
+          _owner.journal().in(this, "fsyncdir")("datasync", datasync);
           try
           {
             _backend->fsyncdir(datasync);
-            _owner.push_out(PushSerializer(this, "fsyncdir")("success", True)());
+            _owner.journal().out(this, "fsyncdir")("success", true);
           }
           REACTOR_FILESYSTEM_HERROR("fsyncdir")
         }
         void fsync(int datasync) override
         {
-          _owner.push_in(
-            PushSerializer(this, "fsync")("datasync", datasync)()
-          );
+          _owner.journal().in(this, "fsync")("datasync", datasync);
           try
           {
             _backend->fsyncdir(datasync);
-            _owner.push_out(PushSerializer(this, "fsync")("success", True)());
+            _owner.journal().out(this, "fsync")("success", true);
           }
           REACTOR_FILESYSTEM_HERROR("fsync")
         }
         void ftruncate(off_t offset) override
         {
-          _owner.push_in(
-            PushSerializer(this, "ftruncate")("size", offset)()
-          );
+          _owner.journal().in(this, "ftruncate")("size", offset);
           try
           {
             _backend->ftruncate(offset);
-            _owner.push_out(PushSerializer(this, "ftruncate")("success", True)());
+            _owner.journal().out(this, "ftruncate")("success", true);
           }
           REACTOR_FILESYSTEM_HERROR("ftruncate")
         }
         int read(elle::WeakBuffer buffer, size_t size, off_t offset) override
         {
           auto size_ = uint64_t(size);
-          _owner.push_in(
-            PushSerializer(this, "read")("size", size_)("offset", offset)()
-          );
+          _owner.journal().in(this, "read")("size", size_)("offset", offset);
           try
           {
             int res = _backend->read(buffer, size, offset);
-            elle::Buffer buf(buffer.contents(), res);
-            _owner.push_out(PushSerializer(this, "read")("content", buf)("success", True)());
+            _owner.journal().out(this, "read")
+              ("content", elle::ConstWeakBuffer(buffer.contents(), res))
+              ("success", true);
             return res;
           }
           REACTOR_FILESYSTEM_HERROR("read")
@@ -233,15 +737,13 @@ namespace elle
         int
         write(elle::ConstWeakBuffer buffer, size_t size, off_t offset) override
         {
-          elle::Buffer buf(buffer.contents(), buffer.size());
           auto size_ = uint64_t(size);
-          _owner.push_in(
-            PushSerializer(this, "write")("size", size_)("offset", offset)("content", buf)()
-          );
+          _owner.journal().in(this, "write")("size", size_)("offset", offset)
+            ("content", buffer);
           try
           {
             int res = _backend->write(buffer, size, offset);
-            _owner.push_out(PushSerializer(this, "write")("success", True)());
+            _owner.journal().out(this, "write")("success", true);
             return res;
           }
           REACTOR_FILESYSTEM_HERROR("write")
@@ -273,44 +775,28 @@ namespace elle
         std::unique_ptr<Handle> create(int flags, mode_t mode) override
         {
           InOp inop(_owner);
-          void* h = nullptr;
-          elle::SafeFinally pushin([&] {
-              std::string shandle = std::to_string((uint64_t)h);
-              _owner.push_in(
-                PushSerializer(_full_path, "create")("mode", mode)("flags", flags)
-                ("handle", shandle)
-                ()
-            );
-          });
+          _owner.journal().in(_full_path, "create")("mode", mode)("flags", flags);
           try
           {
             auto bh = _backend->create(flags, mode);
             auto handle = std::make_unique<JournalHandle>(_owner, std::move(bh));
-            h = handle.get();
-            _owner.push_ok(_full_path, "create");
-            return std::move(handle);
+            _owner.journal().out(_full_path, "create")("success", true)
+              ("handle", std::to_string((uint64_t)handle.get()));
+            return handle;
           }
           REACTOR_FILESYSTEM_ERROR("create")
         }
         std::unique_ptr<Handle> open(int flags, mode_t mode) override
         {
           InOp inop(_owner);
-          void* h = nullptr;
-          elle::SafeFinally pushin([&] {
-              std::string shandle = std::to_string((uint64_t)h);
-              _owner.push_in(
-                PushSerializer(_full_path, "open")("mode", mode)("flags", flags)
-                ("handle", shandle)
-                ()
-            );
-          });
+          _owner.journal().in(_full_path, "open")("mode", mode)("flags", flags);
           try
           {
             auto bh = _backend->open(flags, mode);
             auto handle = std::make_unique<JournalHandle>(_owner, std::move(bh));
-            h = handle.get();
-            _owner.push_ok(_full_path, "open");
-            return std::move(handle);
+            _owner.journal().out(_full_path, "open")("success", true)
+              ("handle", std::to_string((uint64_t)handle.get()));
+            return handle;
           }
           REACTOR_FILESYSTEM_ERROR("open")
         }
@@ -322,39 +808,30 @@ namespace elle
           try
           {
             _backend->stat(s);
-            elle::Buffer buf;
-            {
-              elle::IOStream ios(buf.ostreambuf());
-              elle::serialization::json::SerializerOut response(ios);
-              response.serialize("success", true);
-              response.serialize("operation", "stat");
-              response.serialize("path"      , this->_full_path);
-              response.serialize("st_dev"    , s->st_dev    );
-              response.serialize("st_ino"    , s->st_ino    );
-              response.serialize("st_mode"   , s->st_mode   );
-              response.serialize("st_nlink"  , s->st_nlink  );
-              response.serialize("st_uid"    , s->st_uid    );
-              response.serialize("st_gid"    , s->st_gid    );
-              response.serialize("st_rdev"   , s->st_rdev   );
-              response.serialize("st_size"   , int64_t(s->st_size));
+            _owner.journal().out(_full_path, "stat")
+              ("success"   , true)
+              ("st_dev"    , s->st_dev    )
+              ("st_ino"    , s->st_ino    )
+              ("st_mode"   , s->st_mode   )
+              ("st_nlink"  , s->st_nlink  )
+              ("st_uid"    , s->st_uid    )
+              ("st_gid"    , s->st_gid    )
+              ("st_rdev"   , s->st_rdev   )
+              ("st_size"   , int64_t(s->st_size))
 #ifndef ELLE_WINDOWS
-              response.serialize("st_blksize", int64_t(s->st_blksize));
-              response.serialize("st_blocks" , s->st_blocks );
+              ("st_blksize", int64_t(s->st_blksize))
+              ("st_blocks" , s->st_blocks )
 #endif
-              response.serialize("st_atime"  , uint64_t(s->st_atime));
-              response.serialize("st_mtime"  , uint64_t(s->st_mtime));
-              response.serialize("st_ctime"  , uint64_t(s->st_ctime));
-            }
-            _owner.push_out(buf);
+              ("st_atime"  , uint64_t(s->st_atime))
+              ("st_mtime"  , uint64_t(s->st_mtime))
+              ("st_ctime"  , uint64_t(s->st_ctime));
           }
           REACTOR_FILESYSTEM_ERROR("stat");
         }
         void mkdir(mode_t mode) override
         {
           InOp inop(_owner);
-          _owner.push_in(
-            PushSerializer(_full_path, "mkdir")("mode", mode)()
-          );
+          _owner.journal().in(_full_path, "mkdir")("mode", mode);
           try
           {
             _backend->mkdir(mode);
@@ -383,9 +860,9 @@ namespace elle
                 cb(name, st);
                 content.push_back(name);
             });
-            _owner.push_out(PushSerializer(_full_path, "list_directory")
-              ("success", True)
-              ("entries", content)());
+            _owner.journal().out(_full_path, "list_directory")
+              ("success", true)
+              ("entries", content);
           }
           REACTOR_FILESYSTEM_ERROR("list_directory");
         }
@@ -403,9 +880,7 @@ namespace elle
         void rename(bfs::path const& where) override
         {
           InOp inop(_owner);
-          _owner.push_in(
-            PushSerializer(_full_path, "rename")("target", where.string())()
-          );
+          _owner.journal().in(_full_path, "rename")("target", where.string());
           try
           {
             _backend->rename(where);
@@ -420,9 +895,9 @@ namespace elle
           try
           {
             auto res = _backend->readlink();
-            _owner.push_out(PushSerializer(_full_path, "readlink")
-              ("success", True)
-              ("target", res.string())());
+            _owner.journal().out(_full_path, "readlink")
+              ("success", true)
+              ("target", res.string());
             return res;
           }
           REACTOR_FILESYSTEM_ERROR("readlink");
@@ -430,9 +905,7 @@ namespace elle
         void symlink(bfs::path const& where) override
         {
           InOp inop(_owner);
-          _owner.push_in(
-            PushSerializer(_full_path, "symlink")("target", where.string())()
-          );
+          _owner.journal().in(_full_path, "symlink")("target", where.string());
           try
           {
             _backend->symlink(where);
@@ -444,9 +917,7 @@ namespace elle
         {
           ELLE_DEBUG("journal_link");
           InOp inop(_owner);
-          _owner.push_in(
-            PushSerializer(_full_path, "link")("target", where.string())()
-          );
+          _owner.journal().in(_full_path, "link")("target", where.string());
           try
           {
             _backend->link(where);
@@ -457,9 +928,7 @@ namespace elle
         void chmod(mode_t mode) override
         {
           InOp inop(_owner);
-          _owner.push_in(
-            PushSerializer(_full_path, "chmod")("mode", mode)()
-          );
+          _owner.journal().in(_full_path, "chmod")("mode", mode);
           try
           {
             _backend->chmod(mode);
@@ -470,9 +939,7 @@ namespace elle
         void chown(int uid, int gid) override
         {
           InOp inop(_owner);
-          _owner.push_in(
-            PushSerializer(_full_path, "chown")("uid", uid)("gid", gid)()
-          );
+          _owner.journal().in(_full_path, "chown")("uid", uid)("gid", gid);
           try
           {
             _backend->chown(uid, gid);
@@ -487,24 +954,19 @@ namespace elle
           try
           {
             _backend->statfs(st);
-            elle::Buffer buf;
-            {
-              elle::IOStream ios(buf.ostreambuf());
-              elle::serialization::json::SerializerOut response(ios);
-              response.serialize("success", true);
-              response.serialize("f_bsize",   uint64_t(st->f_bsize));
-              response.serialize("f_frsize",  uint64_t(st->f_frsize));
-              response.serialize("f_blocks",  uint64_t(st->f_blocks));
-              response.serialize("f_bfree",   uint64_t(st->f_bfree));
-              response.serialize("f_bavail",  uint64_t(st->f_bavail));
-              response.serialize("f_files",   uint64_t(st->f_files));
-              response.serialize("f_ffree",   uint64_t(st->f_ffree));
-              response.serialize("f_favail",  uint64_t(st->f_favail));
-              response.serialize("f_fsid",    uint64_t(st->f_fsid));
-              response.serialize("f_flag",    uint64_t(st->f_flag));
-              response.serialize("f_namemax", uint64_t(st->f_namemax));
-            }
-            _owner.push_out(buf);
+            _owner.journal().out(_full_path, "statfs")
+              ("success",   true)
+              ("f_bsize",   uint64_t(st->f_bsize))
+              ("f_frsize",  uint64_t(st->f_frsize))
+              ("f_blocks",  uint64_t(st->f_blocks))
+              ("f_bfree",   uint64_t(st->f_bfree))
+              ("f_bavail",  uint64_t(st->f_bavail))
+              ("f_files",   uint64_t(st->f_files))
+              ("f_ffree",   uint64_t(st->f_ffree))
+              ("f_favail",  uint64_t(st->f_favail))
+              ("f_fsid",    uint64_t(st->f_fsid))
+              ("f_flag",    uint64_t(st->f_flag))
+              ("f_namemax", uint64_t(st->f_namemax));
           }
           REACTOR_FILESYSTEM_ERROR("statfs");
         }
@@ -513,9 +975,7 @@ namespace elle
           InOp inop(_owner);
           uint64_t ta = tv[0].tv_sec * 1000000000ULL + tv[0].tv_nsec;
           uint64_t tc = tv[1].tv_sec * 1000000000ULL + tv[1].tv_nsec;
-          _owner.push_in(
-            PushSerializer(_full_path, "utimens")("access", ta)("change", tc)()
-          );
+          _owner.journal().in(_full_path, "utimens")("access", ta)("change", tc);
           try
           {
             _backend->utimens(tv);
@@ -526,9 +986,7 @@ namespace elle
         void truncate(off_t new_size) override
         {
           InOp inop(_owner);
-          _owner.push_in(
-            PushSerializer(_full_path, "truncate")("size", new_size)()
-          );
+          _owner.journal().in(_full_path, "truncate")("size", new_size);
           try
           {
             _backend->truncate(new_size);
@@ -540,9 +998,7 @@ namespace elle
                               int flags) override
         {
           InOp inop(_owner);
-          _owner.push_in(
-            PushSerializer(_full_path, "setxattr")("name", name)("value", value)()
-          );
+          _owner.journal().in(_full_path, "setxattr")("name", name)("value", value);
           try
           {
             _backend->setxattr(name, value, flags);
@@ -553,15 +1009,13 @@ namespace elle
         std::string getxattr(std::string const& name) override
         {
           InOp inop(_owner);
-          _owner.push_in(
-            PushSerializer(_full_path, "getxattr")("name", name)()
-          );
+          _owner.journal().in(_full_path, "getxattr")("name", name);
           try
           {
             auto res = _backend->getxattr(name);
-            _owner.push_out(PushSerializer(_full_path, "getxattr")
-              ("success", True)
-              ("value", res)());
+            _owner.journal().out(_full_path, "getxattr")
+              ("success", true)
+              ("value", res);
             return res;
           }
           REACTOR_FILESYSTEM_ERROR("getxattr")
@@ -573,8 +1027,8 @@ namespace elle
           try
           {
             auto res = _backend->listxattr();
-            _owner.push_out(PushSerializer(_full_path, "listxattr")
-              ("entries", res)("success", True)());
+            _owner.journal().out(_full_path, "listxattr")
+              ("entries", res)("success", true);
             return res;
           }
           REACTOR_FILESYSTEM_ERROR("listxattr");
@@ -582,9 +1036,7 @@ namespace elle
         void removexattr(std::string const& name) override
         {
           InOp inop(_owner);
-           _owner.push_in(
-             PushSerializer(_full_path, "removexattr")("name", name)()
-           );
+           _owner.journal().in(_full_path, "removexattr")("name", name);
            try
            {
              _backend->removexattr(name);
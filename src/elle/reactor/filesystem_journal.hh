@@ -0,0 +1,216 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/optional.hpp>
+#include <boost/variant.hpp>
+
+#include <elle/Buffer.hh>
+#include <elle/attribute.hh>
+#include <elle/reactor/duration.hh>
+
+namespace elle
+{
+  namespace reactor
+  {
+    namespace filesystem
+    {
+      /// Binary journal of filesystem operations.
+      ///
+      /// A journal file starts with a magic header followed by records:
+      ///
+      ///   record  := size:u32 kind:u8 subject operation:string field*
+      ///   subject := 'p' path:string | 'h' handle:u64
+      ///   field   := name:string type:u8 value
+      ///   string  := size:u32 bytes
+      ///
+      /// where integers are little endian and size counts the bytes following
+      /// it. Records are appended to a preallocated buffer and written by a
+      /// background thread, so that all records pushed while a batch is being
+      /// written end up in the next one (group commit).
+      namespace journal
+      {
+        /// Whether a record is an operation or its outcome.
+        enum class Kind: std::uint8_t
+        {
+          in = 0,
+          out = 1,
+        };
+
+        /// A field value, as read back from a journal.
+        using Value = boost::variant<bool,
+                                     std::int64_t,
+                                     std::uint64_t,
+                                     std::string,
+                                     elle::Buffer,
+                                     std::vector<std::string>>;
+
+        /// A record, as read back from a journal.
+        struct Record
+        {
+          Kind kind;
+          std::string operation;
+          boost::optional<std::string> path;
+          boost::optional<std::uint64_t> handle;
+          std::vector<std::pair<std::string, Value>> fields;
+          /// Print the JSON view of the record, as it was journaled before
+          /// the binary format.
+          void
+          json(std::ostream& output) const;
+        };
+
+        /*-------.
+        | Writer |
+        `-------*/
+
+        class Writer
+        {
+        public:
+          struct Configuration
+          {
+            /// One megabyte buffers, no delay, no fsync.
+            Configuration();
+            /// Initial capacity of the append buffers.
+            std::size_t buffer_size;
+            /// How long to gather records before writing a batch.
+            Duration delay;
+            /// Number of batches between fsyncs, 0 to never fsync.
+            int sync;
+          };
+
+          struct Statistics
+          {
+            std::size_t records;
+            std::size_t bytes;
+            std::size_t batches;
+            std::size_t syncs;
+          };
+
+          /// A record being appended.
+          ///
+          /// The journal is locked from construction until the record is
+          /// committed upon destruction: do not yield in between.
+          class Push
+          {
+          public:
+            Push(Writer& writer, Kind kind, std::string const& operation,
+                 std::string const& path);
+            Push(Writer& writer, Kind kind, std::string const& operation,
+                 void const* handle);
+            Push(Push&& source);
+            ~Push();
+            Push&
+            operator ()(std::string const& name, bool value);
+            Push&
+            operator ()(std::string const& name, std::string const& value);
+            /// Not a bool.
+            Push&
+            operator ()(std::string const& name, char const* value);
+            Push&
+            operator ()(std::string const& name, elle::ConstWeakBuffer value);
+            Push&
+            operator ()(std::string const& name,
+                        std::vector<std::string> const& value);
+            template <typename T>
+            std::enable_if_t<std::is_integral<T>::value &&
+                             !std::is_same<T, bool>::value, Push&>
+            operator ()(std::string const& name, T value)
+            {
+              if (std::is_signed<T>::value)
+                return this->_integer(name, std::int64_t(value));
+              else
+                return this->_integer(name, std::uint64_t(value));
+            }
+          private:
+            Push(Writer& writer, Kind kind);
+            Push&
+            _integer(std::string const& name, std::int64_t value);
+            Push&
+            _integer(std::string const& name, std::uint64_t value);
+            ELLE_ATTRIBUTE(Writer*, writer);
+            ELLE_ATTRIBUTE(std::unique_lock<std::mutex>, lock);
+            ELLE_ATTRIBUTE(std::size_t, start);
+          };
+
+          /// Create or append to the journal at @a path.
+          Writer(std::string const& path, Configuration configuration = Configuration());
+          Writer(Writer const&) = delete;
+          /// Write pending records, and sync them unless syncing is disabled.
+          ~Writer();
+          /// Start an operation record.
+          Push
+          in(std::string const& path, std::string const& operation);
+          Push
+          in(void const* handle, std::string const& operation);
+          /// Start an outcome record.
+          Push
+          out(std::string const& path, std::string const& operation);
+          Push
+          out(void const* handle, std::string const& operation);
+          /// Block until all records pushed so far are written and synced.
+          ///
+          /// This blocks the whole scheduler, it is meant for tests and
+          /// shutdown.
+          void
+          flush();
+          Statistics
+          statistics() const;
+          ELLE_ATTRIBUTE_R(Configuration, configuration);
+        private:
+          void
+          _run();
+          void
+          _write(elle::Buffer const& batch, bool sync);
+          ELLE_ATTRIBUTE(std::FILE*, file);
+          ELLE_ATTRIBUTE(mutable std::mutex, mutex);
+          /// Signaled when records are pending.
+          ELLE_ATTRIBUTE(std::condition_variable, pending_available);
+          /// Signaled when a batch is written.
+          ELLE_ATTRIBUTE(std::condition_variable, written_available);
+          /// Records being appended.
+          ELLE_ATTRIBUTE(elle::Buffer, pending);
+          /// Records being written.
+          ELLE_ATTRIBUTE(elle::Buffer, writing);
+          /// Bytes appended and synced, to know when a flush is done.
+          ELLE_ATTRIBUTE(std::uint64_t, appended);
+          ELLE_ATTRIBUTE(std::uint64_t, synced);
+          ELLE_ATTRIBUTE(bool, sync_requested);
+          ELLE_ATTRIBUTE(bool, stop);
+          ELLE_ATTRIBUTE(Statistics, statistics);
+          ELLE_ATTRIBUTE(std::thread, thread);
+        };
+
+        /*-------.
+        | Reader |
+        `-------*/
+
+        class Reader
+        {
+        public:
+          /// Read the journal from @a input.
+          ///
+          /// @throw elle::Error if @a input is not a journal.
+          Reader(std::istream& input);
+          /// The next record, if any.
+          ///
+          /// A truncated last record, as left by a crash, ends the journal.
+          ///
+          /// @throw elle::Error if the journal is corrupted.
+          boost::optional<Record>
+          next();
+        private:
+          ELLE_ATTRIBUTE(std::istream&, input);
+        };
+      }
+    }
+  }
+}
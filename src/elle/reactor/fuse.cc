@@ -209,6 +209,7 @@ namespace elle
           ELLE_TRACE("Processing new request");
           fuse_session_process(
             s, (const char*)buf.mutable_contents(), buf.size(), ch);
+          this->_recycle(std::move(buf));
           ELLE_TRACE("Back to the pool");
         }
       };
@@ -241,13 +242,15 @@ namespace elle
         if (fuse_exited(this->_fuse))
           break;
         ELLE_DUMP("Processing command");
-        elle::Buffer buf;
-        buf.size(buffer_size);
+        auto buf = this->_buffer(buffer_size);
         int res = -EINTR;
         while(res == -EINTR)
           res = fuse_chan_recv(&ch, (char*)buf.mutable_contents(), buf.size());
         if (res == -EAGAIN)
+        {
+          this->_recycle(std::move(buf));
           continue;
+        }
         if (res <= 0)
         {
           if (res < 0)
@@ -290,7 +293,6 @@ namespace elle
       socket.assign(fd);
 #endif
       auto lock = this->_mt_barrier.lock();
-      void* buffer_data = malloc(buffer_size);
       while (!fuse_exited(this->_fuse))
       {
 #ifndef ELLE_MACOS
@@ -308,30 +310,35 @@ namespace elle
         if (fuse_exited(this->_fuse))
           break;
         ELLE_DUMP("Processing command");
+        // Receive straight into the buffer handed over to the worker.
+        auto buf = this->_buffer(buffer_size);
         int res = -EINTR;
         while(res == -EINTR)
-          res = fuse_chan_recv(&ch, (char*)buffer_data, buffer_size);
+          res = fuse_chan_recv(&ch, (char*)buf.mutable_contents(), buf.size());
         if (res == -EAGAIN)
+        {
+          this->_recycle(std::move(buf));
           continue;
+        }
         if (res <= 0)
         {
           if (res < 0)
             ELLE_LOG("%s: %s", res, strerror(-res));
           break;
         }
-        void* b2 = malloc(res);
-        memcpy(b2, buffer_data, res);
+        buf.size(res);
 #ifdef ELLE_MACOS
         std::unique_lock<std::mutex> mutex_lock(this->_mutex);
 #endif
         this->_workers.push_back(new Thread(
           sched,
           "fuse worker",
-          [s, b2, res, ch, this]
+          [s, buf = std::move(buf), ch, this] () mutable
           {
             auto lock = this->_mt_barrier.lock();
-            fuse_session_process(s, (const char*)b2, res, ch);
-            free(b2);
+            fuse_session_process(
+              s, (const char*)buf.contents(), buf.size(), ch);
+            this->_recycle(std::move(buf));
 #ifdef ELLE_MACOS
             std::unique_lock<std::mutex> mutex_lock(this->_mutex);
 #endif
@@ -351,6 +358,41 @@ namespace elle
 #endif
     }
 
+    /*----------------.
+    | Request buffers |
+    `----------------*/
+
+    namespace
+    {
+      /// How many idle request buffers to keep. FUSE buffers are over 128k
+      /// each, only keep enough for a burst of parallel requests.
+      std::size_t constexpr buffers_max = 32;
+    }
+
+    elle::Buffer
+    FuseContext::_buffer(std::size_t size)
+    {
+      auto res = elle::Buffer();
+      {
+        std::unique_lock<std::mutex> lock(this->_buffers_mutex);
+        if (!this->_buffers.empty())
+        {
+          res = std::move(this->_buffers.back());
+          this->_buffers.pop_back();
+        }
+      }
+      res.size(size);
+      return res;
+    }
+
+    void
+    FuseContext::_recycle(elle::Buffer buffer)
+    {
+      std::unique_lock<std::mutex> lock(this->_buffers_mutex);
+      if (this->_buffers.size() < buffers_max)
+        this->_buffers.emplace_back(std::move(buffer));
+    }
+
     void
     FuseContext::create(std::string const& mountpoint,
                         std::vector<std::string> const& arguments,
@@ -4,6 +4,7 @@
 #include <vector>
 #include <thread>
 
+#include <elle/Buffer.hh>
 #include <elle/reactor/Barrier.hh>
 #include <elle/reactor/scheduler.hh>
 #include <elle/reactor/MultiLockBarrier.hh>
@@ -51,6 +52,13 @@ namespace elle
       _loop_mt(Scheduler&);
       void
       _loop_pool(int threads, Scheduler&);
+      /// A request buffer of @a size bytes, reused from a previous request if
+      /// possible.
+      elle::Buffer
+      _buffer(std::size_t size);
+      /// Give back a request buffer once processed.
+      void
+      _recycle(elle::Buffer buffer);
 
 #if defined ELLE_MACOS
       void
@@ -65,6 +73,8 @@ namespace elle
       std::unique_ptr<std::thread> _loop_thread;
       std::vector<reactor::Thread*> _workers;
       std::mutex _mutex;
+      std::vector<elle::Buffer> _buffers;
+      std::mutex _buffers_mutex;
     };
   }
 }
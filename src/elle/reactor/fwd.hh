@@ -13,8 +13,10 @@ namespace elle
   namespace reactor
   {
     class Barrier;
+    class IOUring;
     class Mutex;
     class Operation;
+    enum class Priority;
     class Scheduler;
     class Semaphore;
     class Signal;
@@ -11,8 +11,12 @@ namespace elle
         Super(message)
       {}
 
+      Error::Error(elle::Backtrace bt, std::string const& message)
+        : Super(std::move(bt), message)
+      {}
+
       SocketClosed::SocketClosed()
-        : Super("socket was closed")
+        : Super(elle::Backtrace(), "socket was closed")
       {}
 
       ConnectionRefused::ConnectionRefused()
@@ -28,11 +32,12 @@ namespace elle
       {}
 
       ConnectionClosed::ConnectionClosed()
-        : Super("connection closed")
+        : Super(elle::Backtrace(), "connection closed")
       {}
 
       ConnectionClosed::ConnectionClosed(std::string const& message)
-        : Super(elle::sprintf("connection closed: %s", message))
+        : Super(elle::Backtrace(),
+                elle::sprintf("connection closed: %s", message))
       {}
 
       SSLShortRead::SSLShortRead()
@@ -54,7 +59,7 @@ namespace elle
       {}
 
       TimeOut::TimeOut():
-        Super("network operation timed out")
+        Super(elle::Backtrace(), "network operation timed out")
       {}
     }
   }
@@ -16,11 +16,13 @@ namespace elle
       public:
         using Super = elle::Error;
         Error(std::string const& message);
+        Error(elle::Backtrace bt, std::string const& message);
       };
 
       using Exception [[deprecated("use elle::reactor::Error instead")]]
       = Error;
 
+      /// Routine, no Backtrace is captured.
       class SocketClosed
         : public Error
       {
@@ -53,6 +55,7 @@ namespace elle
         InvalidEndpoint(std::string const& message);
       };
 
+      /// Routine, no Backtrace is captured.
       class ConnectionClosed
         : public Error
       {
@@ -98,6 +101,7 @@ namespace elle
         SSLHandshakeError(std::string const& message);
       };
 
+      /// Routine, no Backtrace is captured.
       class TimeOut
         : public Error
       {
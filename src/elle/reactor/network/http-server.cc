@@ -1,7 +1,10 @@
+#include <sstream>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/join.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include <elle/metrics.hh>
 #include <elle/os/environ.hh>
 #include <elle/reactor/network/Error.hh>
 #include <elle/reactor/network/http-server.hh>
@@ -254,6 +257,11 @@ namespace elle
               expected_length(2);
               headers["Connection"] = words[1];
             }
+            else if (words[0] == "Range:")
+            {
+              expected_length(2);
+              headers["Range"] = words[1];
+            }
           }
 
           ELLE_TRACE("%s: cookies: %s", *this, cookies);
@@ -340,6 +348,21 @@ namespace elle
         this->_routes[route][method] = function;
       }
 
+      void
+      HttpServer::register_metrics(std::string const& route)
+      {
+        this->register_route(
+          route,
+          http::Method::GET,
+          [] (Headers const&, Cookies const&, Parameters const&,
+              elle::Buffer const&)
+          {
+            std::stringstream output;
+            metrics::prometheus(output, metrics::registry().snapshot());
+            return output.str();
+          });
+      }
+
       bool
       HttpServer::is_json(Headers const& headers) const
       {
@@ -193,6 +193,12 @@ namespace elle
         register_route(std::string const& route,
                        http::Method method,
                        Function const& function);
+        /// Serve a snapshot of elle::metrics::registry on GET @a route, in
+        /// Prometheus text exposition format.
+        ///
+        /// \param route The route.
+        void
+        register_metrics(std::string const& route = "/metrics");
         /// Check if content-type is application/json.
         ///
         /// \param headers The headers of the Request.
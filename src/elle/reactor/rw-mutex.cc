@@ -1,7 +1,13 @@
+#include <algorithm>
+#include <memory>
+#include <thread>
+
 #include <elle/assert.hh>
+#include <elle/finally.hh>
 #include <elle/log.hh>
 #include <elle/reactor/rw-mutex.hh>
 #include <elle/reactor/scheduler.hh>
+#include <elle/reactor/signal.hh>
 #include <elle/reactor/Thread.hh>
 
 ELLE_LOG_COMPONENT("elle.reactor.RWMutex");
@@ -10,6 +16,18 @@ namespace elle
 {
   namespace reactor
   {
+    namespace
+    {
+      /// Wait a bit, outside of a Scheduler.
+      void
+      pause(int& attempts)
+      {
+        if (attempts++ < 64)
+          std::this_thread::yield();
+        else
+          std::this_thread::sleep_for(std::chrono::microseconds(100));
+      }
+    }
 
     /*-------.
     | Signal |
@@ -213,5 +231,149 @@ namespace elle
     {
       return _write;
     }
+
+    /*------------.
+    | SharedMutex |
+    `------------*/
+
+    struct SharedMutex::Waiter
+    {
+      Scheduler& scheduler;
+      Signal released;
+    };
+
+    SharedMutex::SharedMutex()
+      : _readers()
+      , _writing(false)
+      , _waiters_mutex()
+      , _waiters()
+      , _parked(0)
+    {}
+
+    template <typename Ready>
+    void
+    SharedMutex::_wait(Ready ready)
+    {
+      if (ready())
+        return;
+      auto const sched = Scheduler::scheduler();
+      if (!sched || !sched->current())
+      {
+        auto attempts = 0;
+        do
+          pause(attempts);
+        while (!ready());
+        return;
+      }
+      auto waiter = std::make_shared<Waiter>(Waiter{*sched, Signal{}});
+      {
+        std::lock_guard<std::mutex> lock(this->_waiters_mutex);
+        this->_waiters.emplace_back(waiter);
+      }
+      ++this->_parked;
+      elle::SafeFinally unpark([&]
+        {
+          std::lock_guard<std::mutex> lock(this->_waiters_mutex);
+          this->_waiters.erase(
+            std::find(this->_waiters.begin(), this->_waiters.end(), waiter));
+          --this->_parked;
+        });
+      // A release from our Scheduler cannot slip between the check and the
+      // wait, and the wake up of other system threads is only delivered once
+      // we wait.
+      while (!ready())
+        reactor::wait(waiter->released);
+    }
+
+    void
+    SharedMutex::_wake()
+    {
+      if (!this->_parked.load())
+        return;
+      auto const sched = Scheduler::scheduler();
+      std::lock_guard<std::mutex> lock(this->_waiters_mutex);
+      for (auto const& waiter: this->_waiters)
+        if (&waiter->scheduler == sched)
+          waiter->released.signal();
+        else
+          // The waiter is parked on another system thread: signal it from
+          // there, unless it is gone meanwhile.
+          waiter->scheduler.io_service().post(
+            [w = std::weak_ptr<Waiter>(waiter)]
+            {
+              if (auto waiter = w.lock())
+                waiter->released.signal();
+            });
+    }
+
+    void
+    SharedMutex::lock()
+    {
+      this->_wait([this]
+        {
+          auto writing = false;
+          return this->_writing.compare_exchange_strong(writing, true);
+        });
+      // From now on, readers wait behind us.
+      try
+      {
+        this->_wait([this] { return this->_readers.empty(); });
+      }
+      catch (...)
+      {
+        // Let readers in again if we are terminated meanwhile.
+        this->_writing.store(false);
+        this->_wake();
+        throw;
+      }
+    }
+
+    bool
+    SharedMutex::try_lock()
+    {
+      auto writing = false;
+      if (!this->_writing.compare_exchange_strong(writing, true))
+        return false;
+      if (this->_readers.empty())
+        return true;
+      this->_writing.store(false);
+      this->_wake();
+      return false;
+    }
+
+    void
+    SharedMutex::unlock()
+    {
+      this->_writing.store(false);
+      this->_wake();
+    }
+
+    void
+    SharedMutex::lock_shared()
+    {
+      this->_wait([this]
+        {
+          return !this->_writing.load() && this->try_lock_shared();
+        });
+    }
+
+    bool
+    SharedMutex::try_lock_shared()
+    {
+      auto& slot = this->_readers.mine();
+      // See threading::read_mutex::try_lock.
+      slot.fetch_add(1);
+      if (!this->_writing.load())
+        return true;
+      slot.fetch_sub(1);
+      return false;
+    }
+
+    void
+    SharedMutex::unlock_shared()
+    {
+      this->_readers.mine().fetch_sub(1);
+      this->_wake();
+    }
   }
 }
@@ -1,7 +1,13 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include <elle/attribute.hh>
 #include <elle/reactor/mutex.hh>
+#include <elle/threading/rw-mutex.hh>
 
 namespace elle
 {
@@ -59,5 +65,67 @@ namespace elle
       WriteMutex _write;
       ELLE_ATTRIBUTE_R(int, readers);
     };
+
+    /// A read/write lock shared by reactor threads and system threads.
+    ///
+    /// Unlike RWMutex, which only synchronizes the threads of one Scheduler,
+    /// it can be locked from any system thread, e.g. to protect a cache read
+    /// from several schedulers and background operations. Like
+    /// threading::rw_mutex, readers count themselves in threading::reader_slots
+    /// and a waiting writer has precedence over new readers.
+    ///
+    /// Waiting never blocks the system thread of a reactor thread: it parks
+    /// until the lock is released, letting the other reactor threads of its
+    /// Scheduler run, among which possibly the owner. Releases from other
+    /// system threads wake it through its Scheduler. Outside of a Scheduler,
+    /// the waiting thread polls, yielding its processor then backing off to
+    /// short sleeps.
+    ///
+    /// It satisfies the standard SharedMutex requirements.
+    ///
+    /// @code{.cc}
+    ///
+    /// std::shared_lock<reactor::SharedMutex> read(mutex);
+    /// std::unique_lock<reactor::SharedMutex> write(mutex);
+    ///
+    /// @endcode
+    class ELLE_API SharedMutex
+    {
+    public:
+      SharedMutex();
+      SharedMutex(SharedMutex const&) = delete;
+      /// Lock for writing.
+      void
+      lock();
+      bool
+      try_lock();
+      void
+      unlock();
+      /// Lock for reading.
+      void
+      lock_shared();
+      bool
+      try_lock_shared();
+      void
+      unlock_shared();
+
+    private:
+      /// Wait until \a ready returns true.
+      template <typename Ready>
+      void
+      _wait(Ready ready);
+      /// Wake the parked reactor threads.
+      void
+      _wake();
+      ELLE_ATTRIBUTE(threading::reader_slots, readers);
+      /// Whether a writer holds or waits for the lock.
+      ELLE_ATTRIBUTE(std::atomic<bool>, writing);
+      /// A parked reactor thread.
+      struct Waiter;
+      ELLE_ATTRIBUTE(std::mutex, waiters_mutex);
+      ELLE_ATTRIBUTE(std::vector<std::shared_ptr<Waiter>>, waiters);
+      /// Number of parked reactor threads, to skip locking when releasing.
+      ELLE_ATTRIBUTE(std::atomic<int>, parked);
+    };
   }
 }
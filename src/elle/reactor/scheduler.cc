@@ -1,7 +1,10 @@
+#include <algorithm>
+
 #include <elle/Measure.hh>
 #include <elle/Plugin.hh>
 #include <elle/assert.hh>
 #include <elle/attribute.hh>
+#include <elle/err.hh>
 #include <elle/finally.hh>
 #include <elle/find.hh>
 #include <elle/log.hh>
@@ -9,6 +12,7 @@
 #include <elle/memory.hh>
 #include <elle/os/environ.hh>
 #include <elle/reactor/BackgroundOperation.hh>
+#include <elle/reactor/Barrier.hh>
 #include <elle/reactor/backend/backend.hh>
 #if defined REACTOR_CORO_BACKEND_IO
 # include <elle/reactor/backend/coro_io/backend.hh>
@@ -45,12 +49,19 @@ namespace elle
       : _done(false)
       , _shallstop(false)
       , _current(nullptr)
-      , _background_service_work(
-           std::make_unique<boost::asio::io_service::work>(this->_background_service))
-      , _background_pool()
-      , _background_pool_free(0)
+      , _latencies()
+      , _weights{{4, 2, 1}}
+      , _round_budget(std::chrono::milliseconds(
+                        elle::os::getenv("ELLE_REACTOR_ROUND_BUDGET", 2)))
+      , _blocking_pool(this->_io_service)
+      , _compute_pool(this->_io_service)
       , _io_service_work(
            std::make_unique<boost::asio::io_service::work>(this->_io_service))
+      , _timer_wheel(this->_io_service)
+#ifdef ELLE_LINUX
+      , _io_uring()
+      , _io_uring_probed(false)
+#endif
 #if defined(REACTOR_CORO_BACKEND_IO)
       , _manager(new backend::coro_io::Backend())
 #elif defined(REACTOR_CORO_BACKEND_BOOST_CONTEXT)
@@ -181,6 +192,15 @@ namespace elle
         for (auto thread: this->_starting)
           print_thread(*thread);
       }
+      std::cerr << "== SCHEDULING DELAYS ==" << std::endl;
+      for (auto p: {Priority::latency, Priority::normal, Priority::bulk})
+      {
+        auto const& l = this->latency(p);
+        std::cerr << "  " << p << ": " << l.count() << " steps"
+                  << ", p50 " << l.percentile(0.5).count() << "ns"
+                  << ", p99 " << l.percentile(0.99).count() << "ns"
+                  << ", max " << l.maximum().count() << "ns" << std::endl;
+      }
     }
 
     /*----.
@@ -215,12 +235,13 @@ namespace elle
       while (this->step())
         continue;
       this->_running_thread = std::thread::id();
-      this->_background_service_work = nullptr;
-      for (auto& thread: this->_background_pool)
-        thread.join();
+      this->_blocking_pool.stop();
+      this->_compute_pool.stop();
       this->_io_service_work = nullptr;
       // Cancel all pending signal handlers.
       this->_signal_handlers.clear();
+      // Release the timer wheel, unless some timer is still pending.
+      this->_timer_wheel.idle();
       this->_io_service.run();
       this->_done = true;
       {
@@ -250,44 +271,66 @@ namespace elle
         this->_starting.clear();
       }
       auto& ordered = this->_running.get<1>();
-      auto running = make_vector(ordered);
-      ELLE_TRACE_SCOPE("Scheduler: new round with %s jobs", running.size());
+      // Runnable threads by priority, in order.
+      auto queues = std::array<std::vector<Thread*>, 3>{};
+      for (auto t: ordered)
+        queues[int(t->_priority)].push_back(t);
+      ELLE_TRACE_SCOPE("Scheduler: new round with %s jobs", ordered.size());
 
       ELLE_DUMP("%s: starting: %s", this, this->_starting);
       ELLE_DUMP("%s: running: %s", this, this->_running);
       ELLE_DUMP("%s: frozen: %s", this, this->_frozen);
       ELLE_MEASURE("Scheduler round")
-        for (Thread* t: running)
-          // If the thread was stopped during this round, skip. Can be caused by
-          // terminate_now, for instance.
-          if (elle::find(this->_running, t))
-          {
-            ELLE_TRACE("Scheduler: schedule %s", *t);
-            this->_step(t);
-          }
-      ELLE_TRACE("%s: run asynchronous jobs", *this)
       {
-        ELLE_MEASURE_SCOPE("Asio callbacks");
-        try
+        auto next = std::array<std::size_t, 3>{};
+        auto now = Clock::now();
+        auto deadline = now + this->_round_budget;
+        bool pending = true;
+        bool caught_up = false;
+        while (pending)
         {
-          this->_io_service.reset();
-          auto n = this->_io_service.poll();
-          ELLE_DEBUG("%s: %s callback called", *this, n);
-        }
-        catch (std::exception const& e)
-        {
-          ELLE_WARN("%s: asynchronous job threw an exception: %s",
-                    *this, e.what());
-          this->_eptr = std::current_exception();
-          this->terminate();
-        }
-        catch (...)
-        {
-          ELLE_WARN("%s: asynchronous jobs threw an unknown exception", *this);
-          this->_eptr = std::current_exception();
-          this->terminate();
+          pending = false;
+          for (int c = 0; c < 3; ++c)
+          {
+            auto& queue = queues[c];
+            for (int n = 0;
+                 n < this->_weights[c] && next[c] < queue.size();
+                 ++n)
+            {
+              auto t = queue[next[c]++];
+              // If the thread was stopped during this round, skip. Can be
+              // caused by terminate_now, for instance.
+              if (!elle::find(this->_running, t))
+                continue;
+              ELLE_TRACE("Scheduler: schedule %s", *t);
+              now = this->_step(t, now);
+            }
+            pending = pending || next[c] < queue.size();
+          }
+          if (pending && now >= deadline)
+          {
+            ELLE_DEBUG("%s: round budget exceeded, poll asio", this);
+            this->_poll();
+            // Catch up once per round with latency threads woken meanwhile.
+            // Threads already queued this round, stepped or not, wait for the
+            // next one so busy latency threads cannot starve other classes.
+            if (!caught_up)
+            {
+              caught_up = true;
+              auto& latency = queues[0];
+              auto const queued = latency.size();
+              for (auto t: ordered)
+                if (t->_priority == Priority::latency &&
+                    std::find(latency.begin(), latency.begin() + queued, t) ==
+                    latency.begin() + queued)
+                  latency.push_back(t);
+            }
+            now = Clock::now();
+            deadline = now + this->_round_budget;
+          }
         }
       }
+      this->_poll();
       if (this->_running.empty() && this->_starting.empty())
       {
         if (this->_frozen.empty())
@@ -326,9 +369,43 @@ namespace elle
     }
 
     void
-    Scheduler::_step(Thread* thread)
+    Scheduler::_poll()
+    {
+#ifdef ELLE_LINUX
+      // Submit the I/O queued since the last poll at once.
+      if (this->_io_uring)
+        this->_io_uring->submit();
+#endif
+      ELLE_TRACE("%s: run asynchronous jobs", *this)
+      {
+        ELLE_MEASURE_SCOPE("Asio callbacks");
+        try
+        {
+          this->_io_service.reset();
+          auto n = this->_io_service.poll();
+          ELLE_DEBUG("%s: %s callback called", *this, n);
+        }
+        catch (std::exception const& e)
+        {
+          ELLE_WARN("%s: asynchronous job threw an exception: %s",
+                    *this, e.what());
+          this->_eptr = std::current_exception();
+          this->terminate();
+        }
+        catch (...)
+        {
+          ELLE_WARN("%s: asynchronous jobs threw an unknown exception", *this);
+          this->_eptr = std::current_exception();
+          this->terminate();
+        }
+      }
+    }
+
+    Scheduler::Clock::time_point
+    Scheduler::_step(Thread* thread, Clock::time_point now)
     {
       ELLE_ASSERT_EQ(thread->state(), Thread::State::running);
+      this->_latencies[int(thread->_priority)].record(now - thread->_runnable);
       Thread* previous = this->_current;
       this->_current = thread;
       try
@@ -347,12 +424,17 @@ namespace elle
         this->_eptr = std::current_exception();
         this->terminate();
       }
+      now = Clock::now();
       if (thread->state() == Thread::State::done)
       {
         ELLE_TRACE("%s: %s finished", *this, *thread);
         this->_running.erase(thread);
         thread->_scheduler_release();
       }
+      else
+        // Yielded threads are runnable again right away.
+        thread->_runnable = now;
+      return now;
     }
 
     /*-------------------.
@@ -372,7 +454,8 @@ namespace elle
       ELLE_ASSERT_NEQ(this->_running.find(&thread), this->_running.end());
       this->_running.erase(&thread);
       this->_frozen.insert(&thread);
-      thread.frozen()();
+      if (thread._frozen)
+        (*thread._frozen)();
     }
 
     void
@@ -393,7 +476,9 @@ namespace elle
       ELLE_ASSERT_EQ(thread.state(), Thread::State::frozen);
       this->_frozen.erase(&thread);
       this->_running.insert(&thread);
-      thread.unfrozen()(reason);
+      thread._runnable = Clock::now();
+      if (thread._unfrozen)
+        (*thread._unfrozen)(reason);
       if (this->_running.size() == 1)
         this->_io_service.post([]{});
     }
@@ -553,51 +638,17 @@ namespace elle
     int
     Scheduler::background_pool_size() const
     {
-      return this->_background_pool.size();
+      return this->_blocking_pool.size();
     }
 
-    void
-    Scheduler::_run_background(std::function<std::function<void ()> ()> action)
+    BackgroundPool&
+    Scheduler::background_pool(Background kind)
     {
-      // FIXME: don't hardcode 16, sort out CPU-bound versus "blocking" use case
-      if (this->_background_pool_free == 0 && this->_background_pool.size() < 16)
-      {
-        ELLE_DEBUG("%s: spawn new background thread", *this);
-        this->_background_pool.emplace_back(
-          [this]
-          {
-            this->_background_service.run();
-          });
-      }
+      if (kind == Background::compute)
+        return this->_compute_pool;
       else
-        --this->_background_pool_free;
-      this->_background_service.post(
-        [this, action]
-        {
-          try
-          {
-            auto epilogue = elle::utility::move_on_copy(action());
-            this->_io_service.post(
-              [this, epilogue]
-              {
-                try
-                {
-                  (*epilogue)();
-                  ++this->_background_pool_free;
-                }
-                catch (...)
-                {
-                  ++this->_background_pool_free;
-                  throw;
-                }
-              });
-          }
-          catch (...)
-          {
-            ELLE_ABORT("background job threw: %s", elle::exception_string());
-          }
-        });
-      }
+        return this->_blocking_pool;
+    }
 
     /*--------.
     | Signals |
@@ -647,6 +698,70 @@ namespace elle
       this->_signal_handlers.emplace_back(std::move(set));
     }
 
+    /*-----------.
+    | Priorities |
+    `-----------*/
+
+    Scheduler::Latency const&
+    Scheduler::latency(Priority priority) const
+    {
+      return this->_latencies[int(priority)];
+    }
+
+    int
+    Scheduler::weight(Priority priority) const
+    {
+      return this->_weights[int(priority)];
+    }
+
+    void
+    Scheduler::weight(Priority priority, int weight)
+    {
+      if (weight < 1)
+        elle::err("invalid %s weight: %s", priority, weight);
+      this->_weights[int(priority)] = weight;
+    }
+
+    Duration
+    Scheduler::round_budget() const
+    {
+      return boost::posix_time::microseconds(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+          this->_round_budget).count());
+    }
+
+    void
+    Scheduler::round_budget(Duration budget)
+    {
+      this->_round_budget =
+        std::chrono::microseconds(budget.total_microseconds());
+    }
+
+#ifdef ELLE_LINUX
+    /*---------.
+    | io_uring |
+    `---------*/
+
+    IOUring*
+    Scheduler::io_uring()
+    {
+      if (!this->_io_uring_probed)
+      {
+        this->_io_uring_probed = true;
+        if (elle::os::getenv("ELLE_REACTOR_IO_URING", true))
+          try
+          {
+            this->_io_uring = std::make_unique<IOUring>(this->_io_service);
+          }
+          catch (elle::Error const& e)
+          {
+            ELLE_TRACE("%s: io_uring unavailable: %s", this, e);
+          }
+      }
+      return this->_io_uring.get();
+    }
+#endif
+
     /*----------------.
     | Multithread API |
     `----------------*/
@@ -681,12 +796,91 @@ namespace elle
     }
 
     void
-    background(std::function<void()> const& action)
+    background(std::function<void()> const& action, Background kind)
     {
-      BackgroundOperation<void> o(action);
+      BackgroundOperation<void> o(action, kind);
       o.run();
     }
 
+    namespace
+    {
+      struct Batch
+      {
+        Batch(std::size_t size)
+          : remaining(size)
+          , exception()
+          , done("background batch")
+          , aborted(false)
+        {}
+
+        std::size_t remaining;
+        std::exception_ptr exception;
+        Barrier done;
+        bool aborted;
+      };
+
+      class BatchJob
+        : public BackgroundPool::Job
+      {
+      public:
+        BatchJob(std::shared_ptr<Batch> batch,
+                 std::function<void ()> const& action)
+          : _batch(std::move(batch))
+          , _action(action)
+          , _exception()
+        {}
+
+        void
+        run() noexcept override
+        {
+          try
+          {
+            this->_action();
+          }
+          catch (...)
+          {
+            this->_exception = std::current_exception();
+          }
+        }
+
+        void
+        complete() override
+        {
+          auto& batch = *this->_batch;
+          if (batch.aborted)
+            return;
+          if (this->_exception && !batch.exception)
+            batch.exception = this->_exception;
+          if (--batch.remaining == 0)
+            batch.done.open();
+        }
+
+      private:
+        ELLE_ATTRIBUTE(std::shared_ptr<Batch>, batch);
+        ELLE_ATTRIBUTE(std::function<void ()>, action);
+        ELLE_ATTRIBUTE(std::exception_ptr, exception);
+      };
+    }
+
+    void
+    background(std::vector<std::function<void()>> const& actions,
+               Background kind)
+    {
+      if (actions.empty())
+        return;
+      auto batch = std::make_shared<Batch>(actions.size());
+      auto jobs = BackgroundPool::Jobs{};
+      jobs.reserve(actions.size());
+      for (auto const& action: actions)
+        jobs.emplace_back(std::make_shared<BatchJob>(batch, action));
+      scheduler().background_pool(kind).submit(std::move(jobs));
+      // Actions may outlive us if we are terminated, leave their results.
+      elle::SafeFinally abort([&] { batch->aborted = true; });
+      reactor::wait(batch->done);
+      if (batch->exception)
+        std::rethrow_exception(batch->exception);
+    }
+
     void
     yield()
     {
@@ -809,8 +1003,11 @@ namespace
   CXAThreadMap&
   cxa_thread_map()
   {
-    static CXAThreadMap _cxa_thread_map;
-    return _cxa_thread_map;
+    // Never destroyed: exception handling, e.g. std::uncaught_exception in
+    // std::ios_base::Init's destructor, still needs it after static
+    // destructors ran.
+    static auto* _cxa_thread_map = new CXAThreadMap;
+    return *_cxa_thread_map;
   }
 }
 
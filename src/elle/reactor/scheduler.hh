@@ -1,5 +1,8 @@
 #pragma once
 
+#include <array>
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -16,7 +19,12 @@
 
 #include <elle/Printable.hh>
 #include <elle/attribute.hh>
+#include <elle/reactor/BackgroundPool.hh>
 #include <elle/reactor/asio.hh>
+#ifdef ELLE_LINUX
+# include <elle/reactor/IOUring.hh>
+#endif
+#include <elle/reactor/TimerWheel.hh>
 #include <elle/reactor/duration.hh>
 #include <elle/reactor/fwd.hh>
 #include <elle/reactor/backend/fwd.hh>
@@ -119,7 +127,13 @@ namespace elle
       virtual
       void
       _rethrow_exception(std::exception_ptr e) const;
-      void _step(Thread* t);
+      using Clock = std::chrono::steady_clock;
+      /// Step @a t, given the current time, and return the time afterwards.
+      Clock::time_point
+      _step(Thread* t, Clock::time_point now);
+      /// Run ready asio handlers.
+      void
+      _poll();
       ELLE_ATTRIBUTE_R(bool, done);
 
     /*-------------------.
@@ -188,6 +202,34 @@ namespace elle
       ELLE_ATTRIBUTE(Threads, running);
       ELLE_ATTRIBUTE(Threads, frozen);
 
+    /*-----------.
+    | Priorities |
+    `-----------*/
+    public:
+      using Latency = reactor::Latency;
+      /// The scheduling delays of threads of @a priority.
+      Latency const&
+      latency(Priority priority) const;
+      /// How many threads of @a priority are stepped before moving on to the
+      /// next class, round robin. 4, 2 and 1 by default.
+      int
+      weight(Priority priority) const;
+      void
+      weight(Priority priority, int weight);
+      /// How long threads may run before asio is polled again within a
+      /// round, ELLE_REACTOR_ROUND_BUDGET milliseconds or 2 by default.
+      ///
+      /// When a round overruns its budget, runnable latency threads, including
+      /// the ones woken by the poll, are stepped again within the round.
+      Duration
+      round_budget() const;
+      void
+      round_budget(Duration budget);
+    private:
+      ELLE_ATTRIBUTE((std::array<Latency, 3>), latencies);
+      ELLE_ATTRIBUTE((std::array<int, 3>), weights);
+      ELLE_ATTRIBUTE(std::chrono::nanoseconds, round_budget);
+
     /*-------------------------.
     | Thread Exception Handler |
     `-------------------------*/
@@ -241,34 +283,19 @@ namespace elle
     | Background jobs |
     `----------------*/
     public:
-      /// Number of threads spawned to run background jobs.
+      /// Number of threads spawned to run blocking background jobs.
       int
       background_pool_size() const;
-    private:
-      template <typename T>
-      friend class BackgroundOperation;
-      /// Run function in a system thread. Run the result back in the scheduler.
+      /// The pool running background jobs of @a kind.
       ///
-      /// It is guaranteed that a thread will immediately start executing the
-      /// action, spawning a new one if needed. The system thread runs freely,
-      /// all race condition issues apply, use at your own risks. The thread is
-      /// joined upon destruction of the scheduler. The returned function is
-      /// then run in the scheduler context.
-      ///
-      /// This pattern enables to run absolutely pure code in the system thread,
-      /// removing the possibility of any race condition, and run the
-      /// potentially non-pure epilogue in the non-parallel scheduler context.
-      ///
-      /// @param action The Action to run in a system thread.
-      void
-      _run_background(std::function<std::function<void ()> ()> action);
-      ELLE_ATTRIBUTE(boost::asio::io_service, background_service);
-      ELLE_ATTRIBUTE(std::unique_ptr<boost::asio::io_service::work>, background_service_work);
-      ELLE_ATTRIBUTE(std::vector<std::thread>, background_pool);
-      ELLE_ATTRIBUTE(int, background_pool_free);
-      friend
-      void
-      background(std::function<void()> const& action);
+      /// Blocking calls and computations run on separate pools, so that a
+      /// burst of slow system calls does not hold computations back, and
+      /// computations do not use more threads than there are cores.
+      BackgroundPool&
+      background_pool(Background kind);
+    private:
+      ELLE_ATTRIBUTE(BlockingPool, blocking_pool);
+      ELLE_ATTRIBUTE(ComputePool, compute_pool);
 
     /*--------.
     | Signals |
@@ -291,6 +318,30 @@ namespace elle
       ELLE_ATTRIBUTE_RX(boost::asio::io_service, io_service);
       ELLE_ATTRIBUTE(std::unique_ptr<boost::asio::io_service::work>, io_service_work);
 
+    /*-------.
+    | Timers |
+    `-------*/
+    public:
+      /// The wheel every timeout and sleep of this Scheduler is armed on.
+      ELLE_ATTRIBUTE_RX(TimerWheel, timer_wheel);
+
+#ifdef ELLE_LINUX
+    /*---------.
+    | io_uring |
+    `---------*/
+    public:
+      /// The ring file I/O can go through, created upon first use.
+      ///
+      /// Null if the kernel lacks io_uring support or if ELLE_REACTOR_IO_URING
+      /// is false. Operations queued during a round are submitted together at
+      /// its end.
+      IOUring*
+      io_uring();
+    private:
+      ELLE_ATTRIBUTE(std::unique_ptr<IOUring>, io_uring);
+      ELLE_ATTRIBUTE(bool, io_uring_probed);
+#endif
+
     /*--------.
     | Details |
     `--------*/
@@ -316,8 +367,20 @@ namespace elle
     /// Run an action in a system thread and yield until completion.
     ///
     /// @param action The action to run in background.
+    /// @param kind Whether the action blocks or computes.
+    void
+    background(std::function<void()> const& action,
+               Background kind = Background::blocking);
+    /// Run actions in system threads and yield until they are all done.
+    ///
+    /// Actions are submitted at once, and completed together as they finish.
+    ///
+    /// @param actions The actions to run in background.
+    /// @param kind Whether the actions block or compute.
+    /// @throw The first exception thrown by an action, once all are done.
     void
-    background(std::function<void()> const& action);
+    background(std::vector<std::function<void()>> const& actions,
+               Background kind = Background::blocking);
     /// Yield execution for this scheduler round.
     void
     yield();
@@ -9,7 +9,7 @@ namespace elle
     Sleep::Sleep(Scheduler& scheduler, Duration d)
       : Operation(scheduler)
       , _duration(d)
-      , _timer(scheduler.io_service(), d)
+      , _timer([this] { this->_signal(); })
     {}
 
     /*----------.
@@ -32,14 +32,7 @@ namespace elle
     void
     Sleep::_start()
     {
-      _timer.async_wait([this](const boost::system::error_code& error)
-                        {
-                          if (error == boost::asio::error::operation_aborted)
-                            return;
-                          if (error)
-                            _raise<Exception>(error.message());
-                          this->_signal();
-                        });
+      this->sched().timer_wheel().arm(this->_timer, this->_duration);
     }
   }
 }
@@ -1,7 +1,7 @@
 #pragma once
 
-#include <elle/reactor/asio.hh>
 #include <elle/reactor/Operation.hh>
+#include <elle/reactor/TimerWheel.hh>
 
 namespace elle
 {
@@ -48,7 +48,7 @@ namespace elle
 
     private:
       Duration _duration;
-      boost::asio::deadline_timer _timer;
+      TimerWheel::Entry _timer;
     };
   }
 }
@@ -1,9 +1,52 @@
 #include <elle/reactor/storage.hh>
 
+#include <vector>
+
 namespace elle
 {
   namespace reactor
   {
+    namespace local_storage
+    {
+      namespace
+      {
+        struct Keys
+        {
+          std::mutex mutex;
+          std::vector<std::size_t> free;
+          std::size_t next = 0;
+          std::uint64_t id = 0;
+        };
+
+        // Never destroyed, static storages may outlive it otherwise.
+        Keys&
+        keys()
+        {
+          static auto res = new Keys;
+          return *res;
+        }
+      }
+
+      std::pair<std::size_t, std::uint64_t>
+      acquire()
+      {
+        auto& keys = local_storage::keys();
+        std::lock_guard<std::mutex> lock(keys.mutex);
+        auto const id = ++keys.id;
+        if (keys.free.empty())
+          return {keys.next++, id};
+        auto const index = keys.free.back();
+        keys.free.pop_back();
+        return {index, id};
+      }
 
+      void
+      release(std::size_t index)
+      {
+        auto& keys = local_storage::keys();
+        std::lock_guard<std::mutex> lock(keys.mutex);
+        keys.free.push_back(index);
+      }
+    }
   }
 }
@@ -1,24 +1,32 @@
 #pragma once
 
+#include <cstdint>
 #include <mutex>
 #include <unordered_map>
+#include <utility>
 
-#include <boost/optional.hpp>
-#include <boost/signals2.hpp>
-
+#include <elle/attribute.hh>
 #include <elle/reactor/fwd.hh>
 
 namespace elle
 {
   namespace reactor
   {
-    /// XXX[doc].
+    /// A value per reactor Thread.
+    ///
+    /// Values live in slots embedded in the Thread itself, indexed by a key
+    /// allocated when the storage is created: access from a Thread is lock
+    /// free and constant time. Values are destroyed along with their Thread,
+    /// or when another storage reuses the slot.
+    ///
+    /// Outside of Threads, values are per Scheduler and guarded by a mutex.
     template <typename T>
     class LocalStorage
     {
     public:
       using Self = LocalStorage<T>;
       LocalStorage();
+      LocalStorage(LocalStorage const&) = delete;
       ~LocalStorage();
       operator T&();
       T&
@@ -30,14 +38,24 @@ namespace elle
       template <typename Fun>
       T&
       _get(Fun fun);
-      void
-      _clean(Thread* t);
-      using Content = std::unordered_map<void*, T>;
-      Content _content;
-      using Links = std::unordered_map<void*, boost::signals2::connection>;
-      Links _links;
-      std::mutex _mutex;
+      /// The slot in Threads.
+      ELLE_ATTRIBUTE(std::size_t, index);
+      /// Tells apart storages that successively use the same slot.
+      ELLE_ATTRIBUTE(std::uint64_t, id);
+      /// Values outside of Threads, per Scheduler.
+      ELLE_ATTRIBUTE((std::unordered_map<void*, T>), content);
+      ELLE_ATTRIBUTE(std::mutex, mutex);
     };
+
+    namespace local_storage
+    {
+      /// Allocate a free slot index and a unique storage id.
+      std::pair<std::size_t, std::uint64_t>
+      acquire();
+      /// Free a slot index.
+      void
+      release(std::size_t index);
+    }
   }
 }
 
@@ -1,4 +1,3 @@
-#include <elle/assert.hh>
 #include <elle/reactor/scheduler.hh>
 #include <elle/reactor/Thread.hh>
 
@@ -8,15 +7,20 @@ namespace elle
   {
     template <typename T>
     LocalStorage<T>::LocalStorage()
-      : _content()
-    {}
+      : _index()
+      , _id()
+      , _content()
+      , _mutex()
+    {
+      std::tie(this->_index, this->_id) = local_storage::acquire();
+    }
 
     template <typename T>
     LocalStorage<T>::~LocalStorage()
     {
-      std::lock_guard<std::mutex> lock(this->_mutex);
-      for (auto const& i: this->_links)
-        i.second.disconnect();
+      // Values left in Threads are destroyed lazily, as the id tells them
+      // apart from the next storage using the slot.
+      local_storage::release(this->_index);
     }
 
     template <typename T>
@@ -46,35 +50,32 @@ namespace elle
     {
       Scheduler* sched = Scheduler::scheduler();
       Thread* current = sched ? sched->current() : nullptr;
-      void* key = current ? static_cast<void*>(current)
-                          : static_cast<void*>(sched);
-      std::lock_guard<std::mutex> lock(this->_mutex);
-      auto it = this->_content.find(key);
-      if (it == this->_content.end())
+      if (!current)
+      {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        auto it = this->_content.find(sched);
+        if (it == this->_content.end())
         {
-          auto& res = this->_content[key];
+          auto& res = this->_content[sched];
           fun(res);
-          if (current)
-            this->_links[current]
-              = current->destructed().connect([this, current]
-                {
-                  this->_clean(current);
-                });
           return res;
         }
-      else
-        return it->second;
-    }
-
-    template <typename T>
-    void
-    LocalStorage<T>::_clean(Thread* current)
-    {
-      std::lock_guard<std::mutex> lock(this->_mutex);
-      this->_links.erase(current);
-      auto it = this->_content.find(current);
-      ELLE_ASSERT_NEQ(it, this->_content.end());
-      this->_content.erase(it);
+        else
+          return it->second;
+      }
+      auto& slots = current->_storage;
+      if (slots.size() <= this->_index)
+        slots.resize(this->_index + 1);
+      auto& slot = slots[this->_index];
+      if (!slot.value || slot.id != this->_id)
+      {
+        slot.value.reset();
+        slot.value = Thread::StorageSlot::Value(
+          new T(), [] (void* value) { delete static_cast<T*>(value); });
+        slot.id = this->_id;
+        fun(*static_cast<T*>(slot.value.get()));
+      }
+      return *static_cast<T*>(slot.value.get());
     }
   }
 }
@@ -1,11 +1,10 @@
 #pragma once
 
-#include <elle/reactor/asio.hh>
-
 #include <elle/Printable.hh>
 #include <elle/reactor/fwd.hh>
 #include <elle/reactor/duration.hh>
 #include <elle/reactor/Thread.hh>
+#include <elle/reactor/TimerWheel.hh>
 
 namespace elle
 {
@@ -58,13 +57,13 @@ namespace elle
       _wait(Thread* thread, Waker const& waker) override;
     private:
       void
-      _on_timer(const boost::system::error_code& erc);
+      _on_timer();
 
       Scheduler& _scheduler;
       std::string _name;
       Action _action;
       std::unique_ptr<Thread> _thread;
-      boost::asio::deadline_timer _timer;
+      TimerWheel::Entry _timer;
       bool _finished;
     };
   }
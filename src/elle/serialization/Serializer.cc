@@ -1,4 +1,8 @@
 #include <elle/serialization/Serializer.hh>
+
+#include <limits>
+
+#include <elle/serialization.hh>
 #include <elle/serialization/SerializerIn.hh>
 #include <elle/serialization/SerializerOut.hh>
 
@@ -8,8 +12,11 @@ namespace elle
 {
   namespace serialization
   {
+    Version const Serializer::compact_version(0, 10, 0);
+
     Serializer::Serializer(bool versioned)
       : _versioned(versioned)
+      , _compact(false)
     {
       static_assert(Details::api<int>() == Details::pod, "");
       static_assert(Details::api<unsigned long>() == Details::pod, "");
@@ -18,8 +25,28 @@ namespace elle
     Serializer::Serializer(Versions versions, bool versioned)
       : _versioned(versioned)
       , _versions(std::move(versions))
+      , _compact(false)
     {}
 
+    boost::optional<Version>
+    Serializer::_elle_version() const
+    {
+      if (this->_versions)
+      {
+        auto it = this->_versions->find(type_info<elle::serialization_tag>());
+        if (it != this->_versions->end())
+          return it->second;
+      }
+      return boost::none;
+    }
+
+    bool
+    Serializer::_compact_requested() const
+    {
+      auto const version = this->_elle_version();
+      return version && *version >= compact_version;
+    }
+
     /*--------------.
     | Enter / leave |
     `--------------*/
@@ -113,6 +140,190 @@ namespace elle
       }
     }
 
+    /*----------------------.
+    | Fixed-width encodings |
+    `----------------------*/
+
+    namespace
+    {
+      // Special times and durations, out of the range of actual ones.
+      auto constexpr not_a_date_time =
+        std::numeric_limits<std::int64_t>::min();
+      auto constexpr neg_infin = not_a_date_time + 1;
+      auto constexpr pos_infin = std::numeric_limits<std::int64_t>::max();
+
+      template <typename T>
+      std::int64_t
+      special(T const& v)
+      {
+        return v.is_neg_infinity() ? neg_infin
+          : v.is_pos_infinity() ? pos_infin
+          : not_a_date_time;
+      }
+
+      boost::date_time::special_values
+      special_value(std::int64_t v)
+      {
+        switch (v)
+        {
+          case neg_infin:
+            return boost::date_time::neg_infin;
+          case pos_infin:
+            return boost::date_time::pos_infin;
+          default:
+            return boost::date_time::not_a_date_time;
+        }
+      }
+
+      bool
+      is_special(std::int64_t v)
+      {
+        return v == not_a_date_time || v == neg_infin || v == pos_infin;
+      }
+
+      std::int64_t
+      nanoseconds(boost::posix_time::time_duration const& d)
+      {
+        using limits = std::numeric_limits<std::int64_t>;
+        // total_nanoseconds silently overflows, check the magnitude first.
+        auto const seconds = d.total_seconds();
+        if (seconds <= limits::min() / 1000000000 ||
+            limits::max() / 1000000000 <= seconds)
+          elle::err<Error>("duration too long for a fixed-width encoding: %s",
+                           d);
+        return d.total_nanoseconds();
+      }
+
+      boost::posix_time::time_duration
+      duration(std::int64_t ns)
+      {
+        // Split seconds off so converting the remainder to ticks cannot
+        // overflow, whatever the time resolution.
+        auto const per_second =
+          boost::posix_time::time_duration::ticks_per_second();
+        return boost::posix_time::seconds(ns / 1000000000) +
+          boost::posix_time::time_duration(
+            0, 0, 0, ns % 1000000000 * per_second / 1000000000);
+      }
+
+      /// \a ticks * \a num / \a denom seconds.
+      boost::posix_time::time_duration
+      duration(std::int64_t ticks, std::int64_t num, std::int64_t denom)
+      {
+        using limits = std::numeric_limits<std::int64_t>;
+        auto const per_second =
+          boost::posix_time::time_duration::ticks_per_second();
+        auto total = std::int64_t(0);
+        if (denom <= 0 || __builtin_mul_overflow(ticks, num, &total))
+          elle::err<Error>("invalid duration: %s * %s / %s seconds",
+                           ticks, num, denom);
+        auto const seconds = total / denom;
+        if (seconds <= limits::min() / per_second ||
+            limits::max() / per_second <= seconds)
+          elle::err<Error>("duration too long: %s * %s / %s seconds",
+                           ticks, num, denom);
+        return boost::posix_time::seconds(seconds) +
+          boost::posix_time::time_duration(
+            0, 0, 0, total % denom * per_second / denom);
+      }
+
+      boost::posix_time::ptime const epoch =
+        boost::posix_time::from_time_t(0);
+    }
+
+    void
+    Serializer::_serialize_bytes(unsigned char*, std::size_t)
+    {
+      elle::unreachable();
+    }
+
+    void
+    Serializer::_serialize_fixed(std::int64_t& v)
+    {
+      unsigned char bytes[8];
+      if (this->out())
+      {
+        auto const u = static_cast<std::uint64_t>(v);
+        for (int i = 0; i < 8; ++i)
+          bytes[i] = u >> (i * 8);
+      }
+      this->_serialize_bytes(bytes, sizeof bytes);
+      if (this->in())
+      {
+        auto u = std::uint64_t(0);
+        for (int i = 0; i < 8; ++i)
+          u |= std::uint64_t(bytes[i]) << (i * 8);
+        v = static_cast<std::int64_t>(u);
+      }
+    }
+
+    void
+    Serializer::_serialize_fixed(elle::Version& v)
+    {
+      unsigned char bytes[3] = {v.major(), v.minor(), v.subminor()};
+      this->_serialize_bytes(bytes, sizeof bytes);
+      if (this->in())
+        v = elle::Version(bytes[0], bytes[1], bytes[2]);
+    }
+
+    void
+    Serializer::_serialize_fixed(boost::posix_time::ptime& v)
+    {
+      auto ns = std::int64_t(0);
+      if (this->out())
+      {
+        if (v.is_special())
+          ns = special(v);
+        else
+          ns = nanoseconds(v - epoch);
+      }
+      this->_serialize_fixed(ns);
+      if (this->in())
+      {
+        if (is_special(ns))
+          v = boost::posix_time::ptime(special_value(ns));
+        else
+          v = epoch + duration(ns);
+      }
+    }
+
+    void
+    Serializer::_serialize_fixed(boost::posix_time::time_duration& v)
+    {
+      auto ns = std::int64_t(0);
+      if (this->out())
+      {
+        if (v.is_special())
+          ns = special(v);
+        else
+          ns = nanoseconds(v);
+      }
+      this->_serialize_fixed(ns);
+      if (this->in())
+      {
+        if (is_special(ns))
+          v = boost::posix_time::time_duration(special_value(ns));
+        else
+          v = duration(ns);
+      }
+    }
+
+    void
+    Serializer::_serialize(boost::posix_time::time_duration& v)
+    {
+      if (this->_compact)
+        this->_serialize_fixed(v);
+      else
+      {
+        std::int64_t ticks = v.ticks();
+        std::int64_t num = 1;
+        std::int64_t denom = v.ticks_per_second();
+        this->_serialize_time_duration(ticks, num, denom);
+        if (this->in())
+          v = duration(ticks, num, denom);
+      }
+    }
+
     void
     Serializer::set_context(Context const& context)
     {
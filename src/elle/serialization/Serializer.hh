@@ -374,6 +374,24 @@ namespace elle
       text() const;
       ELLE_ATTRIBUTE_R(bool, versioned);
       ELLE_ATTRIBUTE_R(boost::optional<Versions>, versions);
+      /// Whether UUIDs, versions, time points and durations are serialized
+      /// with fixed-width encodings.
+      ///
+      /// Binary serializers use them when explicitly given compact_version of
+      /// Elle's serialization or later in their versions. Text serializers
+      /// never do, and neither do unversioned streams, to keep reading data
+      /// written before.
+      ELLE_ATTRIBUTE_R(bool, compact, protected);
+      /// The Elle serialization version fixed-width encodings appeared in.
+      static elle::Version const compact_version;
+    protected:
+      /// The version Elle's own types are serialized at: the one of
+      /// elle::serialization_tag in versions(), if any.
+      boost::optional<elle::Version>
+      _elle_version() const;
+      /// Whether compact encodings are explicitly requested.
+      bool
+      _compact_requested() const;
 
     /*--------------.
     | Serialization |
@@ -709,9 +727,19 @@ namespace elle
       void
       _serialize(boost::posix_time::ptime& v) = 0;
       /// Serialize or deserialize an elle::Duration.
+      void
+      _serialize(boost::posix_time::time_duration& v);
+      /// Serialize or deserialize a std::chrono::duration.
       template <typename Repr, typename Ratio>
       void
       _serialize(std::chrono::duration<Repr, Ratio>& duration);
+      /// Serialize or deserialize a std::chrono::system_clock::time_point.
+      ///
+      /// Text serializers represent it as a boost::posix_time::ptime.
+      template <typename Duration>
+      void
+      _serialize(
+        std::chrono::time_point<std::chrono::system_clock, Duration>& time);
       /// Serialize or deserialize a Duration type from its ticks, numerator
       /// and denominator.
       ///
@@ -724,6 +752,24 @@ namespace elle
       _serialize_time_duration(std::int64_t& ticks,
                                std::int64_t& num,
                                std::int64_t& denom) = 0;
+      /// Serialize or deserialize @a size raw bytes.
+      ///
+      /// Only called by fixed-width encodings, @see compact.
+      virtual
+      void
+      _serialize_bytes(unsigned char* data, std::size_t size);
+      /// Serialize or deserialize an int64_t on 8 bytes, little-endian.
+      void
+      _serialize_fixed(std::int64_t& v);
+      /// Serialize or deserialize a Version on 3 bytes.
+      void
+      _serialize_fixed(elle::Version& v);
+      /// Serialize or deserialize a ptime as nanoseconds since the epoch.
+      void
+      _serialize_fixed(boost::posix_time::ptime& v);
+      /// Serialize or deserialize a time_duration as nanoseconds.
+      void
+      _serialize_fixed(boost::posix_time::time_duration& v);
       /// Serialize a named optional entry.
       ///
       /// @param name The name of the entry.
@@ -3,6 +3,8 @@
 #ifndef ELLE_SERIALIZATION_SERIALIZER_HXX
 # define ELLE_SERIALIZATION_SERIALIZER_HXX
 
+# include <limits>
+
 # include <boost/algorithm/string/replace.hpp>
 # include <boost/optional.hpp>
 
@@ -10,6 +12,7 @@
 # include <elle/ScopedAssignment.hh>
 # include <elle/TypeInfo.hh>
 # include <elle/finally.hh>
+# include <elle/time.hh>
 # include <elle/serialization/Error.hh>
 # include <elle/serialization/SerializerIn.hh>
 # include <elle/serialization/SerializerOut.hh>
@@ -187,6 +190,20 @@ namespace elle
                     elle::type_info<T>(), elle::type_info<P>());
       }
 
+      /// @a d in nanoseconds, for fixed-width encodings.
+      template <typename Repr, typename Ratio>
+      std::int64_t
+      nanoseconds(std::chrono::duration<Repr, Ratio> const& d)
+      {
+        using limits = std::numeric_limits<std::int64_t>;
+        auto const ns =
+          std::chrono::duration<long double, std::nano>(d).count();
+        if (ns < limits::min() || limits::max() < ns)
+          elle::err<Error>("duration too long for a fixed-width encoding: "
+                           "%sns", double(ns));
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+      }
+
       struct current_name
       {
         current_name(Serializer& s)
@@ -887,7 +904,10 @@ namespace elle
     void
     Serializer::serialize_object(elle::Version& version)
     {
-      version.serialize(*this);
+      if (this->_compact)
+        this->_serialize_fixed(version);
+      else
+        version.serialize(*this);
     }
 
     /*------------.
@@ -1101,7 +1121,17 @@ namespace elle
     void
     Serializer::_serialize(std::chrono::duration<Repr, Ratio>& duration)
     {
-      if (out())
+      if (this->_compact)
+      {
+        auto ns = std::int64_t(0);
+        if (this->out())
+          ns = _details::nanoseconds(duration);
+        this->_serialize_fixed(ns);
+        if (this->in())
+          duration = std::chrono::duration_cast<
+            std::chrono::duration<Repr, Ratio>>(std::chrono::nanoseconds(ns));
+      }
+      else if (out())
       {
         int64_t count = duration.count();
         int64_t num = Ratio::num;
@@ -1120,6 +1150,35 @@ namespace elle
       }
     }
 
+    template <typename Duration>
+    void
+    Serializer::_serialize(
+      std::chrono::time_point<std::chrono::system_clock, Duration>& time)
+    {
+      using Time = std::chrono::time_point<std::chrono::system_clock, Duration>;
+      if (this->_compact)
+      {
+        auto ns = std::int64_t(0);
+        if (this->out())
+          ns = _details::nanoseconds(time.time_since_epoch());
+        this->_serialize_fixed(ns);
+        if (this->in())
+          time = Time(std::chrono::duration_cast<Duration>(
+                        std::chrono::nanoseconds(ns)));
+      }
+      else
+      {
+        auto t = boost::posix_time::ptime{};
+        if (this->out())
+          t = elle::to_boost(time);
+        this->_serialize(t);
+        if (this->in())
+          time = std::chrono::time_point_cast<Duration>(
+            elle::from_boost<std::chrono::system_clock,
+                             std::chrono::system_clock::duration>(t));
+      }
+    }
+
     template <typename S,
               template <typename, typename> class C,
               typename T,
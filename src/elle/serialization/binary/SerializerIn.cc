@@ -18,6 +18,7 @@ namespace elle
         , _input(input)
       {
         this->_check_magic(input);
+        this->_compact = this->_compact_requested();
       }
 
       SerializerIn::SerializerIn(std::istream& input,
@@ -27,6 +28,7 @@ namespace elle
         , _input(input)
       {
         this->_check_magic(input);
+        this->_compact = this->_compact_requested();
       }
 
       void
@@ -187,9 +189,24 @@ namespace elle
                      *this, this->current_name(), sz, input().gcount());
       }
 
+      void
+      SerializerIn::_serialize_bytes(unsigned char* data, std::size_t size)
+      {
+        input().read(reinterpret_cast<char*>(data), size);
+        if (input().gcount() != std::streamsize(size))
+          err<Error>("%s: short read when deserializing \"%s\":"
+                     " expected %s, got %s",
+                     *this, this->current_name(), size, input().gcount());
+      }
+
       void
       SerializerIn::_serialize(boost::posix_time::ptime& time)
       {
+        if (this->compact())
+        {
+          this->_serialize_fixed(time);
+          return;
+        }
         std::string str;
         this->_serialize(str);
         // Use the ISO extended input facet to interpret the string.
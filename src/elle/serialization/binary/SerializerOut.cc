@@ -23,6 +23,7 @@ namespace elle
         , _output(output)
       {
         this->_write_magic(output);
+        this->_compact = this->_compact_requested();
       }
 
       SerializerOut::SerializerOut(std::ostream& output,
@@ -32,6 +33,7 @@ namespace elle
         , _output(output)
       {
         this->_write_magic(output);
+        this->_compact = this->_compact_requested();
       }
 
       void
@@ -227,6 +229,11 @@ namespace elle
       void
       SerializerOut::_serialize(boost::posix_time::ptime& time)
       {
+        if (this->compact())
+        {
+          this->_serialize_fixed(time);
+          return;
+        }
         std::stringstream ss;
         auto output_facet = std::make_unique<boost::posix_time::time_facet>();
         // ISO 8601
@@ -247,6 +254,12 @@ namespace elle
         this->_serialize_number(denom);
       }
 
+      void
+      SerializerOut::_serialize_bytes(unsigned char* data, std::size_t size)
+      {
+        this->output().write(reinterpret_cast<char const*>(data), size);
+      }
+
       void
       SerializerOut::_serialize_named_option(std::string const&,
                                              bool,
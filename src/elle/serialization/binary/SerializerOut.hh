@@ -95,6 +95,8 @@ namespace elle
                                  std::int64_t& num,
                                  std::int64_t& denom) override;
         void
+        _serialize_bytes(unsigned char* data, std::size_t size) override;
+        void
         _serialize_named_option(std::string const& name,
                                 bool filled,
                                 std::function<void ()> const& f) override;
@@ -6,6 +6,7 @@
 #include <elle/reactor/Thread.hh>
 #include <elle/reactor/http/url.hh>
 #include <elle/reactor/scheduler.hh>
+#include <elle/reactor/signal.hh>
 #include <elle/serialization/json.hh>
 #include <elle/service/dropbox/Dropbox.hh>
 
@@ -205,13 +206,7 @@ namespace elle
         _poll()
         {
           if (this->_full)
-          {
             this->_apply_delta();
-            // Fetch "/" manually as it is not returned by the intial delta.
-            this->_full = false;
-            this->_dropbox.metadata("/");
-            this->_full = true;
-          }
           else
           {
             this->_cursor = this->_dropbox.delta_latest_cursor();
@@ -241,14 +236,16 @@ namespace elle
         _apply_delta()
         {
           ELLE_TRACE_SCOPE("%s: apply delta", *this);
+          auto reset = this->_cursor.empty();
           Delta delta;
           do
           {
             delta = this->_dropbox.delta(this->_cursor);
-            if (!this->_cursor.empty() && delta.reset)
+            if (delta.reset && !this->_metadata.empty())
             {
-              ELLE_ABORT("delta asked to reset the whole thing, "
-                         "not implemented yet");
+              ELLE_TRACE("%s: delta reset, drop cached metadata", *this);
+              this->_metadata.clear();
+              reset = true;
             }
             ELLE_DEBUG("%s: new cursor: %s", *this, delta.cursor);
             this->_cursor = delta.cursor;
@@ -259,6 +256,13 @@ namespace elle
                 this->metadata_delete(entry.first);
           }
           while (delta.has_more);
+          if (reset && this->_full)
+          {
+            // Fetch "/" manually as it is not returned by deltas.
+            this->_full = false;
+            this->_dropbox.metadata("/");
+            this->_full = true;
+          }
         }
 
         ELLE_ATTRIBUTE(Dropbox&, dropbox);
@@ -389,9 +393,14 @@ namespace elle
         : Error(path, "no such file")
       {}
 
-      Dropbox::Dropbox(std::string token, int block_size)
+      Dropbox::Dropbox(std::string token,
+                       int block_size,
+                       int parallelism,
+                       Endpoints endpoints)
         : _token(std::move(token))
         , _block_size(block_size)
+        , _parallelism(std::max(parallelism, 1))
+        , _endpoints(std::move(endpoints))
         , _cache(new LongPollCache(*this))
       {
         elle::reactor::wait(
@@ -407,7 +416,7 @@ namespace elle
       AccountInfo
       Dropbox::account_info()
       {
-        auto r = this->_request("https://api.dropbox.com/1/account/info");
+        auto r = this->_request(this->_endpoints.api + "/1/account/info");
         this->_check_status("getting account info", r);
         {
           // FIXME: deserialize json with helper everywhere
@@ -424,7 +433,7 @@ namespace elle
         else
         {
           std::string res;
-          for (auto const& chunk: path)
+          for (auto const& chunk: path.relative_path())
           {
             res += "/";
             res += elle::reactor::http::url_encode(chunk.string());
@@ -445,11 +454,10 @@ namespace elle
         ELLE_TRACE_SCOPE("%s: fetch metadata for %s", *this, path.string());
         if (auto metadata = this->_cache->metadata(path))
           return metadata.get();
-        static auto const url_fmt = boost::format(
-          "https://api.dropbox.com/1/metadata/auto%s");
         this->_check_path(path);
         auto r = this->_request(
-          str(boost::format(url_fmt) % this->escape_path(path)),
+          elle::sprintf("%s/1/metadata/auto%s",
+                        this->_endpoints.api, this->escape_path(path)),
           elle::reactor::http::Method::GET,
           elle::reactor::http::Request::QueryDict(), {}, {}, "metadata",
           {elle::reactor::http::StatusCode::Not_Found});
@@ -482,6 +490,20 @@ namespace elle
       elle::Buffer
       Dropbox::get(bfs::path const& path) const
       {
+        // Only split downloads of files we know to be large, fetching
+        // metadata beforehand would cost more than it saves.
+        auto metadata = this->_cache->metadata(path);
+        if (this->_parallelism > 1 && metadata && !metadata->is_dir &&
+            metadata->bytes > this->_block_size)
+        {
+          auto res = elle::Buffer();
+          res.capacity(metadata->bytes);
+          this->download(path, [&] (elle::ConstWeakBuffer block)
+                         {
+                           res.append(block.contents(), block.size());
+                         });
+          return res;
+        }
         return this->_get(path, elle::reactor::http::Request::Configuration());
       }
 
@@ -501,16 +523,64 @@ namespace elle
         return elle::Buffer(it->second._contents.contents() + offset, size);
       }
 
+      void
+      Dropbox::download(
+        bfs::path const& path,
+        std::function<void (elle::ConstWeakBuffer)> const& consume) const
+      {
+        auto const size = this->metadata(path).bytes;
+        auto const block_size = int64_t(this->_block_size);
+        auto const blocks = (size + block_size - 1) / block_size;
+        ELLE_TRACE_SCOPE("%s: download %s in %s blocks",
+                         *this, path.string(), blocks);
+        // Blocks fetched and not consumed yet.
+        auto fetched = std::unordered_map<int64_t, elle::Buffer>{};
+        auto changed = elle::reactor::Signal{};
+        auto next = int64_t(0);
+        elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& scope)
+        {
+          for (auto consumed = int64_t(0); consumed < blocks; ++consumed)
+          {
+            // Keep at most parallelism blocks fetching or fetched.
+            for (; next < blocks && next < consumed + this->_parallelism;
+                 ++next)
+              scope.run_background(
+                elle::sprintf("%s: block %s", path.string(), next),
+                [&, block = next]
+                {
+                  auto const start = block * block_size;
+                  auto const end = std::min(start + block_size, size);
+                  auto conf = elle::reactor::http::Request::Configuration();
+                  conf.header_add(
+                    "Range", elle::sprintf("bytes=%s-%s", start, end - 1));
+                  auto data = this->_get(path, std::move(conf));
+                  if (signed(data.size()) != end - start)
+                    throw Error(
+                      path,
+                      elle::sprintf("block %s is %s bytes instead of %s",
+                                    block, data.size(), end - start));
+                  fetched.emplace(block, std::move(data));
+                  changed.signal();
+                });
+            auto it = fetched.end();
+            while ((it = fetched.find(consumed)) == fetched.end())
+              elle::reactor::wait(changed);
+            auto data = std::move(it->second);
+            fetched.erase(it);
+            consume(data);
+          }
+        };
+      }
+
       elle::Buffer
       Dropbox::_get(bfs::path const& path,
                     elle::reactor::http::Request::Configuration conf) const
       {
         ELLE_TRACE_SCOPE("%s: fetch file %s", *this, path.string());
         this->_check_path(path);
-        static auto const url_fmt = boost::format
-          ("https://api-content.dropbox.com/1/files/auto%s");
         auto r = this->_request(
-          str(boost::format(url_fmt) % this->escape_path(path)),
+          elle::sprintf("%s/1/files/auto%s",
+                        this->_endpoints.content, this->escape_path(path)),
           elle::reactor::http::Method::GET,
           elle::reactor::http::Request::QueryDict(),
           std::move(conf),
@@ -547,18 +617,68 @@ namespace elle
         if (this->_ignored(path))
           return false;
         this->_check_path(path);
+        if (signed(content.size()) > this->_block_size)
+          return this->_put_chunked(path, content, overwrite);
         auto query = elle::reactor::http::Request::QueryDict{};
         if (!overwrite)
           query.insert({{"overwrite", "false"},
                         {"autorename", "false"}});
-        static auto const url_fmt = boost::format
-          ("https://api-content.dropbox.com/1/files_put/auto%s");
         auto r = this->_request(
-          str(boost::format(url_fmt) % this->escape_path(path)),
+          elle::sprintf("%s/1/files_put/auto%s",
+                        this->_endpoints.content, this->escape_path(path)),
           elle::reactor::http::Method::PUT,
           std::move(query), {}, content, "write",
           {elle::reactor::http::StatusCode::Conflict});
+        return this->_put_result(path, r, "putting file");
+      }
 
+      bool
+      Dropbox::_put_chunked(bfs::path const& path,
+                            elle::WeakBuffer const& content,
+                            bool overwrite)
+      {
+        ELLE_TRACE_SCOPE("%s: upload %s bytes in chunks of %s",
+                         *this, content.size(), this->_block_size);
+        // The upload session only accepts chunks in order, each at the
+        // offset the previous one ended.
+        auto upload_id = std::string();
+        for (auto offset = 0u; offset < content.size();
+             offset += this->_block_size)
+        {
+          auto query = elle::reactor::http::Request::QueryDict{};
+          if (!upload_id.empty())
+            query.insert({{"upload_id", upload_id},
+                          {"offset", std::to_string(offset)}});
+          auto r = this->_request(
+            this->_endpoints.content + "/1/chunked_upload",
+            elle::reactor::http::Method::PUT,
+            std::move(query), {},
+            content.range(offset, std::min<std::size_t>(
+                            offset + this->_block_size, content.size())),
+            "chunked_upload");
+          this->_check_status("uploading chunk", r);
+          elle::serialization::json::SerializerIn s(r, false);
+          upload_id = s.deserialize<std::string>("upload_id");
+        }
+        auto query = elle::reactor::http::Request::QueryDict{};
+        query["upload_id"] = upload_id;
+        if (!overwrite)
+          query.insert({{"overwrite", "false"},
+                        {"autorename", "false"}});
+        auto r = this->_request(
+          elle::sprintf("%s/1/commit_chunked_upload/auto%s",
+                        this->_endpoints.content, this->escape_path(path)),
+          elle::reactor::http::Method::POST,
+          std::move(query), {}, {}, "commit_chunked_upload",
+          {elle::reactor::http::StatusCode::Conflict});
+        return this->_put_result(path, r, "committing chunked upload");
+      }
+
+      bool
+      Dropbox::_put_result(bfs::path const& path,
+                           elle::reactor::http::Request& r,
+                           std::string const& op)
+      {
         if (r.status() == elle::reactor::http::StatusCode::OK)
         {
           elle::serialization::json::SerializerIn s(r, false);
@@ -573,7 +693,7 @@ namespace elle
         }
         else
         {
-          this->_check_status("putting file", r);
+          this->_check_status(op, r);
           elle::unreachable();
         }
       }
@@ -641,7 +761,7 @@ namespace elle
         elle::reactor::http::Request::QueryDict query;
         if (!cursor.empty())
           query["cursor"] = cursor;
-        auto r = this->_request("https://api.dropbox.com/1/delta",
+        auto r = this->_request(this->_endpoints.api + "/1/delta",
                                 elle::reactor::http::Method::POST,
                                 std::move(query),
                                 {}, {}, "delta");
@@ -655,7 +775,7 @@ namespace elle
       std::string
       Dropbox::delta_latest_cursor()
       {
-        auto r = this->_request("https://api.dropbox.com/1/delta/latest_cursor",
+        auto r = this->_request(this->_endpoints.api + "/1/delta/latest_cursor",
                                 elle::reactor::http::Method::POST,
                                 elle::reactor::http::Request::QueryDict(),
                                 {}, {}, "delta_latest_cursor");
@@ -673,7 +793,7 @@ namespace elle
         ELLE_ASSERT(!cursor.empty());
         query["cursor"] = cursor;
         auto r = this->_request(
-          "https://api-notify.dropbox.com/1/longpoll_delta",
+          this->_endpoints.notify + "/1/longpoll_delta",
           elle::reactor::http::Method::GET,
           std::move(query),
           {}, {}, "longpoll_delta");
@@ -739,11 +859,11 @@ namespace elle
                        elle::reactor::http::Request::QueryDict query)
       {
         ELLE_TRACE_SCOPE("%s: %s: %s", *this, op, path.string());
-        static auto const url_fmt = boost::format("https://api.dropbox.com/1/fileops/%s");
         query.insert({{"root", "auto"},
                       {path_arg, path.string()}});
         auto r =
-          this->_request(str(boost::format(url_fmt) % op),
+          this->_request(elle::sprintf("%s/1/fileops/%s",
+                                       this->_endpoints.api, op),
                          elle::reactor::http::Method::POST, std::move(query),
                          {}, {}, op, expected_codes);
         return r;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+
 #include <boost/filesystem.hpp>
 
 #include <elle/Buffer.hh>
@@ -100,6 +102,7 @@ namespace elle
           Metadata,
           decltype(elle::meta::list(symbols::is_dir,
                                     symbols::path,
+                                    symbols::bytes,
                                     symbols::client_mtime,
                                     symbols::modified,
                                     symbols::is_deleted,
@@ -131,10 +134,28 @@ namespace elle
                                     symbols::entries))>;
       };
 
+      /// Roots of the Dropbox HTTP APIs, overridable to talk to a local
+      /// server.
+      struct Endpoints
+      {
+        std::string api = "https://api.dropbox.com";
+        std::string content = "https://api-content.dropbox.com";
+        std::string notify = "https://api-notify.dropbox.com";
+      };
+
       class Dropbox
       {
       public:
-        Dropbox(std::string token, int block_size = 1048576);
+        /// Construct a Dropbox client and fetch the metadata of the whole
+        /// account.
+        ///
+        /// @param block_size  Size of ranged downloads and upload chunks.
+        /// @param parallelism Maximum number of blocks downloaded at once.
+        /// @param endpoints   Roots of the APIs.
+        Dropbox(std::string token,
+                int block_size = 1048576,
+                int parallelism = 4,
+                Endpoints endpoints = {});
         ~Dropbox();
 
         AccountInfo
@@ -156,6 +177,18 @@ namespace elle
         elle::Buffer
         get(boost::filesystem::path const& path, int offset, int size) const;
 
+        /// Download @a path block by block, passing blocks to @a consume in
+        /// order.
+        ///
+        /// Up to parallelism blocks are fetched at once, and no more than
+        /// that are held in memory, whatever the size of the file.
+        void
+        download(boost::filesystem::path const& path,
+                 std::function<void (elle::ConstWeakBuffer)> const& consume)
+          const;
+
+        /// Upload @a content to @a path, in a chunked upload session if it is
+        /// larger than a block.
         bool
         put(boost::filesystem::path const& path,
             elle::WeakBuffer const& content,
@@ -212,11 +245,23 @@ namespace elle
         _get(boost::filesystem::path const& path,
              elle::reactor::http::Request::Configuration conf) const;
 
+        bool
+        _put_chunked(boost::filesystem::path const& path,
+                     elle::WeakBuffer const& content,
+                     bool overwrite);
+
+        bool
+        _put_result(boost::filesystem::path const& path,
+                    elle::reactor::http::Request& r,
+                    std::string const& op);
+
         bool
         _ignored(boost::filesystem::path const& path) const;
 
         ELLE_ATTRIBUTE_R(std::string, token);
         ELLE_ATTRIBUTE_R(int, block_size);
+        ELLE_ATTRIBUTE_R(int, parallelism);
+        ELLE_ATTRIBUTE_R(Endpoints, endpoints);
 
       public:
         class Cache;
@@ -0,0 +1,110 @@
+#include <elle/threading/rw-mutex.hh>
+
+#include <elle/log.hh>
+
+ELLE_LOG_COMPONENT("elle.threading.rw_mutex");
+
+namespace elle
+{
+  namespace threading
+  {
+    /*-------------.
+    | reader_slots |
+    `-------------*/
+
+    constexpr int reader_slots::size;
+
+    reader_slots::reader_slots()
+    {
+      for (auto& slot: this->_slots)
+        slot.readers.store(0, std::memory_order_relaxed);
+    }
+
+    int
+    reader_slots::index()
+    {
+      // Give each thread its own slot, as long as there are enough.
+      static std::atomic<unsigned> next{0};
+      static thread_local int const index = next++ % size;
+      return index;
+    }
+
+    /*---------.
+    | rw_mutex |
+    `---------*/
+
+    rw_mutex::rw_mutex()
+      : _readers()
+      , _writing(false)
+      , _mutex()
+      , _condition()
+    {}
+
+    void
+    rw_mutex::_lock_read()
+    {
+      ELLE_TRACE_SCOPE("%s: wait for writer to lock for reading", this);
+      do
+      {
+        std::unique_lock<std::mutex> lock(this->_mutex);
+        this->_condition.wait(lock, [this] { return !this->_writing.load(); });
+      }
+      while (!this->read_mutex::try_lock());
+    }
+
+    void
+    rw_mutex::_wake()
+    {
+      // Taking the mutex orders us with a thread about to wait.
+      {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+      }
+      this->_condition.notify_all();
+    }
+
+    void
+    rw_mutex::_lock_write()
+    {
+      std::unique_lock<std::mutex> lock(this->_mutex);
+      if (this->_writing.load())
+      {
+        ELLE_TRACE_SCOPE("%s: wait for writer to lock for writing", this);
+        this->_condition.wait(lock, [this] { return !this->_writing.load(); });
+      }
+      // From now on, readers wait behind us.
+      this->_writing.store(true);
+      if (!this->_readers.empty())
+      {
+        ELLE_TRACE_SCOPE("%s: wait for readers to lock for writing", this);
+        this->_condition.wait(lock, [this] { return this->_readers.empty(); });
+      }
+    }
+
+    bool
+    rw_mutex::_try_lock_write()
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        if (this->_writing.load())
+          return false;
+        this->_writing.store(true);
+        if (this->_readers.empty())
+          return true;
+        this->_writing.store(false);
+      }
+      // Readers may have backed off while we looked.
+      this->_condition.notify_all();
+      return false;
+    }
+
+    void
+    rw_mutex::_unlock_write()
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_writing.store(false);
+      }
+      this->_condition.notify_all();
+    }
+  }
+}
@@ -1,19 +1,51 @@
 #ifndef ELLE_THREADING_RW_MUTEX_HH
 # define ELLE_THREADING_RW_MUTEX_HH
 
+# include <array>
+# include <atomic>
 # include <condition_variable>
 # include <mutex>
 
-# include <elle/assert.hh>
 # include <elle/attribute.hh>
-# include <elle/log.hh>
-
-ELLE_LOG_COMPONENT("elle.threading.rw_mutex");
+# include <elle/compiler.hh>
 
 namespace elle
 {
   namespace threading
   {
+    /// Read locks counters, spread over cache lines.
+    ///
+    /// Each thread counts its read locks in its own slot, as long as there
+    /// are enough, so readers running on different cores do not bounce a
+    /// shared counter between their caches. Checking whether there are any
+    /// readers, which only writers do, scans every slot.
+    class ELLE_API reader_slots
+    {
+    public:
+      /// Number of slots.
+      static constexpr int size = 16;
+      reader_slots();
+      /// The slot of the current thread.
+      std::atomic<int>&
+      mine();
+      /// Whether no read lock is held.
+      bool
+      empty() const;
+      /// The slot index of the current thread.
+      static
+      int
+      index();
+
+    private:
+      /// A counter alone on its cache line.
+      struct slot
+      {
+        std::atomic<int> readers;
+        char padding[64 - sizeof(std::atomic<int>)];
+      };
+      ELLE_ATTRIBUTE((std::array<slot, size>), slots);
+    };
+
     /// Special mutex used by thread-safe version of ELLE_ATTRIBUTE.
     class rw_mutex;
 
@@ -34,14 +66,6 @@ namespace elle
     private:
       write_mutex();
 
-    private:
-      bool
-      _try_lock(std::unique_lock<std::mutex>& lock);
-      void
-      _lock(std::unique_lock<std::mutex>& lock);
-      void
-      _set_locked();
-
     private:
       friend rw_mutex;
     };
@@ -63,14 +87,6 @@ namespace elle
     private:
       read_mutex();
 
-    private:
-      bool
-      _try_lock(std::unique_lock<std::mutex>& lock);
-      void
-      _lock(std::unique_lock<std::mutex>& lock);
-      void
-      _set_locked();
-
     private:
       friend rw_mutex;
     };
@@ -78,8 +94,13 @@ namespace elle
     /// rw_mutex, to protect or reading or writing.
     ///
     /// rw_mutex makes sure a variable is protected from writes while being
-    /// read or written.
-    class rw_mutex
+    /// read or written. It is biased toward readers: an uncontended read lock
+    /// is one atomic increment of a reader_slots counter, on a cache line
+    /// that other threads seldom touch. Writers have precedence: once one
+    /// waits, new readers wait behind it, so a steady flow of readers cannot
+    /// starve it. The lock is thus not recursive: read-locking it twice from
+    /// the same thread may deadlock with a waiting writer.
+    class ELLE_API rw_mutex
       : public write_mutex
       , public read_mutex
     {
@@ -89,10 +110,24 @@ namespace elle
     private:
       friend class write_mutex;
       friend class read_mutex;
+      /// Wait for writers to leave, then lock for reading.
+      void
+      _lock_read();
+      /// Wake waiting threads, e.g. a writer waiting for readers to leave.
+      void
+      _wake();
+      void
+      _lock_write();
+      bool
+      _try_lock_write();
+      void
+      _unlock_write();
+      ELLE_ATTRIBUTE(reader_slots, readers);
+      /// Whether a writer holds or waits for the lock.
+      ELLE_ATTRIBUTE(std::atomic<bool>, writing);
+      /// Serialize writers and park waiting threads.
       ELLE_ATTRIBUTE(std::mutex, mutex);
       ELLE_ATTRIBUTE(std::condition_variable, condition);
-      ELLE_ATTRIBUTE(int, readers);
-      ELLE_ATTRIBUTE(bool, writing);
     };
   }
 }
@@ -5,142 +5,97 @@ namespace elle
 {
   namespace threading
   {
-    inline
-    write_mutex::write_mutex()
-    {}
-
-    inline
-    bool
-    write_mutex::try_lock()
-    {
-      ELLE_TRACE_SCOPE("%s: try lock write", *static_cast<rw_mutex*>(this));
-      std::unique_lock<std::mutex> lock(static_cast<rw_mutex*>(this)->_mutex);
-      return this->_try_lock(lock);
-    }
-
-    inline
-    void
-    write_mutex::lock()
-    {
-      ELLE_TRACE_SCOPE("%s: lock write", *static_cast<rw_mutex*>(this));
-      std::unique_lock<std::mutex> lock(static_cast<rw_mutex*>(this)->_mutex);
-      this->_lock(lock);
-    }
+    /*-------------.
+    | reader_slots |
+    `-------------*/
 
     inline
-    void
-    write_mutex::unlock()
+    std::atomic<int>&
+    reader_slots::mine()
     {
-      ELLE_TRACE_SCOPE("%s: unlock write", *static_cast<rw_mutex*>(this));
-      std::unique_lock<std::mutex> lock(static_cast<rw_mutex*>(this)->_mutex);
-      ELLE_ASSERT(static_cast<rw_mutex*>(this)->_writing);
-      ELLE_ASSERT(static_cast<rw_mutex*>(this)->_readers == 0);
-      static_cast<rw_mutex*>(this)->_writing = false;
-      ELLE_TRACE("%s: release internal lock", *static_cast<rw_mutex*>(this));
-      static_cast<rw_mutex*>(this)->_condition.notify_one();
+      return this->_slots[index()].readers;
     }
 
     inline
     bool
-    write_mutex::_try_lock(std::unique_lock<std::mutex>& lock)
+    reader_slots::empty() const
     {
-      if (static_cast<rw_mutex*>(this)->_readers > 0 || static_cast<rw_mutex*>(this)->_writing)
-        return false;
-      this->_set_locked();
+      for (auto const& slot: this->_slots)
+        if (slot.readers.load())
+          return false;
       return true;
     }
 
-    inline
-    void
-    write_mutex::_lock(std::unique_lock<std::mutex>& lock)
-    {
-      while (!this->_try_lock(lock))
-      {
-        ELLE_TRACE("%s: wait for internal lock", *static_cast<rw_mutex*>(this));
-        static_cast<rw_mutex*>(this)->_condition.wait(lock);
-      }
-    }
+    /*------------.
+    | write_mutex |
+    `------------*/
 
     inline
-    void
-    write_mutex::_set_locked()
-    {
-      ELLE_TRACE("%s: acquire internal lock for writing", *static_cast<rw_mutex*>(this));
-      static_cast<rw_mutex*>(this)->_writing = true;
-    }
+    write_mutex::write_mutex()
+    {}
 
     inline
     bool
-    read_mutex::try_lock()
+    write_mutex::try_lock()
     {
-      ELLE_TRACE_SCOPE("%s: try lock read", *static_cast<rw_mutex*>(this));
-      std::unique_lock<std::mutex> lock(static_cast<rw_mutex*>(this)->_mutex);
-      return this->_try_lock(lock);
+      return static_cast<rw_mutex*>(this)->_try_lock_write();
     }
 
     inline
     void
-    read_mutex::lock()
+    write_mutex::lock()
     {
-      ELLE_TRACE_SCOPE("%s: lock read", *static_cast<rw_mutex*>(this));
-      std::unique_lock<std::mutex> lock(static_cast<rw_mutex*>(this)->_mutex);
-      this->_lock(lock);
+      static_cast<rw_mutex*>(this)->_lock_write();
     }
 
     inline
     void
-    read_mutex::unlock()
+    write_mutex::unlock()
     {
-      ELLE_TRACE_SCOPE("%s: unlock read", *static_cast<rw_mutex*>(this));
-      std::unique_lock<std::mutex> lock(static_cast<rw_mutex*>(this)->_mutex);
-      ELLE_ASSERT(!static_cast<rw_mutex*>(this)->_writing);
-      if (--static_cast<rw_mutex*>(this)->_readers == 0)
-      {
-        ELLE_TRACE("%s: release internal lock", *static_cast<rw_mutex*>(this));
-        static_cast<rw_mutex*>(this)->_condition.notify_one();
-      }
+      static_cast<rw_mutex*>(this)->_unlock_write();
     }
 
+    /*-----------.
+    | read_mutex |
+    `-----------*/
+
     inline
     read_mutex::read_mutex()
     {}
 
     inline
     bool
-    read_mutex::_try_lock(std::unique_lock<std::mutex>& lock)
+    read_mutex::try_lock()
     {
-      if (static_cast<rw_mutex*>(this)->_writing)
-        return false;
-      this->_set_locked();
-      return true;
+      auto& self = *static_cast<rw_mutex*>(this);
+      auto& slot = self._readers.mine();
+      // Both sequentially consistent, pairing with writers setting _writing
+      // before scanning the slots: either we see the writer, or it sees us.
+      slot.fetch_add(1);
+      if (!self._writing.load())
+        return true;
+      slot.fetch_sub(1);
+      self._wake();
+      return false;
     }
 
     inline
     void
-    read_mutex::_lock(std::unique_lock<std::mutex>& lock)
+    read_mutex::lock()
     {
-      while (!this->_try_lock(lock))
-      {
-        ELLE_TRACE("%s: wait for internal lock", *static_cast<rw_mutex*>(this));
-        static_cast<rw_mutex*>(this)->_condition.wait(lock);
-      }
+      if (!this->try_lock())
+        static_cast<rw_mutex*>(this)->_lock_read();
     }
 
     inline
     void
-    read_mutex::_set_locked()
+    read_mutex::unlock()
     {
-      ELLE_TRACE("%s: acquire internal lock for reading", *static_cast<rw_mutex*>(this));
-      ++static_cast<rw_mutex*>(this)->_readers;
+      auto& self = *static_cast<rw_mutex*>(this);
+      self._readers.mine().fetch_sub(1);
+      if (self._writing.load())
+        self._wake();
     }
-
-    inline
-    rw_mutex::rw_mutex()
-      : _mutex()
-      , _condition()
-      , _readers(0)
-      , _writing(false)
-    {}
   }
 }
 
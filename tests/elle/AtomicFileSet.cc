@@ -0,0 +1,175 @@
+#define BOOST_TEST_MODULE AtomicFileSet
+
+#include <fstream>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <elle/AtomicFileSet.hh>
+#include <elle/filesystem/TemporaryDirectory.hh>
+
+using namespace std::literals;
+
+namespace bfs = boost::filesystem;
+
+namespace
+{
+  std::string
+  content(bfs::path const& path)
+  {
+    auto input = std::ifstream(path.string());
+    return {std::istreambuf_iterator<char>(input),
+            std::istreambuf_iterator<char>()};
+  }
+
+  void
+  put(bfs::path const& path, std::string const& data)
+  {
+    std::ofstream(path.string()) << data;
+  }
+
+  /// Files in @a root, recursively.
+  int
+  count(bfs::path const& root)
+  {
+    auto res = 0;
+    for (auto it = bfs::recursive_directory_iterator(root);
+         it != bfs::recursive_directory_iterator();
+         ++it)
+      if (bfs::is_regular_file(it->path()))
+        ++res;
+    return res;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(nominal)
+{
+  auto d = elle::filesystem::TemporaryDirectory{};
+  auto const root = d.path() / "set";
+  auto set = elle::AtomicFileSet{root};
+  BOOST_CHECK(!set.transacting());
+  {
+    auto t = set.transaction();
+    BOOST_CHECK(set.transacting());
+    t.write("a") << "a1";
+    t.write("sub/b") << "b1";
+    t.write(d.path() / "c") << "c1";
+    // Nothing is visible until committed.
+    BOOST_CHECK(!bfs::exists(root / "a"));
+    t.commit();
+    BOOST_CHECK(t.committed());
+    BOOST_CHECK(!set.transacting());
+  }
+  BOOST_CHECK_EQUAL(content(root / "a"), "a1");
+  BOOST_CHECK_EQUAL(content(root / "sub/b"), "b1");
+  BOOST_CHECK_EQUAL(content(d.path() / "c"), "c1");
+  {
+    auto t = set.transaction();
+    t.write("a") << "a2";
+    t.remove("sub/b");
+    t.remove("missing");
+    t.commit();
+  }
+  BOOST_CHECK_EQUAL(content(root / "a"), "a2");
+  BOOST_CHECK(!bfs::exists(root / "sub/b"));
+  // No transaction file is left over.
+  BOOST_CHECK_EQUAL(count(root), 1);
+}
+
+BOOST_AUTO_TEST_CASE(rewrite)
+{
+  auto d = elle::filesystem::TemporaryDirectory{};
+  auto set = elle::AtomicFileSet{d.path()};
+  {
+    auto t = set.transaction();
+    t.write("a") << "discarded";
+    t.write("a") << "kept";
+    t.write("b") << "discarded";
+    t.remove("b");
+    t.remove("c");
+    t.write("c") << "kept";
+    t.commit();
+  }
+  BOOST_CHECK_EQUAL(content(d.path() / "a"), "kept");
+  BOOST_CHECK(!bfs::exists(d.path() / "b"));
+  BOOST_CHECK_EQUAL(content(d.path() / "c"), "kept");
+  BOOST_CHECK_EQUAL(count(d.path()), 2);
+}
+
+BOOST_AUTO_TEST_CASE(discard)
+{
+  auto d = elle::filesystem::TemporaryDirectory{};
+  auto set = elle::AtomicFileSet{d.path(), false};
+  put(d.path() / "a", "old");
+  {
+    auto t = set.transaction();
+    t.write("a") << "new";
+    t.write("b") << "new";
+    t.remove("a");
+    // Not committed.
+  }
+  BOOST_CHECK(!set.transacting());
+  BOOST_CHECK_EQUAL(content(d.path() / "a"), "old");
+  BOOST_CHECK_EQUAL(count(d.path()), 1);
+  {
+    auto t = set.transaction();
+    t.write("a") << "new";
+    t.abort();
+    BOOST_CHECK(!set.transacting());
+  }
+  BOOST_CHECK_EQUAL(content(d.path() / "a"), "old");
+  BOOST_CHECK_EQUAL(count(d.path()), 1);
+  BOOST_CHECK_THROW(
+    {
+      auto t = set.transaction();
+      BOOST_CHECK_THROW(set.transaction(), std::exception);
+      throw std::runtime_error("interrupted");
+    },
+    std::runtime_error);
+  BOOST_CHECK(!set.transacting());
+}
+
+// Interrupted after the commit point: changes are replayed.
+BOOST_AUTO_TEST_CASE(recover_committed)
+{
+  auto d = elle::filesystem::TemporaryDirectory{};
+  auto const root = d.path();
+  put(root / "a", "old");
+  put(root / "b", "old");
+  put(root / "c", "new");
+  // "a" is yet to be renamed, "c" already was.
+  put(root / ".a.transaction", "new");
+  put(root / ".transaction",
+      "\"" + (root / "a").string() + "\" \"" +
+      (root / ".a.transaction").string() + "\"\n" +
+      "\"" + (root / "b").string() + "\" \"\"\n" +
+      "\"" + (root / "c").string() + "\" \"" +
+      (root / ".c.transaction").string() + "\"\n");
+  auto set = elle::AtomicFileSet{root};
+  BOOST_CHECK_EQUAL(content(root / "a"), "new");
+  BOOST_CHECK(!bfs::exists(root / "b"));
+  BOOST_CHECK_EQUAL(content(root / "c"), "new");
+  BOOST_CHECK_EQUAL(count(root), 2);
+}
+
+// Interrupted before the commit point: changes are discarded.
+BOOST_AUTO_TEST_CASE(recover_aborted)
+{
+  auto d = elle::filesystem::TemporaryDirectory{};
+  auto const root = d.path();
+  put(root / "a", "old");
+  put(root / ".a.transaction", "new");
+  put(root / ".b.transaction", "new");
+  put(root / ".c", "unrelated");
+  // The last entry is torn, and its staged path truncated.
+  put(root / ".transaction.new",
+      "\"" + (root / "a").string() + "\" \"" +
+      (root / ".a.transaction").string() + "\"\n" +
+      "\"" + (root / "b").string() + "\" \"" +
+      (root / ".b.transaction").string() + "\"\n" +
+      "\"" + (root / "c").string() + "\" \"" + (root / ".c").string());
+  auto set = elle::AtomicFileSet{root};
+  BOOST_CHECK_EQUAL(content(root / "a"), "old");
+  BOOST_CHECK_EQUAL(content(root / ".c"), "unrelated");
+  BOOST_CHECK_EQUAL(count(root), 2);
+}
@@ -55,6 +55,7 @@ BOOST_AUTO_TEST_CASE(syndical_minimum)
 BOOST_AUTO_TEST_CASE(test_backtrace_empty)
 {
   Backtrace empty;
+  BOOST_CHECK(empty.empty());
   BOOST_CHECK(empty.frames().empty());
 }
 
@@ -73,6 +74,25 @@ BOOST_AUTO_TEST_CASE(test_backtrace)
   }
 }
 
+BOOST_AUTO_TEST_CASE(test_backtrace_copy)
+{
+  auto const bt = foo(via_current);
+  BOOST_TEST(!bt.empty());
+  // Copies carry the raw call stack, resolved on their own.
+  auto const copy = bt;
+  auto assigned = Backtrace{};
+  assigned = copy;
+  auto const moved = Backtrace(foo(via_ctor));
+  BOOST_TEST(copy.frames().size() == bt.frames().size());
+  for (auto const* b: std::vector<Backtrace const*>{
+      &bt, &copy, &assigned, &moved})
+  {
+    BOOST_TEST(!b->empty());
+    BOOST_TEST(b->frames()[0].symbol == "qux(Via)");
+    BOOST_TEST(b->frames()[3].symbol == "foo(Via)");
+  }
+}
+
 BOOST_AUTO_TEST_CASE(test_strip_base)
 {
   for (auto via: {via_ctor, via_current})
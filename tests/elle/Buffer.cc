@@ -202,6 +202,41 @@ test_capacity()
   BOOST_TEST(b.capacity() == 8);
 }
 
+static
+void
+test_headroom()
+{
+  auto b = elle::Buffer("body", 4);
+  BOOST_TEST(b.headroom() == 0);
+  b.headroom(8);
+  BOOST_TEST(b.headroom() == 8);
+  BOOST_TEST(b == "body");
+  // Prepended in place.
+  auto const contents = b.contents();
+  b.prepend("head", 4);
+  BOOST_TEST(b.contents() == contents - 4);
+  BOOST_TEST(b.headroom() == 4);
+  BOOST_TEST(b == "headbody");
+  // Kept when growing.
+  b.append("tail", 4);
+  BOOST_TEST(b.headroom() == 4);
+  b.shrink_to_fit();
+  BOOST_TEST(b.headroom() == 4);
+  BOOST_TEST(b == "headbodytail");
+  // Made room for.
+  b.prepend("0123456789", 10);
+  BOOST_TEST(b == "0123456789headbodytail");
+  // Moved along.
+  auto moved = std::move(b);
+  BOOST_TEST(moved == "0123456789headbodytail");
+  BOOST_TEST(b.headroom() == 0);
+  // Released memory starts with the data.
+  auto released = moved.release();
+  BOOST_TEST(moved.headroom() == 0);
+  BOOST_TEST(elle::ConstWeakBuffer(released.first.get(), released.second) ==
+             "0123456789headbodytail");
+}
+
 static
 void
 test_release()
@@ -375,6 +410,7 @@ ELLE_TEST_SUITE()
   boost::unit_test::test_suite* memory = BOOST_TEST_SUITE("Memory");
   buffer->add(memory);
   memory->add(BOOST_TEST_CASE(test_capacity));
+  memory->add(BOOST_TEST_CASE(test_headroom));
   memory->add(BOOST_TEST_CASE(test_release));
   memory->add(BOOST_TEST_CASE(test_assign));
 
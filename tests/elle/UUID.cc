@@ -1,3 +1,7 @@
+#include <set>
+#include <thread>
+#include <vector>
+
 #include <boost/uuid/random_generator.hpp>
 
 #include <elle/UUID.hh>
@@ -40,6 +44,43 @@ namespace uuid
     BOOST_CHECK(!elle::UUID::random().is_nil());
   }
 
+  static
+  void
+  random_many()
+  {
+    auto const uuids = elle::UUID::random_many(1000);
+    BOOST_CHECK_EQUAL(uuids.size(), 1000u);
+    BOOST_CHECK_EQUAL(std::set<elle::UUID>(uuids.begin(), uuids.end()).size(),
+                      1000u);
+    for (auto const& uuid: uuids)
+    {
+      BOOST_CHECK_EQUAL(uuid.version(),
+                        boost::uuids::uuid::version_random_number_based);
+      BOOST_CHECK_EQUAL(uuid.variant(), boost::uuids::uuid::variant_rfc_4122);
+    }
+  }
+
+  static
+  void
+  random_threads()
+  {
+    auto uuids = std::vector<std::vector<elle::UUID>>(8);
+    auto threads = std::vector<std::thread>{};
+    for (auto& v: uuids)
+      threads.emplace_back(
+        [&v]
+        {
+          for (int i = 0; i < 1000; ++i)
+            v.emplace_back(elle::UUID::random());
+        });
+    for (auto& t: threads)
+      t.join();
+    auto all = std::set<elle::UUID>{};
+    for (auto const& v: uuids)
+      all.insert(v.begin(), v.end());
+    BOOST_CHECK_EQUAL(all.size(), 8000u);
+  }
+
   static
   void
   repr()
@@ -85,6 +126,8 @@ ELLE_TEST_SUITE()
   master.add(BOOST_TEST_CASE(from_string));
   auto random = &uuid::random;
   master.add(BOOST_TEST_CASE(random));
+  master.add(BOOST_TEST_CASE(random_many));
+  master.add(BOOST_TEST_CASE(random_threads));
   master.add(BOOST_TEST_CASE(repr));
   master.add(BOOST_TEST_CASE(serialization));
 }
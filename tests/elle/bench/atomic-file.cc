@@ -0,0 +1,57 @@
+#include <string>
+
+using namespace std::literals;
+
+#include <elle/AtomicFile.hh>
+#include <elle/AtomicFileSet.hh>
+#include <elle/filesystem/TemporaryDirectory.hh>
+
+#include <elle/bench/benchmark.hh>
+
+/// Measure committing groups of small files, one by one with AtomicFile or
+/// together with an AtomicFileSet.
+
+int
+main()
+{
+  elle::bench::Suite suite("atomic-file");
+  auto const d = elle::filesystem::TemporaryDirectory{};
+  auto const data = std::string(512, 'x');
+  auto const files = 100;
+  auto const name = [] (int i) { return "file-" + std::to_string(i); };
+  suite.run("AtomicFile", 20, [&]
+            {
+              for (int i = 0; i < files; ++i)
+              {
+                auto file = elle::AtomicFile(d.path() / name(i));
+                file.write() << [&] (elle::AtomicFile::Write& write)
+                {
+                  write.stream() << data;
+                };
+              }
+            },
+            files * data.size());
+  for (auto sync: {false, true})
+  {
+    auto set = elle::AtomicFileSet{d.path(), sync};
+    auto const suffix = sync ? "" : " unsynced";
+    suite.run("AtomicFileSet per file"s + suffix, 5, [&]
+              {
+                for (int i = 0; i < files; ++i)
+                {
+                  auto t = set.transaction();
+                  t.write(name(i)) << data;
+                  t.commit();
+                }
+              },
+              files * data.size());
+    suite.run("AtomicFileSet"s + suffix, 20, [&]
+              {
+                auto t = set.transaction();
+                for (int i = 0; i < files; ++i)
+                  t.write(name(i)) << data;
+                t.commit();
+              },
+              files * data.size());
+  }
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <elle/attribute.hh>
+#include <elle/os/environ.hh>
+
+namespace elle
+{
+  namespace bench
+  {
+    /// Measurements of one benchmark, by name.
+    using Fields = std::vector<std::pair<std::string, double>>;
+
+    /// Keep @a value from being optimized away.
+    template <typename T>
+    inline
+    void
+    keep(T const& value)
+    {
+      asm volatile("" : : "g"(&value) : "memory");
+    }
+
+    /// A set of benchmarks, reported as text or JSON lines.
+    ///
+    /// Every benchmark is warmed up, then timed ELLE_BENCH_REPETITIONS times,
+    /// 5 by default; the median run is reported along the fastest and slowest
+    /// ones so results are comparable across builds. ELLE_BENCH_FORMAT=json
+    /// prints one JSON object per benchmark, ELLE_BENCH_FILTER only runs
+    /// benchmarks whose name contains it and ELLE_BENCH_SCALE multiplies
+    /// iterations counts.
+    ///
+    /// @code{.cc}
+    ///
+    /// elle::bench::Suite suite("buffer");
+    /// suite.run("append", 100000, [&] { buffer.append("x", 1); });
+    /// // buffer.append: 3 ns/op (min 3, max 4)
+    /// // {"suite": "buffer", "benchmark": "append", "iterations": 100000,
+    /// //  "ns_per_op": 3.1, "min_ns_per_op": 3.0, "max_ns_per_op": 3.9}
+    ///
+    /// @endcode
+    class Suite
+    {
+    public:
+      Suite(std::string name)
+        : _name(std::move(name))
+        , _json(elle::os::getenv("ELLE_BENCH_FORMAT", std::string()) ==
+                "json")
+        , _repetitions(std::max(
+                         elle::os::getenv("ELLE_BENCH_REPETITIONS", 5), 1))
+        , _scale(std::max(elle::os::getenv("ELLE_BENCH_SCALE", 1.), 0.))
+        , _filter(elle::os::getenv("ELLE_BENCH_FILTER", std::string()))
+      {}
+
+      /// Whether benchmark @a name is to be run.
+      bool
+      enabled(std::string const& name) const
+      {
+        return name.find(this->_filter) != std::string::npos;
+      }
+
+      /// Time @a iterations calls to @a f.
+      ///
+      /// @param bytes Bytes processed per call, to report a throughput.
+      /// @return The number of calls made, warm up included, if any.
+      template <typename F>
+      std::size_t
+      run(std::string const& name,
+          std::size_t iterations,
+          F&& f,
+          std::size_t bytes = 0)
+      {
+        if (!this->enabled(name))
+          return 0;
+        iterations = std::max<std::size_t>(iterations * this->_scale, 1);
+        auto const warmup = std::max<std::size_t>(iterations / 10, 1);
+        for (std::size_t i = 0; i < warmup; ++i)
+          f();
+        auto runs = std::vector<double>{};
+        for (int r = 0; r < this->_repetitions; ++r)
+        {
+          auto const start = std::chrono::steady_clock::now();
+          for (std::size_t i = 0; i < iterations; ++i)
+            f();
+          auto const ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+          runs.emplace_back(double(ns) / iterations);
+        }
+        std::sort(runs.begin(), runs.end());
+        auto const median = runs[runs.size() / 2];
+        auto fields = Fields{
+          {"iterations", iterations},
+          {"ns_per_op", median},
+          {"min_ns_per_op", runs.front()},
+          {"max_ns_per_op", runs.back()},
+        };
+        if (bytes)
+          fields.emplace_back("mb_per_s", bytes * 1e3 / median);
+        this->report(name, fields);
+        return warmup + iterations * this->_repetitions;
+      }
+
+      /// Report measurements made by hand.
+      void
+      report(std::string const& name, Fields const& fields)
+      {
+        auto& out = std::cout;
+        auto const precision = out.precision(6);
+        if (this->_json)
+        {
+          out << "{\"suite\": \"" << this->_name << "\", \"benchmark\": \""
+              << name << "\"";
+          for (auto const& f: fields)
+            out << ", \"" << f.first << "\": " << f.second;
+          out << "}";
+        }
+        else
+        {
+          out << this->_name << "." << name << ":";
+          for (auto const& f: fields)
+            if (f.first == "ns_per_op")
+              out << " " << f.second << " ns/op";
+            else if (f.first == "min_ns_per_op")
+              out << " (min " << f.second;
+            else if (f.first == "max_ns_per_op")
+              out << ", max " << f.second << ")";
+            else if (f.first != "iterations")
+              out << " " << f.first << " " << f.second;
+        }
+        out << '\n';
+        out.flush();
+        out.precision(precision);
+      }
+
+      ELLE_ATTRIBUTE_R(std::string, name);
+      ELLE_ATTRIBUTE_R(bool, json);
+      ELLE_ATTRIBUTE_R(int, repetitions);
+      ELLE_ATTRIBUTE_R(double, scale);
+      ELLE_ATTRIBUTE_R(std::string, filter);
+    };
+  }
+}
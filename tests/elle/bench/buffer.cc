@@ -0,0 +1,41 @@
+#include <string>
+
+#include <elle/Buffer.hh>
+
+#include <elle/bench/benchmark.hh>
+
+/// Measure elle::Buffer growth, copies and slicing.
+
+int
+main()
+{
+  elle::bench::Suite suite("buffer");
+  auto const chunk = std::string(64, 'x');
+  suite.run("append", 1000, [&]
+            {
+              auto buffer = elle::Buffer{};
+              for (int i = 0; i < 1024; ++i)
+                buffer.append(chunk.data(), chunk.size());
+              elle::bench::keep(buffer);
+            },
+            64 * 1024);
+  suite.run("append reserved", 1000, [&]
+            {
+              auto buffer = elle::Buffer{};
+              buffer.capacity(64 * 1024);
+              for (int i = 0; i < 1024; ++i)
+                buffer.append(chunk.data(), chunk.size());
+              elle::bench::keep(buffer);
+            },
+            64 * 1024);
+  auto const big = elle::Buffer(std::string(1 << 20, 'x'));
+  suite.run("copy", 1000, [&]
+            {
+              elle::bench::keep(elle::Buffer(big));
+            },
+            big.size());
+  suite.run("range", 1000000, [&]
+            {
+              elle::bench::keep(big.range(1024, 4096));
+            });
+}
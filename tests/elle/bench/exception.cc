@@ -0,0 +1,77 @@
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <elle/Error.hh>
+
+#include <elle/bench/benchmark.hh>
+
+/// Compare the cost of throwing and catching exceptions, and of printing
+/// their backtraces.
+
+namespace
+{
+  /// Throw from a few frames deep, like real code does.
+  template <typename E>
+  ELLE_COMPILER_ATTRIBUTE_NO_INLINE
+  void
+  thrower(int depth, E const& e)
+  {
+    if (depth == 0)
+      throw e;
+    thrower(depth - 1, e);
+  }
+
+  template <typename Make>
+  std::size_t
+  throw_catch(Make const& make)
+  {
+    try
+    {
+      thrower(8, make());
+    }
+    catch (std::exception const& e)
+    {
+      return std::strlen(e.what());
+    }
+    return 0;
+  }
+}
+
+int
+main()
+{
+  elle::bench::Suite suite("exception");
+  suite.run("std::runtime_error", 10000, []
+            {
+              elle::bench::keep(
+                throw_catch([] { return std::runtime_error("error"); }));
+            });
+  suite.run("elle::Error", 10000, []
+            {
+              elle::bench::keep(
+                throw_catch([] { return elle::Error("error"); }));
+            });
+  suite.run("elle::Error without backtrace", 10000, []
+            {
+              elle::bench::keep(
+                throw_catch(
+                  [] { return elle::Error(elle::Backtrace(), "error"); }));
+            });
+  auto const print = []
+    {
+      std::stringstream s;
+      s << elle::Backtrace::current();
+      return s.str().size();
+    };
+  // The first print symbolizes the frames, the next ones hit the cache.
+  {
+    auto const start = std::chrono::steady_clock::now();
+    elle::bench::keep(print());
+    auto const ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start).count();
+    suite.report("print backtrace (cold)", {{"ns_per_op", ns}});
+  }
+  suite.run("print backtrace", 10000, [&] { elle::bench::keep(print()); });
+}
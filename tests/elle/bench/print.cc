@@ -0,0 +1,52 @@
+#include <sstream>
+#include <string>
+
+#include <boost/format.hpp>
+
+#include <elle/print.hh>
+#include <elle/printf.hh>
+
+#include <elle/bench/benchmark.hh>
+
+/// Compare the cost of formatting a typical log message.
+
+int
+main()
+{
+  elle::bench::Suite suite("print");
+  auto const peer = std::string("192.168.0.1:4242");
+  int i = 0;
+  suite.run("elle::print", 100000, [&]
+            {
+              elle::bench::keep(
+                elle::print("%s: send packet {} of {} bytes to {}",
+                            "channel", ++i, 1024, peer));
+            });
+  auto output = std::string();
+  suite.run("elle::print_to", 100000, [&]
+            {
+              output.clear();
+              elle::print_to(output, "%s: send packet {} of {} bytes to {}",
+                             "channel", ++i, 1024, peer);
+              elle::bench::keep(output);
+            });
+  suite.run("elle::sprintf", 100000, [&]
+            {
+              elle::bench::keep(
+                elle::sprintf("%s: send packet %s of %s bytes to %s",
+                              "channel", ++i, 1024, peer));
+            });
+  suite.run("boost::format", 100000, [&]
+            {
+              elle::bench::keep(
+                str(boost::format("%s: send packet %s of %s bytes to %s")
+                    % "channel" % ++i % 1024 % peer));
+            });
+  suite.run("std::ostringstream", 100000, [&]
+            {
+              std::ostringstream s;
+              s << "channel" << ": send packet " << ++i << " of " << 1024
+                << " bytes to " << peer;
+              elle::bench::keep(s.str());
+            });
+}
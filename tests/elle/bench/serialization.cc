@@ -0,0 +1,114 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <elle/Buffer.hh>
+#include <elle/serialization/binary.hh>
+#include <elle/serialization/json.hh>
+
+#include <elle/bench/benchmark.hh>
+
+/// Measure binary and JSON serialization of a typical record.
+
+namespace
+{
+  struct Record
+  {
+    Record()
+      : id(0)
+      , score(0)
+    {}
+
+    Record(elle::serialization::SerializerIn& s)
+    {
+      this->serialize(s);
+    }
+
+    void
+    serialize(elle::serialization::Serializer& s)
+    {
+      s.serialize("id", this->id);
+      s.serialize("name", this->name);
+      s.serialize("score", this->score);
+      s.serialize("samples", this->samples);
+      s.serialize("payload", this->payload);
+    }
+
+    std::int64_t id;
+    std::string name;
+    double score;
+    std::vector<std::int64_t> samples;
+    elle::Buffer payload;
+  };
+
+  template <typename Format>
+  void
+  bench(elle::bench::Suite& suite, std::string const& name)
+  {
+    auto record = Record{};
+    record.id = 0x1234567890;
+    record.name = "some reasonably named record";
+    record.score = 0.5;
+    for (int i = 0; i < 32; ++i)
+      record.samples.emplace_back(i * 1000);
+    record.payload = elle::Buffer(std::string(256, 'x'));
+    auto const data = Format::serialize(record, false);
+    suite.run(name + ".serialize", 100000, [&]
+              {
+                elle::bench::keep(Format::serialize(record, false));
+              },
+              data.size());
+    suite.run(name + ".deserialize", 100000, [&]
+              {
+                elle::bench::keep(
+                  Format::template deserialize<Record>(data, false));
+              },
+              data.size());
+  }
+
+  struct Binary
+  {
+    template <typename T>
+    static
+    elle::Buffer
+    serialize(T const& o, bool version)
+    {
+      return elle::serialization::binary::serialize(o, version);
+    }
+
+    template <typename T>
+    static
+    T
+    deserialize(elle::Buffer const& data, bool version)
+    {
+      return elle::serialization::binary::deserialize<T>(data, version);
+    }
+  };
+
+  struct Json
+  {
+    template <typename T>
+    static
+    elle::Buffer
+    serialize(T const& o, bool version)
+    {
+      return elle::serialization::json::serialize(o, version);
+    }
+
+    template <typename T>
+    static
+    T
+    deserialize(elle::Buffer const& data, bool version)
+    {
+      return elle::serialization::json::deserialize<T>(data, version);
+    }
+  };
+}
+
+int
+main()
+{
+  elle::bench::Suite suite("serialization");
+  bench<Binary>(suite, "binary");
+  bench<Json>(suite, "json");
+}
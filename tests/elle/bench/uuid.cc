@@ -0,0 +1,67 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <boost/uuid/random_generator.hpp>
+
+#include <elle/UUID.hh>
+#include <elle/random.hh>
+
+#include <elle/bench/benchmark.hh>
+
+/// Measure random UUIDs generation, alone and from concurrent threads.
+
+int
+main()
+{
+  elle::bench::Suite suite("uuid");
+  suite.run("engine", 10000000, []
+            {
+              elle::bench::keep(elle::random_engine()());
+            });
+  suite.run("random", 1000000, []
+            {
+              elle::bench::keep(elle::UUID::random());
+            });
+  suite.run("random_many", 1000, []
+            {
+              elle::bench::keep(elle::UUID::random_many(1024));
+            });
+  {
+    auto generator = boost::uuids::random_generator{};
+    suite.run("boost", 100000, [&]
+              {
+                elle::bench::keep(generator());
+              });
+  }
+  // Ids per second and per thread: flat when generation scales.
+  auto const count = std::size_t(1000000 * suite.scale());
+  for (auto n: {1u, 2u, 4u, 8u})
+  {
+    auto const name = "threads " + std::to_string(n);
+    if (!suite.enabled(name))
+      continue;
+    std::atomic<bool> go{false};
+    auto threads = std::vector<std::thread>{};
+    for (auto i = 0u; i < n; ++i)
+      threads.emplace_back(
+        [&]
+        {
+          while (!go)
+            std::this_thread::yield();
+          for (std::size_t i = 0; i < count; ++i)
+            elle::bench::keep(elle::UUID::random());
+        });
+    auto const start = std::chrono::steady_clock::now();
+    go = true;
+    for (auto& t: threads)
+      t.join();
+    auto const s = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+    suite.report(name, {
+        {"threads", n},
+        {"ids_per_s_per_thread", count / s},
+      });
+  }
+}
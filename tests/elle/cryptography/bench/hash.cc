@@ -0,0 +1,48 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <elle/Buffer.hh>
+#include <elle/printf.hh>
+
+#include <elle/cryptography/hash.hh>
+
+#include <elle/bench/benchmark.hh>
+
+/// Measure digests, one-shot, through a reused Hasher and in batches.
+
+int
+main()
+{
+  using elle::cryptography::Oneway;
+  elle::bench::Suite suite("hash");
+  for (auto oneway: {Oneway::md5, Oneway::sha1, Oneway::sha256})
+    for (auto size: {64, 4096, 1 << 20})
+    {
+      auto const data = elle::Buffer(std::string(size, 'x'));
+      auto const iterations = std::max((1 << 24) / size, 16);
+      suite.run(elle::sprintf("%s %s bytes", oneway, size), iterations,
+                [&]
+                {
+                  elle::bench::keep(elle::cryptography::hash(data, oneway));
+                },
+                size);
+      auto hasher = elle::cryptography::Hasher(oneway);
+      suite.run(elle::sprintf("%s %s bytes, reused hasher", oneway, size),
+                iterations,
+                [&]
+                {
+                  hasher.update(data);
+                  elle::bench::keep(hasher.finalize());
+                },
+                size);
+    }
+  auto const small = std::vector<elle::Buffer>(64, elle::Buffer("0123456789"));
+  auto const plains = std::vector<elle::ConstWeakBuffer>(
+    small.begin(), small.end());
+  suite.run("sha256 64 small buffers, batched", 10000, [&]
+            {
+              elle::bench::keep(
+                elle::cryptography::hash_many(plains, Oneway::sha256));
+            });
+}
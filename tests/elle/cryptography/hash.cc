@@ -157,6 +157,68 @@ test_blocks()
   test_blocks_x<elle::cryptography::Oneway::sha512>();
 }
 
+/*-------.
+| Hasher |
+`-------*/
+
+template <elle::cryptography::Oneway O>
+void
+test_hasher_x()
+{
+  elle::cryptography::Hasher hasher(O);
+  // Feed the message in several parts.
+  auto const half = _message.size() / 2;
+  hasher.update(elle::ConstWeakBuffer(_message.data(), half));
+  hasher.update(elle::ConstWeakBuffer(_message.data() + half,
+                                      _message.size() - half));
+  auto const digest = elle::cryptography::hash(_message, O);
+  BOOST_CHECK_EQUAL(hasher.finalize(), digest);
+  // The hasher starts over once finalized.
+  hasher.update(_message);
+  BOOST_CHECK_EQUAL(hasher.finalize(), digest);
+  // Reset drops what was fed so far.
+  hasher.update(elle::ConstWeakBuffer("garbage"));
+  hasher.reset();
+  hasher.update(_message);
+  BOOST_CHECK_EQUAL(hasher.finalize(), digest);
+  // Empty digests.
+  BOOST_CHECK_EQUAL(hasher.finalize(),
+                    elle::cryptography::hash(elle::ConstWeakBuffer(), O));
+}
+
+static
+void
+test_hasher()
+{
+  test_hasher_x<elle::cryptography::Oneway::md5>();
+  test_hasher_x<elle::cryptography::Oneway::sha>();
+  test_hasher_x<elle::cryptography::Oneway::sha1>();
+  test_hasher_x<elle::cryptography::Oneway::sha224>();
+  test_hasher_x<elle::cryptography::Oneway::sha256>();
+  test_hasher_x<elle::cryptography::Oneway::sha384>();
+  test_hasher_x<elle::cryptography::Oneway::sha512>();
+}
+
+static
+void
+test_hash_many()
+{
+  auto plains = std::vector<elle::Buffer>();
+  for (int i = 0; i < 64; ++i)
+    plains.emplace_back(
+      elle::cryptography::random::generate<elle::Buffer>(i));
+  auto const digests = elle::cryptography::hash_many(
+    std::vector<elle::ConstWeakBuffer>(plains.begin(), plains.end()),
+    elle::cryptography::Oneway::sha256);
+  BOOST_CHECK_EQUAL(digests.size(), plains.size());
+  for (unsigned i = 0; i < plains.size(); ++i)
+    BOOST_CHECK_EQUAL(
+      digests[i],
+      elle::cryptography::hash(plains[i], elle::cryptography::Oneway::sha256));
+  BOOST_CHECK(
+    elle::cryptography::hash_many({}, elle::cryptography::Oneway::sha1).empty());
+}
+
 /*-----.
 | Main |
 `-----*/
@@ -169,6 +231,8 @@ ELLE_TEST_SUITE()
   suite->add(BOOST_TEST_CASE(test_operate));
   suite->add(BOOST_TEST_CASE(test_serialize));
   suite->add(BOOST_TEST_CASE(test_blocks));
+  suite->add(BOOST_TEST_CASE(test_hasher));
+  suite->add(BOOST_TEST_CASE(test_hash_many));
 
   boost::unit_test::framework::master_test_suite().add(suite);
 }
@@ -160,6 +160,44 @@ test_serialize()
     R"JSON({"digest":"e7xVCxRZrBtQPJ7LFwhj72at4HNyxT+TjN8JHSe5TVgygvyNCkEf/8q78VluouQu712rh5s+xnCtwrayd86JLA=="})JSON");
 }
 
+/*-------.
+| HMACer |
+`-------*/
+
+template <elle::cryptography::Oneway O>
+void
+test_hmacer_x(std::string const& key)
+{
+  elle::cryptography::hmac::HMACer hmacer(key, O);
+  auto const half = _message.size() / 2;
+  hmacer.update(elle::ConstWeakBuffer(_message.data(), half));
+  hmacer.update(elle::ConstWeakBuffer(_message.data() + half,
+                                      _message.size() - half));
+  auto const digest = elle::cryptography::hmac::sign(_message, key, O);
+  BOOST_CHECK_EQUAL(hmacer.finalize(), digest);
+  // The key is retained once finalized.
+  hmacer.update(_message);
+  BOOST_CHECK_EQUAL(hmacer.finalize(), digest);
+  hmacer.update(elle::ConstWeakBuffer("garbage"));
+  hmacer.reset();
+  hmacer.update(_message);
+  auto const again = hmacer.finalize();
+  BOOST_CHECK(elle::cryptography::hmac::verify(again, _message, key, O));
+  // Buffers and streams agree.
+  std::stringstream stream(_message);
+  BOOST_CHECK_EQUAL(elle::cryptography::hmac::sign(stream, key, O), digest);
+}
+
+static
+void
+test_hmacer()
+{
+  test_hmacer_x<elle::cryptography::Oneway::md5>("one");
+  test_hmacer_x<elle::cryptography::Oneway::sha1>("san");
+  test_hmacer_x<elle::cryptography::Oneway::sha256>("négy");
+  test_hmacer_x<elle::cryptography::Oneway::sha512>("yedi");
+}
+
 /*-----.
 | Main |
 `-----*/
@@ -171,6 +209,7 @@ ELLE_TEST_SUITE()
   suite->add(BOOST_TEST_CASE(test_represent));
   suite->add(BOOST_TEST_CASE(test_operate));
   suite->add(BOOST_TEST_CASE(test_serialize));
+  suite->add(BOOST_TEST_CASE(test_hmacer));
 
   boost::unit_test::framework::master_test_suite().add(suite);
 }
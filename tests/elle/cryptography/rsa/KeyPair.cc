@@ -263,6 +263,79 @@ signing()
   }
 }
 
+/*---------.
+| Envelope |
+`---------*/
+
+static
+void
+envelope()
+{
+  elle::cryptography::rsa::KeyPair keypair = _test_generate(1024);
+  auto const input = elle::cryptography::random::generate<elle::Buffer>(
+    3 * 1024 * 1024 + 17);
+  // Seal block by block.
+  elle::Buffer code;
+  {
+    auto sealer = keypair.K().sealer(
+      [&] (elle::ConstWeakBuffer const& data)
+      {
+        code.append(data.contents(), data.size());
+      });
+    for (int i = 0; i < signed(input.size()); i += 4096)
+      sealer.update(elle::ConstWeakBuffer(input).range(
+                      i, std::min<int>(i + 4096, input.size())));
+    sealer.finalize();
+    BOOST_CHECK(sealer.finalized());
+  }
+  // The envelope is the same as the buffer-based one.
+  BOOST_CHECK_EQUAL(keypair.k().open(code), input);
+  {
+    std::stringstream stream(code.string());
+    std::stringstream plain;
+    keypair.k().open(stream, plain);
+    BOOST_CHECK_EQUAL(plain.str(), input.string());
+  }
+  // Open byte by byte, then by large chunks.
+  auto const weak = elle::ConstWeakBuffer(code);
+  for (auto chunk: {1, 4096, 1024 * 1024})
+  {
+    elle::Buffer plain;
+    auto opener = keypair.k().opener(
+      [&] (elle::ConstWeakBuffer const& data)
+      {
+        plain.append(data.contents(), data.size());
+      });
+    // Byte by byte is slow: only go through the header and a few blocks.
+    auto const size = chunk == 1 ? 1024 : code.size();
+    for (int i = 0; i < signed(size); i += chunk)
+      opener.update(weak.range(i, std::min<int>(i + chunk, size)));
+    if (chunk == 1)
+      opener.update(weak.range(size));
+    opener.finalize();
+    BOOST_CHECK_EQUAL(plain, input);
+  }
+  // Truncated envelopes are rejected.
+  {
+    auto opener = keypair.k().opener([] (elle::ConstWeakBuffer const&) {});
+    opener.update(weak.range(0, 10));
+    BOOST_CHECK_THROW(opener.finalize(), elle::cryptography::Error);
+  }
+  // Buffer-based envelopes open block by block.
+  {
+    auto const code = keypair.K().seal(input);
+    elle::Buffer plain;
+    auto opener = keypair.k().opener(
+      [&] (elle::ConstWeakBuffer const& data)
+      {
+        plain.append(data.contents(), data.size());
+      });
+    opener.update(code);
+    opener.finalize();
+    BOOST_CHECK_EQUAL(plain, input);
+  }
+}
+
 /*-----.
 | Main |
 `-----*/
@@ -276,4 +349,5 @@ ELLE_TEST_SUITE()
   suite.add(BOOST_TEST_CASE(operate));
   suite.add(BOOST_TEST_CASE(serialize));
   suite.add(BOOST_TEST_CASE(signing));
+  suite.add(BOOST_TEST_CASE(envelope));
 }
@@ -3,6 +3,7 @@
 #include <elle/cryptography/rsa/PublicKey.hh>
 #include <elle/cryptography/rsa/PrivateKey.hh>
 #include <elle/cryptography/rsa/KeyPair.hh>
+#include <elle/cryptography/rsa/SignatureCache.hh>
 
 #include <elle/serialization/json.hh>
 
@@ -190,6 +191,86 @@ test_serialize()
   }
 }
 
+/*------------.
+| Verify many |
+`------------*/
+
+static
+void
+test_verify_many()
+{
+  auto keypair = elle::cryptography::rsa::keypair::generate(1024);
+  auto plains = std::vector<elle::Buffer>();
+  auto signatures = std::vector<elle::Buffer>();
+  for (int i = 0; i < 16; ++i)
+  {
+    plains.emplace_back(elle::sprintf("plain %s", i));
+    signatures.emplace_back(keypair.k().sign(plains.back()));
+  }
+  // Corrupt one signature over two.
+  for (int i = 1; i < 16; i += 2)
+    signatures[i][0] ^= 0xff;
+  auto batch =
+    std::vector<elle::cryptography::rsa::PublicKey::Verification>();
+  for (int i = 0; i < 16; ++i)
+    batch.emplace_back(signatures[i], plains[i]);
+  for (auto parallelism: {0u, 1u, 3u, 64u})
+  {
+    auto res = keypair.K().verify_many(
+      batch, nullptr,
+      elle::cryptography::rsa::defaults::signature_padding,
+      elle::cryptography::rsa::defaults::oneway,
+      parallelism);
+    BOOST_CHECK_EQUAL(res.size(), batch.size());
+    for (int i = 0; i < 16; ++i)
+      BOOST_CHECK_EQUAL(bool(res[i]), i % 2 == 0);
+  }
+  BOOST_CHECK(keypair.K().verify_many({}).empty());
+}
+
+static
+void
+test_signature_cache()
+{
+  auto keypair = elle::cryptography::rsa::keypair::generate(1024);
+  elle::cryptography::rsa::SignatureCache cache(2);
+  auto const signature = keypair.k().sign(_input);
+  BOOST_CHECK(cache.verify(keypair.K(), signature, _input));
+  BOOST_CHECK_EQUAL(cache.misses(), 1u);
+  BOOST_CHECK_EQUAL(cache.hits(), 0u);
+  BOOST_CHECK(cache.verify(keypair.K(), signature, _input));
+  BOOST_CHECK_EQUAL(cache.hits(), 1u);
+  BOOST_CHECK_EQUAL(cache.hit_rate(), 0.5);
+  // Invalid signatures are not cached.
+  auto const other = elle::Buffer("an other plain");
+  BOOST_CHECK(!cache.verify(keypair.K(), signature, other));
+  BOOST_CHECK(!cache.verify(keypair.K(), signature, other));
+  BOOST_CHECK_EQUAL(cache.size(), 1u);
+  BOOST_CHECK_EQUAL(cache.misses(), 3u);
+  // A different key never hits.
+  auto const K = _test_generate(1024);
+  BOOST_CHECK(!cache.verify(K, signature, _input));
+  // Evict the least recently used entry.
+  for (int i = 0; i < 2; ++i)
+  {
+    auto const plain = elle::Buffer(elle::sprintf("plain %s", i));
+    auto const signature = keypair.k().sign(plain);
+    BOOST_CHECK(cache.verify(keypair.K(), signature, plain));
+  }
+  BOOST_CHECK_EQUAL(cache.size(), 2u);
+  BOOST_CHECK_EQUAL(cache.evictions(), 1u);
+  BOOST_CHECK(cache.verify(keypair.K(), signature, _input));
+  BOOST_CHECK_EQUAL(cache.evictions(), 2u);
+  // Batches go through the cache.
+  auto const hits = cache.hits();
+  auto res = keypair.K().verify_many({{signature, _input}}, &cache);
+  BOOST_CHECK(res == std::vector<bool>{true});
+  BOOST_CHECK_EQUAL(cache.hits(), hits + 1);
+  cache.clear();
+  BOOST_CHECK_EQUAL(cache.size(), 0u);
+  BOOST_CHECK_EQUAL(cache.hits(), 0u);
+}
+
 /*-----.
 | Main |
 `-----*/
@@ -204,6 +285,8 @@ ELLE_TEST_SUITE()
   suite->add(BOOST_TEST_CASE(test_operate));
   suite->add(BOOST_TEST_CASE(test_compare));
   suite->add(BOOST_TEST_CASE(test_serialize));
+  suite->add(BOOST_TEST_CASE(test_verify_many));
+  suite->add(BOOST_TEST_CASE(test_signature_cache));
 
   boost::unit_test::framework::master_test_suite().add(suite);
 }
@@ -0,0 +1,165 @@
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <elle/bench.hh>
+#include <elle/metrics.hh>
+#include <elle/test.hh>
+
+using elle::metrics::Histogram;
+
+static
+void
+buckets()
+{
+  // Buckets are contiguous and cover every value.
+  for (int i = 1; i < Histogram::buckets; ++i)
+    BOOST_CHECK_EQUAL(Histogram::lower(i),
+                      Histogram::lower(i - 1) + Histogram::width(i - 1));
+  for (auto v: {0ull, 1ull, 63ull, 64ull, 65ull, 1000ull, 123456789ull,
+        ~0ull})
+  {
+    auto const b = Histogram::bucket(v);
+    BOOST_CHECK_LE(Histogram::lower(b), v);
+    BOOST_CHECK_LE(v - Histogram::lower(b), Histogram::width(b) - 1);
+  }
+  BOOST_CHECK_EQUAL(Histogram::bucket(~0ull), Histogram::buckets - 1);
+}
+
+static
+void
+percentiles()
+{
+  Histogram h;
+  BOOST_CHECK_EQUAL(h.snapshot().percentile(0.5), 0);
+  for (int i = 1; i <= 100000; ++i)
+    h.record(i);
+  auto const s = h.snapshot();
+  BOOST_CHECK_EQUAL(s.count, 100000u);
+  BOOST_CHECK_EQUAL(s.minimum, 1);
+  BOOST_CHECK_EQUAL(s.maximum, 100000);
+  BOOST_CHECK_CLOSE(s.mean(), 50000.5, 0.001);
+  BOOST_CHECK_CLOSE(s.percentile(0.5), 50000, 1.6);
+  BOOST_CHECK_CLOSE(s.percentile(0.99), 99000, 1.6);
+  BOOST_CHECK_CLOSE(s.percentile(0.999), 99900, 1.6);
+  BOOST_CHECK_EQUAL(s.percentile(1), 100000);
+  h.reset();
+  BOOST_CHECK_EQUAL(h.snapshot().count, 0u);
+}
+
+static
+void
+units()
+{
+  Histogram h(1e-9);
+  h.record(std::chrono::milliseconds(3));
+  auto const s = h.snapshot();
+  BOOST_CHECK_CLOSE(s.sum, 0.003, 0.001);
+  BOOST_CHECK_CLOSE(s.percentile(0.5), 0.003, 0.001);
+}
+
+static
+void
+concurrent()
+{
+  Histogram h;
+  auto threads = std::vector<std::thread>{};
+  for (int t = 0; t < 16; ++t)
+    threads.emplace_back(
+      [&h, t]
+      {
+        for (int i = 0; i < 10000; ++i)
+          h.record(t);
+      });
+  for (auto& t: threads)
+    t.join();
+  auto const s = h.snapshot();
+  BOOST_CHECK_EQUAL(s.count, 160000u);
+  BOOST_CHECK_EQUAL(s.sum, 10000 * (15 * 16 / 2));
+  BOOST_CHECK_EQUAL(s.minimum, 0);
+  BOOST_CHECK_EQUAL(s.maximum, 15);
+  for (int t = 0; t < 16; ++t)
+    BOOST_CHECK_EQUAL(s.counts[t], 10000u);
+}
+
+static
+void
+registry()
+{
+  auto& r = elle::metrics::registry();
+  auto c = r.counter("test.requests");
+  BOOST_CHECK_EQUAL(c, r.counter("test.requests"));
+  c->increment();
+  c->increment(2);
+  auto g = r.gauge("test.queue");
+  g->set(4);
+  g->add(-1.5);
+  int probed = 7;
+  r.gauge("test.probed", [&] { return probed; });
+  auto h = r.histogram("test.latency", 1e-9);
+  h->record(std::chrono::microseconds(1500));
+  auto const s = r.snapshot();
+  BOOST_CHECK_EQUAL(s.counters.at("test.requests"), 3);
+  BOOST_CHECK_EQUAL(s.gauges.at("test.queue"), 2.5);
+  BOOST_CHECK_EQUAL(s.gauges.at("test.probed"), 7);
+  BOOST_CHECK_EQUAL(s.histograms.at("test.latency").count, 1u);
+  std::stringstream output;
+  elle::metrics::prometheus(output, s);
+  auto const text = output.str();
+  for (auto line: {
+      "# TYPE test_requests counter\ntest_requests 3\n",
+      "# TYPE test_queue gauge\ntest_queue 2.5\n",
+      "# TYPE test_latency summary\n",
+      "test_latency{quantile=\"0.99\"} 0.0015",
+      "test_latency_count 1\n",
+    })
+    BOOST_CHECK_MESSAGE(text.find(line) != std::string::npos,
+                        text << " lacks " << line);
+}
+
+static
+void
+bench()
+{
+  auto b = elle::Bench("test.bench");
+  for (int i = 1; i <= 100; ++i)
+    b.add(double(i));
+  BOOST_CHECK_EQUAL(b.count(), 100);
+  BOOST_CHECK_CLOSE(b.sum(), 5050, 0.001);
+  BOOST_CHECK_EQUAL(b.min(), 1);
+  BOOST_CHECK_EQUAL(b.max(), 100);
+  BOOST_CHECK_CLOSE(
+    double(std::chrono::duration_cast<std::chrono::nanoseconds>(
+             b.percentile(0.99)).count()),
+    99000, 1.6);
+  // Benches are exported through the registry, in seconds.
+  auto const s = elle::metrics::registry().snapshot();
+  BOOST_CHECK_CLOSE(s.histograms.at("test.bench").sum, 5050e-6, 0.001);
+  // Resetting the bench does not reset exported values.
+  b.reset();
+  BOOST_CHECK_EQUAL(b.count(), 0);
+  b.add(double(1));
+  BOOST_CHECK_EQUAL(b.count(), 1);
+  auto const exported = elle::metrics::registry().snapshot();
+  BOOST_CHECK_EQUAL(exported.histograms.at("test.bench").count, 101u);
+  // Unlike percentiles, statistics are exact.
+  b.reset();
+  b.add(-2.5);
+  b.add(0.0004);
+  b.add(std::chrono::nanoseconds(1500));
+  BOOST_CHECK_EQUAL(b.count(), 3);
+  BOOST_CHECK_EQUAL(b.min(), -2.5);
+  BOOST_CHECK_EQUAL(b.max(), 1.5);
+  BOOST_CHECK_CLOSE(b.sum(), -0.9996, 1e-6);
+}
+
+ELLE_TEST_SUITE()
+{
+  auto& master = boost::unit_test::framework::master_test_suite();
+  master.add(BOOST_TEST_CASE(buckets), 0, 1);
+  master.add(BOOST_TEST_CASE(percentiles), 0, 1);
+  master.add(BOOST_TEST_CASE(units), 0, 1);
+  master.add(BOOST_TEST_CASE(concurrent), 0, 10);
+  master.add(BOOST_TEST_CASE(registry), 0, 1);
+  master.add(BOOST_TEST_CASE(bench), 0, 1);
+}
@@ -179,6 +179,45 @@ namespace
   }
 }
 
+namespace
+{
+  struct Nested
+  {
+    int i;
+  };
+
+  std::ostream&
+  operator << (std::ostream& o, Nested const& n)
+  {
+    // Print to a string while the outer print is in progress, and leave
+    // junk formatting state behind.
+    return o << elle::print("Nested({})", n.i) << std::hex;
+  }
+
+  void
+  print_to()
+  {
+    auto output = std::string("> ");
+    elle::print_to(output, "{} {}", "foo", 42);
+    BOOST_TEST(output == "> foo 42");
+    elle::print_to(output, ", {n}", {{"n", 51}});
+    BOOST_TEST(output == "> foo 42, 51");
+    BOOST_CHECK_THROW(elle::print_to(output, "{}{}", "foo"), std::exception);
+  }
+
+  void
+  reuse()
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      BOOST_TEST(elle::print("{}", Nested{i}) ==
+                 elle::print("Nested({})", i));
+      // State left by previous prints does not leak.
+      BOOST_TEST(elle::print("{}", 42) == "42");
+      BOOST_CHECK_THROW(elle::print("{", i), std::exception);
+    }
+  }
+}
 
 ELLE_TEST_SUITE()
 {
@@ -197,4 +236,6 @@ ELLE_TEST_SUITE()
   suite.add(BOOST_TEST_CASE(conditional));
   suite.add(BOOST_TEST_CASE(conditional_positional));
   suite.add(BOOST_TEST_CASE(legacy));
+  suite.add(BOOST_TEST_CASE(print_to));
+  suite.add(BOOST_TEST_CASE(reuse));
 }
@@ -121,6 +121,19 @@ pointers()
   BOOST_TEST(elle::sprintf("%s", a) == "nullptr");
 }
 
+static
+void
+cached()
+{
+  // Formats are parsed once: make sure uses do not interfere.
+  for (int i = 0; i < 3; ++i)
+  {
+    BOOST_TEST(elle::sprintf("%s-%x", i, i + 10) ==
+               std::to_string(i) + "-" + "abc"[i]);
+    BOOST_CHECK_THROW(elle::sprintf("%s%s", i), std::exception);
+  }
+}
+
 ELLE_TEST_SUITE()
 {
   auto& suite = boost::unit_test::framework::master_test_suite();
@@ -135,4 +148,5 @@ ELLE_TEST_SUITE()
   suite.add(BOOST_TEST_CASE(boolean));
   suite.add(BOOST_TEST_CASE(function_pointer));
   suite.add(BOOST_TEST_CASE(pointers));
+  suite.add(BOOST_TEST_CASE(cached));
 }
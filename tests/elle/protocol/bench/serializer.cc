@@ -0,0 +1,80 @@
+#include <memory>
+#include <string>
+
+#include <elle/Buffer.hh>
+#include <elle/With.hh>
+#include <elle/printf.hh>
+
+#include <elle/protocol/Serializer.hh>
+
+#include <elle/reactor/Scope.hh>
+#include <elle/reactor/Thread.hh>
+#include <elle/reactor/network/TCPServer.hh>
+#include <elle/reactor/network/TCPSocket.hh>
+#include <elle/reactor/scheduler.hh>
+
+#include <elle/bench/benchmark.hh>
+
+/// Measure protocol::Serializer framing over a loopback TCP connection.
+
+namespace
+{
+  void
+  bench(elle::bench::Suite& suite, bool checksum)
+  {
+    elle::reactor::network::TCPServer server;
+    server.listen();
+    auto client = std::unique_ptr<elle::reactor::network::TCPSocket>{};
+    auto peer = std::unique_ptr<elle::reactor::network::TCPSocket>{};
+    auto alice = std::unique_ptr<elle::protocol::Serializer>{};
+    auto bob = std::unique_ptr<elle::protocol::Serializer>{};
+    elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& s)
+    {
+      s.run_background(
+        "bob",
+        [&]
+        {
+          peer = server.accept();
+          bob = std::make_unique<elle::protocol::Serializer>(
+            *peer, elle::Version(0, 3, 0), checksum);
+        });
+      client = std::make_unique<elle::reactor::network::TCPSocket>(
+        "127.0.0.1", server.port());
+      alice = std::make_unique<elle::protocol::Serializer>(
+        *client, elle::Version(0, 3, 0), checksum);
+      elle::reactor::wait(s);
+    };
+    elle::reactor::Thread reader(
+      "reader",
+      [&]
+      {
+        while (true)
+          elle::bench::keep(bob->read());
+      });
+    for (auto size: {64, 4096, 65536})
+    {
+      auto const packet = elle::Buffer(std::string(size, 'x'));
+      suite.run(elle::sprintf("write %s bytes%s",
+                              size, checksum ? ", checksummed" : ""),
+                65536 * 16 / size,
+                [&] { alice->write(packet); },
+                size);
+    }
+    reader.terminate_now();
+  }
+}
+
+int
+main()
+{
+  elle::bench::Suite suite("protocol");
+  elle::reactor::Scheduler sched;
+  elle::reactor::Thread main(
+    sched, "main",
+    [&]
+    {
+      bench(suite, false);
+      bench(suite, true);
+    });
+  sched.run();
+}
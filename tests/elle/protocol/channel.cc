@@ -2,11 +2,14 @@
 
 ELLE_LOG_COMPONENT("elle.protocol.Channel.test");
 
+#include <elle/With.hh>
 #include <elle/compiler.hh>
+#include <elle/metrics.hh>
 #include <elle/test.hh>
 
 #include <elle/protocol/ChanneledStream.hh>
 #include <elle/protocol/Serializer.hh>
+#include <elle/reactor/Scope.hh>
 #include <elle/reactor/network/Error.hh>
 #include <elle/reactor/network/TCPServer.hh>
 #include <elle/reactor/network/TCPSocket.hh>
@@ -80,6 +83,179 @@ ELLE_TEST_SCHEDULED(eof_read)
     });
 }
 
+/*-------------.
+| Flow control |
+`-------------*/
+
+/// Call @a f with two connected ChanneledStreams.
+template <typename F>
+void
+_connected(elle::Version const& version, bool flow_control, F f)
+{
+  auto server = elle::reactor::network::TCPServer{};
+  server.listen();
+  auto socket = std::unique_ptr<elle::reactor::network::Socket>{};
+  auto peer = std::unique_ptr<elle::reactor::network::Socket>{};
+  auto serializer = std::unique_ptr<elle::protocol::Serializer>{};
+  auto peer_serializer = std::unique_ptr<elle::protocol::Serializer>{};
+  auto alice = std::unique_ptr<elle::protocol::ChanneledStream>{};
+  auto bob = std::unique_ptr<elle::protocol::ChanneledStream>{};
+  elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& s)
+  {
+    s.run_background("bob", [&]
+    {
+      peer = server.accept();
+      peer_serializer = std::make_unique<elle::protocol::Serializer>(
+        *peer, version, false);
+      bob = std::make_unique<elle::protocol::ChanneledStream>(
+        *peer_serializer, flow_control);
+    });
+    socket = std::make_unique<elle::reactor::network::TCPSocket>(
+      "127.0.0.1", server.port());
+    serializer =
+      std::make_unique<elle::protocol::Serializer>(*socket, version, false);
+    alice = std::make_unique<elle::protocol::ChanneledStream>(
+      *serializer, flow_control);
+    elle::reactor::wait(s);
+  };
+  f(*alice, *bob);
+}
+
+
+ELLE_TEST_SCHEDULED(flow_window)
+{
+  _connected(
+    elle::Version(0, 3, 0),
+    true,
+    [] (elle::protocol::ChanneledStream& alice,
+        elle::protocol::ChanneledStream& bob)
+    {
+      auto const packet = elle::Buffer(std::string(100 * 1024, 'x'));
+      auto const count = 30;
+      auto c = elle::protocol::Channel(alice);
+      auto sent = 0;
+      elle::reactor::Thread writer("writer", [&]
+        {
+          for (auto i = 0; i < count; ++i)
+          {
+            c.write(packet);
+            ++sent;
+          }
+        });
+      elle::reactor::sleep(200_ms);
+      // Bob does not read: Alice is stopped by the receive window.
+      BOOST_TEST(sent > 0);
+      BOOST_TEST(sent * packet.size() <=
+                 elle::protocol::ChanneledStream::window);
+      auto b = bob.accept();
+      for (auto i = 0; i < count; ++i)
+        BOOST_TEST(b.read() == packet);
+      elle::reactor::wait(writer);
+      BOOST_TEST(sent == count);
+    });
+}
+
+// Packets of other channels are sent between fragments of a large one.
+ELLE_TEST_SCHEDULED(flow_interleave)
+{
+  _connected(
+    elle::Version(0, 3, 0),
+    true,
+    [] (elle::protocol::ChanneledStream& alice,
+        elle::protocol::ChanneledStream& bob)
+    {
+      // Larger than the window, it is still received.
+      auto const large = elle::Buffer(std::string(8 << 20, 'l'));
+      auto const small = elle::Buffer("small");
+      auto received = std::vector<std::string>{};
+      auto bulk = elle::protocol::Channel(alice);
+      auto rpc = elle::protocol::Channel(alice);
+      elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& s)
+      {
+        s.run_background("bulk", [&] { bulk.write(large); });
+        s.run_background("rpc", [&] { rpc.write(small); });
+        for (auto i = 0; i < 2; ++i)
+          s.run_background(
+            elle::sprintf("reader %s", i),
+            [&]
+            {
+              auto c = bob.accept();
+              auto p = c.read();
+              received.emplace_back(p == small ? "small" : "large");
+              if (p != small)
+                BOOST_TEST(p == large);
+            });
+        elle::reactor::wait(s);
+      };
+      BOOST_TEST(received == (std::vector<std::string>{"small", "large"}));
+    });
+}
+
+// A packet whose writer is interrupted halfway is still sent whole.
+ELLE_TEST_SCHEDULED(flow_interrupted)
+{
+  _connected(
+    elle::Version(0, 3, 0),
+    true,
+    [] (elle::protocol::ChanneledStream& alice,
+        elle::protocol::ChanneledStream& bob)
+    {
+      auto const first = elle::Buffer("first");
+      auto const large = elle::Buffer(std::string(4 << 20, 'l'));
+      auto const last = elle::Buffer("last");
+      auto c = elle::protocol::Channel(alice);
+      c.write(first);
+      // Bob does not read the first packet, stalling the second one.
+      elle::reactor::Thread writer("writer", [&] { c.write(large); });
+      elle::reactor::sleep(200_ms);
+      BOOST_TEST(!writer.done());
+      writer.terminate_now();
+      // Flow controlled too, only sent once Bob reads.
+      elle::reactor::Thread next("next", [&] { c.write(last); });
+      auto b = bob.accept();
+      BOOST_TEST(b.read() == first);
+      BOOST_TEST(b.read() == large);
+      BOOST_TEST(b.read() == last);
+      elle::reactor::wait(next);
+    });
+}
+
+/*-------.
+| Copies |
+`-------*/
+
+// Packets given away reach the socket without being copied.
+ELLE_TEST_SCHEDULED(copies, (bool, flow_control))
+{
+  // Consumers negotiate versions past 0.4.0: it must not imply flow control.
+  _connected(
+    elle::Version(0, 4, 0),
+    flow_control,
+    [&] (elle::protocol::ChanneledStream& alice,
+         elle::protocol::ChanneledStream& bob)
+    {
+      BOOST_TEST(alice.flow_control() == flow_control);
+      auto copies = elle::metrics::registry().counter("protocol.copies");
+      auto const content = std::string(1024, 'x');
+      auto c = elle::protocol::Channel(alice);
+      auto const copied = copies->value();
+      {
+        auto packet = elle::Buffer{};
+        packet.headroom(elle::protocol::Stream::headroom);
+        packet.append(content.data(), content.size());
+        c.write(std::move(packet));
+      }
+      auto b = bob.accept();
+      BOOST_TEST(b.read() == content);
+      BOOST_TEST(copies->value() == copied);
+      // Packets kept by their writer are copied once.
+      auto const packet = elle::Buffer(content);
+      c.write(packet);
+      BOOST_TEST(b.read() == content);
+      BOOST_TEST(copies->value() == copied + 1);
+    });
+}
+
 ELLE_TEST_SUITE()
 {
   auto& suite = boost::unit_test::framework::master_test_suite();
@@ -89,4 +265,18 @@ ELLE_TEST_SUITE()
     eof->add(ELLE_TEST_CASE(eof_accept, "accept"), 0, valgrind(2));
     eof->add(ELLE_TEST_CASE(eof_read, "read"), 0, valgrind(2));
   }
+  {
+    auto flow = BOOST_TEST_SUITE("flow");
+    suite.add(flow);
+    flow->add(ELLE_TEST_CASE(flow_window, "window"), 0, valgrind(5));
+    flow->add(ELLE_TEST_CASE(flow_interleave, "interleave"), 0, valgrind(5));
+    flow->add(ELLE_TEST_CASE(flow_interrupted, "interrupted"), 0, valgrind(5));
+  }
+  {
+    auto sub = BOOST_TEST_SUITE("copies");
+    suite.add(sub);
+    for (auto flow_control: {false, true})
+      sub->add(ELLE_TEST_CASE(std::bind(copies, flow_control),
+                              flow_control ? "flow" : "plain"), 0, valgrind(2));
+  }
 }
@@ -4,6 +4,7 @@
 #include <elle/ScopedAssignment.hh>
 #include <elle/With.hh>
 #include <elle/cast.hh>
+#include <elle/metrics.hh>
 #include <elle/test.hh>
 
 #include <elle/cryptography/random.hh>
@@ -496,6 +497,41 @@ ELLE_TEST_SCHEDULED(exchange)
   CASES(_exchange);
 }
 
+// Packets kept by their writer are only copied if sent in one chunk, to
+// prepend headers.
+static
+void
+_copies(elle::Version const& version,
+        bool checksum)
+{
+  auto copies = elle::metrics::registry().counter("protocol.copies");
+  auto big = elle::Buffer{};
+  dialog<Connector>(version,
+         checksum,
+         [] (Connector&) {},
+         [&] (elle::protocol::Serializer& s)
+         {
+           auto const small = elle::Buffer("small");
+           big = elle::Buffer(std::string(s.chunk_size() + 1, 'x'));
+           auto const copied = copies->value();
+           s.write(small);
+           BOOST_TEST(copies->value() == copied + 1);
+           s.write(big);
+           BOOST_TEST(copies->value() == copied + 1);
+         },
+         [&] (elle::protocol::Serializer& s)
+         {
+           BOOST_TEST(s.read() == "small");
+           BOOST_TEST(s.read() == big);
+         });
+}
+
+ELLE_TEST_SCHEDULED(copies)
+{
+  for (auto checksum: {true, false})
+    _copies(elle::Version(0, 3, 0), checksum);
+}
+
 static
 void
 _connection_lost_reader(elle::Version const& version,
@@ -1091,6 +1127,7 @@ ELLE_TEST_SUITE()
   auto& suite = boost::unit_test::framework::master_test_suite();
   suite.add(BOOST_TEST_CASE(exchange_packets), 0, valgrind(10, 10));
   suite.add(BOOST_TEST_CASE(exchange), 0, valgrind(20, 10));
+  suite.add(BOOST_TEST_CASE(copies), 0, valgrind(3, 10));
   suite.add(BOOST_TEST_CASE(connection_lost_reader), 0, valgrind(3, 10));
   suite.add(BOOST_TEST_CASE(connection_lost_sender), 0, valgrind(3, 10));
   suite.add(BOOST_TEST_CASE(corruption), 0, valgrind(3, 10));
@@ -1,4 +1,6 @@
 #include <list>
+#include <set>
+#include <thread>
 #include <vector>
 
 #include <boost/algorithm/cxx11/is_sorted.hpp>
@@ -127,6 +129,71 @@ namespace
     // Without random access.
     pick_n_iterators_impl(std::list<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
   }
+
+  /*---------.
+  | Engine.  |
+  `---------*/
+
+  std::vector<elle::RandomEngine::result_type>
+  draw(elle::RandomEngine& engine, int n)
+  {
+    auto res = std::vector<elle::RandomEngine::result_type>{};
+    for (int i = 0; i < n; ++i)
+      res.push_back(engine());
+    return res;
+  }
+
+  /// Engines are deterministic, unless reseeded.
+  void
+  engine()
+  {
+    auto a = elle::RandomEngine{42};
+    auto b = elle::RandomEngine{42};
+    auto c = elle::RandomEngine{43};
+    auto const sequence = draw(a, 100);
+    BOOST_TEST(sequence == draw(b, 100));
+    BOOST_TEST(sequence != draw(c, 100));
+    BOOST_TEST(std::set<elle::RandomEngine::result_type>(
+                 sequence.begin(), sequence.end()).size() == 100u);
+    a.seed(42);
+    BOOST_TEST(sequence == draw(a, 100));
+    // Reseeding kicks in after 10 outputs.
+    auto r = elle::RandomEngine{42, 10};
+    auto const reseeded = draw(r, 100);
+    BOOST_TEST(std::equal(sequence.begin(), sequence.begin() + 10,
+                          reseeded.begin()));
+    BOOST_TEST(sequence != reseeded);
+    // Usable with standard distributions.
+    auto dice = std::uniform_int_distribution<>(1, 6);
+    auto histo = Histo(7, 0);
+    for (int i = 0; i < 6000; ++i)
+      ++histo[dice(a)];
+    for (int i = 1; i <= 6; ++i)
+      BOOST_TEST(histo[i] > 800);
+  }
+
+  /// Every thread has its own engine.
+  void
+  thread_engines()
+  {
+    auto& engine = elle::random_engine();
+    BOOST_TEST(&engine == &elle::random_engine());
+    auto sequences =
+      std::vector<std::vector<elle::RandomEngine::result_type>>(4);
+    auto threads = std::vector<std::thread>{};
+    for (auto& sequence: sequences)
+      threads.emplace_back(
+        [&sequence, &engine]
+        {
+          BOOST_TEST(&elle::random_engine() != &engine);
+          sequence = draw(elle::random_engine(), 100);
+        });
+    for (auto& t: threads)
+      t.join();
+    for (auto i = 0u; i < sequences.size(); ++i)
+      for (auto j = i + 1; j < sequences.size(); ++j)
+        BOOST_TEST(sequences[i] != sequences[j]);
+  }
 }
 
 ELLE_TEST_SUITE()
@@ -136,4 +203,6 @@ ELLE_TEST_SUITE()
   suite.add(BOOST_TEST_CASE(pick_one_filtered));
   suite.add(BOOST_TEST_CASE(pick_n_integers));
   suite.add(BOOST_TEST_CASE(pick_n_iterators));
+  suite.add(BOOST_TEST_CASE(engine));
+  suite.add(BOOST_TEST_CASE(thread_engines));
 }
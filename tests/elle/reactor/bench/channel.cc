@@ -0,0 +1,43 @@
+#include <elle/reactor/Channel.hh>
+#include <elle/reactor/Thread.hh>
+#include <elle/reactor/scheduler.hh>
+
+#include <elle/bench/benchmark.hh>
+
+/// Measure reactor::Channel throughput between a producer and a consumer.
+
+namespace
+{
+  void
+  bench(elle::bench::Suite& suite, std::string const& name, int max_size)
+  {
+    elle::reactor::Channel<int> channel;
+    if (max_size)
+      channel.max_size(max_size);
+    elle::reactor::Thread producer(
+      "producer",
+      [&]
+      {
+        int i = 0;
+        while (true)
+          channel.put(i++);
+      });
+    suite.run(name, 100000, [&] { elle::bench::keep(channel.get()); });
+    producer.terminate_now();
+  }
+}
+
+int
+main()
+{
+  elle::bench::Suite suite("channel");
+  elle::reactor::Scheduler sched;
+  elle::reactor::Thread main(
+    sched, "main",
+    [&]
+    {
+      bench(suite, "get, bounded to 1", 1);
+      bench(suite, "get, bounded to 64", 64);
+    });
+  sched.run();
+}
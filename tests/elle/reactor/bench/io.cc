@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <elle/err.hh>
+#include <elle/reactor/IOUring.hh>
+#include <elle/reactor/Thread.hh>
+#include <elle/reactor/scheduler.hh>
+
+#include <elle/bench/benchmark.hh>
+
+/// Measure concurrent random reads from a regular file, either blocking the
+/// scheduler, in background system threads or through the io_uring.
+///
+/// Usage: io [THREADS [SIZE]]
+
+namespace
+{
+  using Read = std::function<ssize_t (int, void*, std::size_t, off_t)>;
+
+  void
+  bench(elle::bench::Suite& suite,
+        std::string const& name,
+        int fd,
+        int reads,
+        int threads,
+        std::size_t size,
+        std::function<Read (elle::reactor::Scheduler&)> const& make)
+  {
+    if (!suite.enabled(name))
+      return;
+    elle::reactor::Scheduler sched;
+    auto const file_size = ::lseek(fd, 0, SEEK_END);
+    elle::reactor::Thread driver(
+      sched, "driver",
+      [&]
+      {
+        auto read = make(sched);
+        auto const start = std::chrono::steady_clock::now();
+        auto workers = std::vector<elle::reactor::Thread::unique_ptr>{};
+        for (int t = 0; t < threads; ++t)
+          workers.emplace_back(new elle::reactor::Thread(
+            sched, "reader",
+            [&, t]
+            {
+              auto buffer = std::vector<char>(size);
+              for (int i = 0; i < reads; ++i)
+              {
+                auto const offset =
+                  off_t((i * 7919 + t * 104729) * size) % (file_size - size);
+                if (read(fd, buffer.data(), size, offset) != ssize_t(size))
+                  elle::err("short read");
+              }
+            }));
+        for (auto& w: workers)
+          elle::reactor::wait(*w);
+        auto const duration = std::chrono::steady_clock::now() - start;
+        auto const ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          duration).count();
+        auto fields = elle::bench::Fields{
+          {"iterations", reads * threads},
+          {"ns_per_op", double(ns) / (reads * threads)},
+        };
+        if (auto ring = sched.io_uring())
+          if (name == "io_uring")
+          {
+            auto const stats = ring->statistics();
+            fields.emplace_back(
+              "io_uring_enter_per_op",
+              double(stats.submissions) / stats.operations);
+          }
+        suite.report(name, fields);
+      });
+    sched.run();
+  }
+}
+
+int
+main(int argc, char** argv)
+{
+  elle::bench::Suite suite("io");
+  auto const reads = std::max(int(1000 * suite.scale()), 1);
+  auto const threads = argc > 1 ? std::stoi(argv[1]) : 64;
+  auto const size = std::size_t(argc > 2 ? std::stoi(argv[2]) : 4096);
+  char path[] = "/tmp/elle-bench-io-XXXXXX";
+  int fd = ::mkstemp(path);
+  if (fd < 0)
+    elle::err("unable to create %s", path);
+  ::unlink(path);
+  {
+    auto block = std::vector<char>(1 << 20, 'x');
+    for (int i = 0; i < 64; ++i)
+      if (::write(fd, block.data(), block.size()) != ssize_t(block.size()))
+        elle::err("unable to fill %s", path);
+  }
+  bench(suite, "blocking", fd, reads, threads, size,
+        [] (elle::reactor::Scheduler&) -> Read
+        {
+          return &::pread;
+        });
+  bench(suite, "background", fd, reads, threads, size,
+        [] (elle::reactor::Scheduler&) -> Read
+        {
+          return [] (int fd, void* data, std::size_t size, off_t offset)
+          {
+            ssize_t res = 0;
+            elle::reactor::background(
+              [&] { res = ::pread(fd, data, size, offset); });
+            return res;
+          };
+        });
+  bench(suite, "io_uring", fd, reads, threads, size,
+        [] (elle::reactor::Scheduler& sched) -> Read
+        {
+          auto ring = sched.io_uring();
+          if (!ring)
+            elle::err("io_uring is unavailable");
+          return [ring] (int fd, void* data, std::size_t size, off_t offset)
+          {
+            return ring->pread(fd, data, size, offset);
+          };
+        });
+  ::close(fd);
+}
@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <elle/reactor/Thread.hh>
+#include <elle/reactor/scheduler.hh>
+#include <elle/reactor/sleep.hh>
+
+#include <elle/bench/benchmark.hh>
+
+/// Measure how late a periodic latency sensitive thread wakes up while bulk
+/// threads keep the scheduler busy, with and without priorities.
+///
+/// Usage: priority [BULK [WORK_US]]
+
+namespace
+{
+  void
+  bench(elle::bench::Suite& suite,
+        std::string const& name,
+        int wakes,
+        int bulk,
+        int work_us,
+        bool prioritize)
+  {
+    if (!suite.enabled(name))
+      return;
+    using Clock = std::chrono::steady_clock;
+    elle::reactor::Scheduler sched;
+    bool done = false;
+    auto threads = std::vector<elle::reactor::Thread::unique_ptr>{};
+    for (int i = 0; i < bulk; ++i)
+    {
+      threads.emplace_back(new elle::reactor::Thread(
+        sched, "bulk",
+        [&]
+        {
+          while (!done)
+          {
+            auto const until = Clock::now() + std::chrono::microseconds(work_us);
+            while (Clock::now() < until)
+              continue;
+            elle::reactor::yield();
+          }
+        }));
+      if (prioritize)
+        threads.back()->priority(elle::reactor::Priority::bulk);
+    }
+    // How late the handler wakes up.
+    auto latency = elle::reactor::Scheduler::Latency{};
+    elle::reactor::Thread handler(
+      sched, "handler",
+      [&]
+      {
+        for (int i = 0; i < wakes; ++i)
+        {
+          auto const expected = Clock::now() + std::chrono::milliseconds(1);
+          elle::reactor::sleep(boost::posix_time::milliseconds(1));
+          latency.record(Clock::now() - expected);
+        }
+        done = true;
+      });
+    if (prioritize)
+      handler.priority(elle::reactor::Priority::latency);
+    sched.run();
+    suite.report(name, {
+        {"wakes", wakes},
+        {"p50_us", latency.percentile(0.5).count() / 1e3},
+        {"p99_us", latency.percentile(0.99).count() / 1e3},
+        {"max_us", latency.maximum().count() / 1e3},
+      });
+  }
+}
+
+int
+main(int argc, char** argv)
+{
+  elle::bench::Suite suite("priority");
+  auto const wakes = std::max(int(500 * suite.scale()), 1);
+  auto const bulk = argc > 1 ? std::stoi(argv[1]) : 200;
+  auto const work = argc > 2 ? std::stoi(argv[2]) : 50;
+  bench(suite, "fifo", wakes, bulk, work, false);
+  bench(suite, "priorities", wakes, bulk, work, true);
+}
@@ -0,0 +1,140 @@
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <elle/reactor/Thread.hh>
+#include <elle/reactor/rw-mutex.hh>
+#include <elle/reactor/scheduler.hh>
+#include <elle/threading/rw-mutex.hh>
+
+#include <elle/bench/benchmark.hh>
+
+/// Measure read/write locks contention on a read-mostly workload, from 1 to
+/// 64 threads: every thread takes the lock 100000 times, for writing once
+/// every ELLE_BENCH_WRITES times, 100 by default, and for reading otherwise.
+
+namespace
+{
+  struct Shared
+  {
+    void
+    read() const
+    {
+      auto sum = 0;
+      for (auto v: this->values)
+        sum += v;
+      elle::bench::keep(sum);
+    }
+
+    void
+    write()
+    {
+      for (auto& v: this->values)
+        ++v;
+    }
+
+    std::array<int, 8> values = {};
+  };
+
+  /// Adapt rw_mutex facets to the SharedMutex interface.
+  struct ThreadingMutex
+  {
+    void lock() { this->mutex.write_mutex::lock(); }
+    void unlock() { this->mutex.write_mutex::unlock(); }
+    void lock_shared() { this->mutex.read_mutex::lock(); }
+    void unlock_shared() { this->mutex.read_mutex::unlock(); }
+    elle::threading::rw_mutex mutex;
+  };
+
+  /// Exclusive locking only, for reference.
+  struct ExclusiveMutex
+  {
+    void lock() { this->mutex.lock(); }
+    void unlock() { this->mutex.unlock(); }
+    void lock_shared() { this->mutex.lock(); }
+    void unlock_shared() { this->mutex.unlock(); }
+    std::mutex mutex;
+  };
+
+  template <typename Mutex>
+  void
+  work(Mutex& mutex, Shared& shared, std::size_t count, int writes)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+      if (writes && i % writes == 0)
+      {
+        std::unique_lock<Mutex> lock(mutex);
+        shared.write();
+      }
+      else
+      {
+        std::shared_lock<Mutex> lock(mutex);
+        shared.read();
+      }
+  }
+
+  template <typename Mutex>
+  void
+  bench(elle::bench::Suite& suite, std::string const& name, bool reactor)
+  {
+    auto const count = std::size_t(100000 * suite.scale());
+    auto const writes = elle::os::getenv("ELLE_BENCH_WRITES", 100);
+    for (auto n: {1, 2, 4, 8, 16, 32, 64})
+    {
+      auto const label = name + " threads " + std::to_string(n);
+      if (!suite.enabled(label))
+        continue;
+      Mutex mutex;
+      Shared shared;
+      std::atomic<bool> go{false};
+      auto threads = std::vector<std::thread>{};
+      for (int i = 0; i < n; ++i)
+        threads.emplace_back(
+          [&]
+          {
+            while (!go)
+              std::this_thread::yield();
+            if (reactor)
+            {
+              // Two reactor threads per scheduler, so waiters have someone
+              // to yield to.
+              elle::reactor::Scheduler sched;
+              auto const f = [&] { work(mutex, shared, count / 2, writes); };
+              elle::reactor::Thread t1(sched, "worker 1", f);
+              elle::reactor::Thread t2(sched, "worker 2", f);
+              sched.run();
+            }
+            else
+              work(mutex, shared, count, writes);
+          });
+      auto const start = std::chrono::steady_clock::now();
+      go = true;
+      for (auto& t: threads)
+        t.join();
+      auto const s = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+      suite.report(label, {
+          {"threads", n},
+          {"ops_per_s", n * count / s},
+          {"ops_per_s_per_thread", count / s},
+        });
+    }
+  }
+}
+
+int
+main()
+{
+  elle::bench::Suite suite("rw-mutex");
+  bench<ExclusiveMutex>(suite, "std::mutex", false);
+  bench<std::shared_timed_mutex>(suite, "std::shared_timed_mutex", false);
+  bench<ThreadingMutex>(suite, "threading::rw_mutex", false);
+  bench<elle::reactor::SharedMutex>(suite, "reactor::SharedMutex", false);
+  bench<elle::reactor::SharedMutex>(suite, "reactor::SharedMutex scheduled",
+                                    true);
+}
@@ -0,0 +1,52 @@
+#include <elle/reactor/Thread.hh>
+#include <elle/reactor/scheduler.hh>
+#include <elle/reactor/signal.hh>
+
+#include <elle/bench/benchmark.hh>
+
+/// Measure context switches between reactor threads.
+
+int
+main()
+{
+  elle::bench::Suite suite("switch");
+  elle::reactor::Scheduler sched;
+  elle::reactor::Thread main(
+    sched, "main",
+    [&]
+    {
+      bool done = false;
+      {
+        elle::reactor::Thread other(
+          "other", [&] { while (!done) elle::reactor::yield(); });
+        suite.run("yield", 100000, [] { elle::reactor::yield(); });
+        done = true;
+        elle::reactor::wait(other);
+      }
+      done = false;
+      {
+        elle::reactor::Signal ping;
+        elle::reactor::Signal pong;
+        elle::reactor::Thread other(
+          "other",
+          [&]
+          {
+            while (true)
+            {
+              elle::reactor::wait(ping);
+              pong.signal();
+            }
+          });
+        // Let the other thread wait for pings.
+        while (ping.waiters().empty())
+          elle::reactor::yield();
+        suite.run("signal round trip", 100000, [&]
+                  {
+                    ping.signal();
+                    elle::reactor::wait(pong);
+                  });
+        other.terminate_now();
+      }
+    });
+  sched.run();
+}
@@ -0,0 +1,74 @@
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include <elle/With.hh>
+
+#include <elle/reactor/Scope.hh>
+#include <elle/reactor/Thread.hh>
+#include <elle/reactor/scheduler.hh>
+
+#include <elle/bench/benchmark.hh>
+
+/// Measure the cost of spawning, running and joining short lived threads.
+
+namespace
+{
+  std::size_t allocations = 0;
+
+  template <typename F>
+  void
+  bench(elle::bench::Suite& suite,
+        std::string const& name,
+        std::size_t iterations,
+        F const& f)
+  {
+    auto const allocated = allocations;
+    if (auto const calls = suite.run(name, iterations, f))
+      suite.report(name + " allocations",
+                   {{"allocations_per_op",
+                     double(allocations - allocated) / calls}});
+  }
+}
+
+void*
+operator new(std::size_t size)
+{
+  ++allocations;
+  if (auto res = std::malloc(size ? size : 1))
+    return res;
+  throw std::bad_alloc();
+}
+
+void
+operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+int
+main()
+{
+  elle::bench::Suite suite("thread");
+  elle::reactor::Scheduler sched;
+  elle::reactor::Thread main(
+    sched, "main",
+    [&]
+    {
+      bench(suite, "spawn, run and join", 10000, []
+            {
+              elle::reactor::Thread t("worker", [] {});
+              elle::reactor::wait(t);
+            });
+      bench(suite, "spawn 100 in a scope", 100, []
+            {
+              elle::With<elle::reactor::Scope>() << [] (elle::reactor::Scope& s)
+              {
+                for (int i = 0; i < 100; ++i)
+                  s.run_background("worker", [] {});
+                elle::reactor::wait(s);
+              };
+            });
+    });
+  sched.run();
+}
@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <elle/reactor/Barrier.hh>
+#include <elle/reactor/Thread.hh>
+#include <elle/reactor/scheduler.hh>
+#include <elle/reactor/signal.hh>
+
+#include <elle/bench/benchmark.hh>
+
+/// Measure the throughput of waits with a timeout that does not fire, with a
+/// population of idle threads holding long timeouts, like idle connections.
+///
+/// Usage: timeout [WAITERS [IDLE]]
+
+namespace
+{
+  void
+  bench(elle::bench::Suite& suite,
+        std::string const& name,
+        int rounds,
+        int waiters,
+        int idle,
+        elle::reactor::DurationOpt timeout)
+  {
+    if (!suite.enabled(name))
+      return;
+    elle::reactor::Scheduler sched;
+    elle::reactor::Barrier never;
+    elle::reactor::Signal signal;
+    auto threads = std::vector<elle::reactor::Thread::unique_ptr>{};
+    for (int i = 0; i < idle; ++i)
+      threads.emplace_back(new elle::reactor::Thread(
+        sched, "idle",
+        [&] { elle::reactor::wait(never, boost::posix_time::hours(1)); }));
+    int running = waiters;
+    int timeouts = 0;
+    for (int i = 0; i < waiters; ++i)
+      threads.emplace_back(new elle::reactor::Thread(
+        sched, "waiter",
+        [&]
+        {
+          for (int r = 0; r < rounds; ++r)
+            if (!elle::reactor::wait(signal, timeout))
+              ++timeouts;
+          --running;
+        }));
+    auto start = std::chrono::steady_clock::now();
+    elle::reactor::Thread driver(
+      sched, "driver",
+      [&]
+      {
+        // Let idle threads settle before measuring.
+        elle::reactor::yield();
+        elle::reactor::yield();
+        start = std::chrono::steady_clock::now();
+        while (running)
+        {
+          signal.signal();
+          elle::reactor::yield();
+        }
+        auto const duration = std::chrono::steady_clock::now() - start;
+        auto const ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          duration).count();
+        suite.report(name, {
+            {"iterations", rounds * waiters},
+            {"ns_per_op", double(ns) / (rounds * waiters)},
+            {"timeouts", timeouts},
+          });
+        sched.terminate();
+      });
+    sched.run();
+  }
+}
+
+int
+main(int argc, char** argv)
+{
+  elle::bench::Suite suite("timeout");
+  auto const rounds = std::max(int(1000 * suite.scale()), 1);
+  auto const waiters = argc > 1 ? std::stoi(argv[1]) : 100;
+  auto const idle = argc > 2 ? std::stoi(argv[2]) : 10000;
+  bench(suite, "wait", rounds, waiters, idle, {});
+  bench(suite, "wait with timeout", rounds, waiters, idle,
+        boost::posix_time::seconds(10));
+}
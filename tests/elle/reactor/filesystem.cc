@@ -3,12 +3,18 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#include <fstream>
+#include <sstream>
+
 #include <boost/filesystem/fstream.hpp>
 
+#include <elle/With.hh>
 #include <elle/finally.hh>
 #include <elle/os/environ.hh>
 #include <elle/reactor/Barrier.hh>
+#include <elle/reactor/Scope.hh>
 #include <elle/reactor/filesystem.hh>
+#include <elle/reactor/filesystem_journal.hh>
 #include <elle/reactor/scheduler.hh>
 #include <elle/reactor/signal.hh>
 #include <elle/test.hh>
@@ -385,10 +391,216 @@ test_xor()
   ELLE_TRACE("finished");
 }
 
+ELLE_TEST_SCHEDULED(bind_background_io)
+{
+  namespace rfs = elle::reactor::filesystem;
+  auto const source = bfs::temp_directory_path() / bfs::unique_path();
+  elle::SafeFinally remover([&] {
+      boost::system::error_code erc;
+      bfs::remove_all(source, erc);
+  });
+  bfs::create_directories(source);
+  for (auto name: {"a", "b", "c"})
+    bfs::ofstream(source / name) << name;
+  // Fewer I/O threads than parallel operations.
+  rfs::BindOperations ops(source, 2);
+  auto list = [&]
+    {
+      auto res = std::map<std::string, bool>();
+      ops.path("/")->list_directory(
+        [&] (std::string const& name, struct stat* st)
+        {
+          res[name] = st != nullptr;
+          if (st)
+            BOOST_CHECK_EQUAL(st->st_size, 1);
+        });
+      return res;
+    };
+  using Listing = std::map<std::string, bool>;
+  BOOST_CHECK_EQUAL(list(), (Listing{{"a", false}, {"b", false}, {"c", false}}));
+  ops.stat_entries(true);
+  BOOST_CHECK_EQUAL(list(), (Listing{{"a", true}, {"b", true}, {"c", true}}));
+  elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& scope)
+  {
+    for (int i = 0; i < 8; ++i)
+      scope.run_background(
+        elle::print("write %s", i),
+        [&, i]
+        {
+          auto h = ops.path(elle::print("/%s", i))->open(
+            O_CREAT | O_RDWR, 0644);
+          elle::SafeFinally close([&] { h->close(); });
+          auto const data = std::string(1024, 'a' + i);
+          // Writes from several coroutines may run in parallel: each must
+          // land at its own offset.
+          elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& s)
+          {
+            for (int chunk = 0; chunk < 4; ++chunk)
+              s.run_background(
+                "chunk",
+                [&, chunk]
+                {
+                  BOOST_CHECK_EQUAL(
+                    h->write(elle::ConstWeakBuffer(data), 1024, chunk * 1024),
+                    1024);
+                });
+            s.wait();
+          };
+          struct stat st;
+          ops.path(elle::print("/%s", i))->stat(&st);
+          BOOST_CHECK_EQUAL(st.st_size, 4096);
+          elle::Buffer read(4096);
+          BOOST_CHECK_EQUAL(h->read(read, 4096, 0), 4096);
+          BOOST_CHECK_EQUAL(read.string(), std::string(4096, 'a' + i));
+        });
+    scope.wait();
+  };
+  try
+  {
+    struct stat st;
+    ops.path("/missing")->stat(&st);
+    BOOST_FAIL("stat on a missing file should have failed");
+  }
+  catch (rfs::Error const& e)
+  {
+    BOOST_CHECK_EQUAL(e.error_code(), ENOENT);
+  }
+  BOOST_CHECK_THROW(ops.path("/missing")->open(O_RDONLY, 0), rfs::Error);
+}
+
+ELLE_TEST_SCHEDULED(path_cache)
+{
+  namespace rfs = elle::reactor::filesystem;
+  rfs::PathCache cache(3, 100_ms);
+  auto path = [] (int n) { return std::make_shared<sum::Path>(n); };
+  BOOST_CHECK(!cache.lookup("/a"));
+  BOOST_CHECK_EQUAL(cache.statistics().misses, 1);
+  cache.set("/a", path(1));
+  cache.set("/b", path(2));
+  cache.set("/c", path(3));
+  // Touch /a so /b is the least recently used.
+  BOOST_CHECK(cache.lookup("/a"));
+  cache.set("/d", path(4));
+  BOOST_CHECK_EQUAL(cache.size(), 3);
+  BOOST_CHECK_EQUAL(cache.statistics().evictions, 1);
+  BOOST_CHECK(!cache.get("/b"));
+  BOOST_CHECK(cache.get("/a"));
+  BOOST_CHECK_EQUAL(cache.statistics().hits, 1);
+  // Negative entries.
+  BOOST_CHECK(!cache.missing("/e"));
+  cache.set_missing("/e");
+  BOOST_CHECK(cache.missing("/e"));
+  BOOST_CHECK(!cache.lookup("/e"));
+  BOOST_CHECK_EQUAL(cache.statistics().negative_hits, 1);
+  elle::reactor::sleep(200_ms);
+  BOOST_CHECK(!cache.missing("/e"));
+  // Invalidation of a subtree.
+  cache.capacity(10);
+  for (auto p: {"/d", "/d/x", "/d/x/y", "/dd", "/a/d"})
+    cache.set(p, path(0));
+  cache.set_missing("/d/z");
+  cache.invalidate("/d");
+  for (auto p: {"/d", "/d/x", "/d/x/y"})
+    BOOST_CHECK(!cache.get(p));
+  BOOST_CHECK(!cache.missing("/d/z"));
+  BOOST_CHECK(cache.get("/dd"));
+  BOOST_CHECK(cache.get("/a/d"));
+  auto a = cache.get("/a");
+  BOOST_CHECK_EQUAL(cache.extract("/a"), a);
+  BOOST_CHECK(!cache.get("/a"));
+  cache.invalidate("/");
+  BOOST_CHECK_EQUAL(cache.size(), 0);
+}
+
+ELLE_TEST_SCHEDULED(journal)
+{
+  namespace rfs = elle::reactor::filesystem;
+  namespace journal = rfs::journal;
+  auto const source = bfs::temp_directory_path() / bfs::unique_path();
+  elle::SafeFinally remover([&] {
+      boost::system::error_code erc;
+      bfs::remove_all(source, erc);
+  });
+  bfs::create_directories(source / "root");
+  auto const prefix = (source / "fs.").string();
+  auto read = [&]
+    {
+      std::ifstream input(prefix + "journal", std::ios::binary);
+      journal::Reader reader(input);
+      auto res = std::vector<journal::Record>{};
+      while (auto record = reader.next())
+        res.emplace_back(std::move(record.get()));
+      return res;
+    };
+  {
+    auto ops = rfs::install_journal(
+      std::make_unique<rfs::BindOperations>(source / "root"), prefix);
+    ops->path("/dir")->mkdir(0755);
+    auto h = ops->path("/dir/file")->create(O_CREAT | O_RDWR, 0644);
+    auto const data = std::string("data");
+    BOOST_CHECK_EQUAL(h->write(elle::ConstWeakBuffer(data), 4, 0), 4);
+    h->close();
+    h.reset();
+    BOOST_CHECK_THROW(ops->path("/missing")->rmdir(), rfs::Error);
+  }
+  auto records = read();
+  auto operations = std::vector<std::string>{};
+  for (auto const& r: records)
+    operations.emplace_back(
+      elle::print("%s %s", r.kind == journal::Kind::in ? "in" : "out",
+                  r.operation));
+  BOOST_CHECK_EQUAL(
+    operations,
+    (std::vector<std::string>{
+      "in mkdir", "out mkdir", "in create", "out create", "in write",
+      "out write", "in close", "out close", "in dispose", "out dispose",
+      "in rmdir", "out rmdir"}));
+  BOOST_CHECK_EQUAL(records[0].path.get(), "/dir");
+  BOOST_CHECK_EQUAL(records[4].handle, records[5].handle);
+  BOOST_CHECK_EQUAL(records[4].fields.size(), 3);
+  BOOST_CHECK_EQUAL(boost::get<elle::Buffer>(records[4].fields[2].second),
+                    "data");
+  BOOST_CHECK_EQUAL(boost::get<bool>(records.back().fields[0].second), false);
+  BOOST_CHECK_EQUAL(boost::get<std::int64_t>(records.back().fields[1].second),
+                    ENOTDIR);
+  {
+    std::stringstream json;
+    records[0].json(json);
+    BOOST_CHECK_NE(json.str().find("\"path\":\"/dir\""), std::string::npos);
+    BOOST_CHECK_NE(json.str().find("\"operation\":\"mkdir\""),
+                   std::string::npos);
+    BOOST_CHECK_NE(json.str().find("\"mode\":493"), std::string::npos);
+  }
+  // Records pushed while a batch is pending are written together.
+  {
+    auto config = journal::Writer::Configuration();
+    config.delay = 10_sec;
+    config.sync = 1;
+    journal::Writer writer(prefix + "journal", config);
+    for (int i = 0; i < 100; ++i)
+      writer.in(elle::print("/%s", i), "stat");
+    writer.flush();
+    BOOST_CHECK_EQUAL(writer.statistics().records, 100);
+    BOOST_CHECK_EQUAL(writer.statistics().batches, 1);
+    BOOST_CHECK_EQUAL(writer.statistics().syncs, 1);
+  }
+  BOOST_CHECK_EQUAL(read().size(), records.size() + 100);
+  // A torn record size is ignored.
+  {
+    std::ofstream output(prefix + "journal",
+                         std::ios::binary | std::ios::app);
+    output.write("\xff\xff\xff", 3);
+  }
+  BOOST_CHECK_EQUAL(read().size(), records.size() + 100);
+}
+
 ELLE_TEST_SUITE()
 {
   boost::unit_test::test_suite* filesystem = BOOST_TEST_SUITE("filesystem");
   boost::unit_test::framework::master_test_suite().add(filesystem);
   filesystem->add(BOOST_TEST_CASE(test_sum), 0, sandbox ? 0 : 20);
   filesystem->add(BOOST_TEST_CASE(test_xor), 0, sandbox ? 0 : 20);
+  filesystem->add(BOOST_TEST_CASE(bind_background_io), 0, 10);
+  filesystem->add(BOOST_TEST_CASE(path_cache), 0, 10);
+  filesystem->add(BOOST_TEST_CASE(journal), 0, 10);
 }
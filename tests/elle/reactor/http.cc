@@ -6,6 +6,7 @@
 
 #include <elle/Buffer.hh>
 #include <elle/With.hh>
+#include <elle/metrics.hh>
 #include <elle/test.hh>
 #include <elle/utility/Move.hh>
 
@@ -76,6 +77,16 @@ ELLE_TEST_SCHEDULED(complex)
   BOOST_CHECK_EQUAL(r.progress(), (elle::reactor::http::Request::Progress{8,8,0,0}));
 }
 
+ELLE_TEST_SCHEDULED(metrics)
+{
+  elle::metrics::registry().counter("test.http.hits")->increment(3);
+  HTTPServer server;
+  server.register_metrics();
+  auto page = elle::reactor::http::get(server.url("metrics")).string();
+  BOOST_CHECK(page.find("# TYPE test_http_hits counter\n"
+                        "test_http_hits 3\n") != std::string::npos);
+}
+
 ELLE_TEST_SCHEDULED(not_found)
 {
   HTTPServer server;
@@ -790,6 +801,7 @@ ELLE_TEST_SUITE()
   auto& suite = boost::unit_test::framework::master_test_suite();
   suite.add(BOOST_TEST_CASE(simple), 0, valgrind(1));
   suite.add(BOOST_TEST_CASE(complex), 0, valgrind(1));
+  suite.add(BOOST_TEST_CASE(metrics), 0, valgrind(1));
   suite.add(BOOST_TEST_CASE(not_found), 0, valgrind(1));
   suite.add(BOOST_TEST_CASE(bad_request), 0, valgrind(1));
   suite.add(BOOST_TEST_CASE(no_answer), 0, valgrind(1));
@@ -1,9 +1,17 @@
+#include <atomic>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
+
+#ifdef ELLE_LINUX
+# include <fcntl.h>
+# include <unistd.h>
+#endif
 
 #include "reactor.hh"
 
+#include <elle/filesystem/TemporaryDirectory.hh>
 #include <elle/finally.hh>
 #include <elle/test.hh>
 
@@ -12,8 +20,10 @@
 #include <elle/reactor/Channel.hh>
 #include <elle/reactor/MultiLockBarrier.hh>
 #include <elle/reactor/OrWaitable.hh>
+#include <elle/reactor/ProducerPool.hh>
 #include <elle/reactor/Scope.hh>
 #include <elle/reactor/TimeoutGuard.hh>
+#include <elle/reactor/TimerWheel.hh>
 #include <elle/reactor/asio.hh>
 #include <elle/reactor/duration.hh>
 #include <elle/reactor/exception.hh>
@@ -1793,6 +1803,158 @@ test_rw_mutex_both()
   sched.run();
 }
 
+static
+void
+test_shared_mutex_read()
+{
+  elle::reactor::Scheduler sched;
+  elle::reactor::SharedMutex mutex;
+  int step = 0;
+  auto read = [&]
+    {
+      std::shared_lock<elle::reactor::SharedMutex> lock(mutex);
+      ++step;
+      elle::reactor::yield();
+      BOOST_CHECK_EQUAL(step, 3);
+    };
+  elle::reactor::Thread r1(sched, "reader1", read);
+  elle::reactor::Thread r2(sched, "reader2", read);
+  elle::reactor::Thread r3(sched, "reader3", read);
+  sched.run();
+}
+
+// Check waiters yield to the other threads of their scheduler, among which
+// the lock owner.
+static
+void
+test_shared_mutex_yield()
+{
+  elle::reactor::Scheduler sched;
+  elle::reactor::SharedMutex mutex;
+  auto steps = std::vector<std::string>{};
+  auto read = [&] (std::string const& name)
+    {
+      std::shared_lock<elle::reactor::SharedMutex> lock(mutex);
+      steps.emplace_back(name);
+      for (int i = 0; i < 3; ++i)
+        elle::reactor::yield();
+    };
+  elle::reactor::Thread r1(sched, "reader1", [&] { read("reader1"); });
+  elle::reactor::Thread w(
+    sched, "writer",
+    [&]
+    {
+      std::unique_lock<elle::reactor::SharedMutex> lock(mutex);
+      steps.emplace_back("writer");
+      elle::reactor::yield();
+    });
+  // Queued behind the writer.
+  elle::reactor::Thread r2(
+    sched, "reader2",
+    [&]
+    {
+      elle::reactor::yield();
+      read("reader2");
+    });
+  sched.run();
+  BOOST_CHECK_EQUAL(
+    steps, (std::vector<std::string>{"reader1", "writer", "reader2"}));
+}
+
+// Check a writer terminated while waiting for readers releases the lock.
+ELLE_TEST_SCHEDULED(test_shared_mutex_terminate)
+{
+  elle::reactor::SharedMutex mutex;
+  elle::reactor::Barrier release;
+  elle::reactor::Thread reader(
+    "reader",
+    [&]
+    {
+      std::shared_lock<elle::reactor::SharedMutex> lock(mutex);
+      elle::reactor::wait(release);
+    });
+  elle::reactor::yield();
+  elle::reactor::Thread writer(
+    "writer",
+    [&]
+    {
+      std::unique_lock<elle::reactor::SharedMutex> lock(mutex);
+      BOOST_FAIL("writer should not get the lock");
+    });
+  elle::reactor::yield();
+  elle::reactor::yield();
+  BOOST_CHECK(!mutex.try_lock_shared());
+  writer.terminate_now();
+  BOOST_CHECK(mutex.try_lock_shared());
+  mutex.unlock_shared();
+  release.open();
+  elle::reactor::wait(reader);
+  std::unique_lock<elle::reactor::SharedMutex> lock(mutex);
+}
+
+// Check releasing the lock wakes the waiters of the same scheduler, instead
+// of leaving them to poll.
+ELLE_TEST_SCHEDULED(test_shared_mutex_wake)
+{
+  using State = elle::reactor::Thread::State;
+  elle::reactor::SharedMutex mutex;
+  auto locked = false;
+  mutex.lock_shared();
+  elle::reactor::Thread writer(
+    "writer",
+    [&]
+    {
+      std::unique_lock<elle::reactor::SharedMutex> lock(mutex);
+      locked = true;
+    });
+  elle::reactor::sleep(20_ms);
+  BOOST_CHECK(!locked);
+  BOOST_CHECK(writer.state() == State::frozen);
+  mutex.unlock_shared();
+  BOOST_CHECK(writer.state() == State::running);
+  elle::reactor::wait(writer);
+  BOOST_CHECK(locked);
+}
+
+// Check system threads and reactor threads exclude each other.
+static
+void
+test_shared_mutex_threads()
+{
+  elle::reactor::SharedMutex mutex;
+  int a = 0;
+  int b = 0;
+  auto write = [&]
+    {
+      for (int i = 0; i < 200; ++i)
+      {
+        std::unique_lock<elle::reactor::SharedMutex> lock(mutex);
+        ++a;
+        std::this_thread::yield();
+        ++b;
+      }
+    };
+  std::thread writer(write);
+  elle::reactor::Scheduler sched;
+  auto read = [&]
+    {
+      for (int i = 0; i < 200; ++i)
+      {
+        std::shared_lock<elle::reactor::SharedMutex> lock(mutex);
+        BOOST_CHECK_EQUAL(a, b);
+        elle::reactor::yield();
+        BOOST_CHECK_EQUAL(a, b);
+      }
+    };
+  elle::reactor::Thread r1(sched, "reader1", read);
+  elle::reactor::Thread r2(sched, "reader2", read);
+  elle::reactor::Thread w(sched, "writer", write);
+  sched.run();
+  writer.join();
+  BOOST_CHECK_EQUAL(a, 400);
+  BOOST_CHECK_EQUAL(b, 400);
+}
+
 /*--------.
 | Storage |
 `--------*/
@@ -1825,6 +1987,47 @@ test_storage()
   sched.run();
 }
 
+namespace
+{
+  struct Counted
+  {
+    Counted()
+      : count(nullptr)
+    {}
+
+    ~Counted()
+    {
+      if (this->count)
+        ++*this->count;
+    }
+
+    int* count;
+  };
+}
+
+ELLE_TEST_SCHEDULED(storage_lifetime)
+{
+  int destroyed = 0;
+  auto storage =
+    std::make_unique<elle::reactor::LocalStorage<Counted>>();
+  {
+    elle::reactor::Thread t(
+      "other", [&] { storage->get().count = &destroyed; });
+    elle::reactor::wait(t);
+    BOOST_CHECK_EQUAL(destroyed, 0);
+  }
+  BOOST_CHECK_EQUAL(destroyed, 1);
+  storage->get().count = &destroyed;
+  storage.reset();
+  // A storage reusing the slot does not see the previous value.
+  elle::reactor::LocalStorage<Counted> other;
+  BOOST_CHECK(!other.get().count);
+  BOOST_CHECK_EQUAL(destroyed, 2);
+  elle::reactor::LocalStorage<int> value;
+  BOOST_CHECK_EQUAL(value.get(42), 42);
+  BOOST_CHECK_EQUAL(value.get(7), 42);
+}
+
 // Most likely a wine issue. To be investigated.
 #ifndef ELLE_WINDOWS
 static
@@ -2721,6 +2924,193 @@ namespace background
       f->value();
     }
   }
+
+  ELLE_TEST_SCHEDULED(batch)
+  {
+    auto results = std::vector<int>(64, 0);
+    auto actions = std::vector<std::function<void ()>>{};
+    for (int i = 0; i < signed(results.size()); ++i)
+      actions.emplace_back([&results, i] { results[i] = i * i; });
+    elle::reactor::background(actions, elle::reactor::Background::compute);
+    for (int i = 0; i < signed(results.size()); ++i)
+      BOOST_CHECK_EQUAL(results[i], i * i);
+    auto const stats = elle::reactor::scheduler()
+      .background_pool(elle::reactor::Background::compute).statistics();
+    BOOST_CHECK_EQUAL(stats.jobs, results.size());
+    BOOST_CHECK_EQUAL(stats.queued, 0u);
+    BOOST_CHECK_EQUAL(stats.wait.count(), results.size());
+    // Every job runs even though one of them fails.
+    std::atomic<int> ran(0);
+    actions.clear();
+    for (int i = 0; i < 16; ++i)
+      actions.emplace_back(
+        [&ran, i]
+        {
+          ++ran;
+          if (i == 7)
+            throw BeaconException();
+        });
+    BOOST_CHECK_THROW(elle::reactor::background(actions), BeaconException);
+    BOOST_CHECK_EQUAL(ran.load(), 16);
+  }
+
+  // Computations are not held up by blocking calls hogging their pool.
+  ELLE_TEST_SCHEDULED(compute)
+  {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool blocking = false;
+    bool release = false;
+    elle::reactor::Thread blocked(
+      "blocked",
+      [&]
+      {
+        elle::reactor::background(
+          [&]
+          {
+            std::unique_lock<std::mutex> lock(mutex);
+            blocking = true;
+            cv.wait(lock, [&] { return release; });
+          });
+      });
+    while (true)
+    {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (blocking)
+          break;
+      }
+      elle::reactor::yield();
+    }
+    elle::reactor::BackgroundFuture<int> f(
+      [] { return 42; }, elle::reactor::Background::compute);
+    BOOST_CHECK_EQUAL(f.value(), 42);
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      release = true;
+      cv.notify_all();
+    }
+    elle::reactor::wait(blocked);
+  }
+}
+
+/*--------------.
+| Producer pool |
+`--------------*/
+
+namespace producer_pool
+{
+  ELLE_TEST_SCHEDULED(refill)
+  {
+    std::atomic<int> produced(0);
+    elle::reactor::ProducerPool<int> pool(
+      "pool", [&] { return produced++; }, 2, 4);
+    // The pool fills up to the high watermark in the background.
+    BOOST_CHECK_EQUAL(pool.get(), 0);
+    while (pool.size() < 4)
+      elle::reactor::sleep(10_ms);
+    elle::reactor::sleep(50_ms);
+    BOOST_CHECK_EQUAL(pool.size(), 4);
+    BOOST_CHECK_EQUAL(produced, 5);
+    // Draining down to the low watermark does not trigger a refill.
+    BOOST_CHECK_EQUAL(*pool.try_get(), 1);
+    BOOST_CHECK_EQUAL(*pool.try_get(), 2);
+    elle::reactor::sleep(50_ms);
+    BOOST_CHECK_EQUAL(produced, 5);
+    // Going under it does.
+    BOOST_CHECK_EQUAL(*pool.try_get(), 3);
+    while (pool.size() < 4)
+      elle::reactor::sleep(10_ms);
+    BOOST_CHECK_EQUAL(produced, 8);
+  }
+
+  ELLE_TEST_SCHEDULED(try_get)
+  {
+    std::mutex mutex;
+    std::unique_lock<std::mutex> lock(mutex);
+    elle::reactor::ProducerPool<int> pool(
+      "pool",
+      [&]
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        return 42;
+      },
+      1, 1);
+    // Nothing is produced yet: do not wait.
+    BOOST_CHECK(!pool.try_get());
+    pool.put(51);
+    BOOST_CHECK_EQUAL(pool.size(), 1);
+    BOOST_CHECK_EQUAL(pool.get(), 51);
+    lock.unlock();
+    BOOST_CHECK_EQUAL(pool.get(), 42);
+  }
+
+  ELLE_TEST_SCHEDULED(workers)
+  {
+    std::atomic<int> running(0);
+    std::atomic<int> concurrent(0);
+    elle::reactor::ProducerPool<int> pool(
+      "pool",
+      [&]
+      {
+        auto n = ++running;
+        int expected = concurrent;
+        while (n > expected &&
+               !concurrent.compare_exchange_weak(expected, n))
+          ;
+        std::this_thread::sleep_for(100ms);
+        --running;
+        return 0;
+      },
+      4, 4, 4);
+    for (int i = 0; i < 4; ++i)
+      pool.get();
+    // Production runs on the compute pool, at most one per core.
+    if (std::thread::hardware_concurrency() > 1)
+      BOOST_CHECK_GT(concurrent, 1);
+    BOOST_CHECK_LE(concurrent, 4);
+    // Let the refill complete so production does not outlive the test.
+    while (pool.size() < 4)
+      elle::reactor::sleep(10_ms);
+  }
+
+  ELLE_TEST_SCHEDULED(error)
+  {
+    std::atomic<int> produced(0);
+    elle::reactor::ProducerPool<int> pool(
+      "pool",
+      [&]
+      {
+        if (produced++ == 0)
+          throw elle::Error("production failed");
+        return 42;
+      },
+      1, 1);
+    // The error reaches the consumer rather than the scheduler.
+    BOOST_CHECK_THROW(pool.get(), elle::Error);
+    // Production is retried on demand.
+    BOOST_CHECK_EQUAL(pool.get(), 42);
+  }
+
+  ELLE_TEST_SCHEDULED(persistence)
+  {
+    elle::filesystem::TemporaryDirectory d;
+    auto const path = d.path() / "pool";
+    {
+      elle::reactor::ProducerPool<std::string> pool(
+        "pool", [] { return std::string("fresh"); }, 0, 1);
+      BOOST_CHECK_EQUAL(pool.load(path), 0);
+      BOOST_CHECK_EQUAL(pool.get(), "fresh");
+      pool.put("stored");
+      pool.save(path);
+    }
+    {
+      elle::reactor::ProducerPool<std::string> pool(
+        "pool", [] { return std::string("fresh"); }, 0, 1);
+      BOOST_CHECK_EQUAL(pool.load(path), 1);
+      BOOST_CHECK_EQUAL(pool.get(), "stored");
+    }
+  }
 }
 
 /*--------.
@@ -3147,6 +3537,319 @@ namespace timeout_
   }
 }
 
+namespace timer_wheel
+{
+  using Clock = std::chrono::steady_clock;
+  using Entry = elle::reactor::TimerWheel::Entry;
+
+  // Entries fire in deadline order, never early, whatever level they are
+  // stored at.
+  ELLE_TEST_SCHEDULED(order)
+  {
+    auto& wheel = elle::reactor::scheduler().timer_wheel();
+    auto const delays = std::vector<int>{300, 0, 20, 1, 5, 270, 2};
+    auto fired = std::vector<int>{};
+    auto late = std::vector<Clock::duration>{};
+    auto entries = std::vector<std::unique_ptr<Entry>>{};
+    elle::reactor::Barrier done;
+    auto const start = Clock::now();
+    for (auto delay: delays)
+      entries.emplace_back(std::make_unique<Entry>(
+        [&, delay]
+        {
+          late.emplace_back(
+            Clock::now() - start - std::chrono::milliseconds(delay));
+          fired.emplace_back(delay);
+          if (fired.size() == delays.size())
+            done.open();
+        }));
+    for (auto i = 0u; i < delays.size(); ++i)
+      wheel.arm(*entries[i], boost::posix_time::milliseconds(delays[i]));
+    BOOST_CHECK_EQUAL(wheel.size(), delays.size());
+    elle::reactor::wait(done);
+    BOOST_CHECK_EQUAL(wheel.size(), 0u);
+    auto sorted = delays;
+    std::sort(sorted.begin(), sorted.end());
+    BOOST_CHECK_EQUAL(fired, sorted);
+    for (auto l: late)
+      BOOST_CHECK_GE(l.count(), 0);
+  }
+
+  ELLE_TEST_SCHEDULED(cancel)
+  {
+    auto& wheel = elle::reactor::scheduler().timer_wheel();
+    int fired = 0;
+    Entry entry([&] { ++fired; });
+    wheel.arm(entry, 10_ms);
+    BOOST_CHECK(entry.armed());
+    entry.cancel();
+    BOOST_CHECK(!entry.armed());
+    BOOST_CHECK_EQUAL(wheel.size(), 0u);
+    elle::reactor::sleep(30_ms);
+    BOOST_CHECK_EQUAL(fired, 0);
+    // Rearming moves the deadline.
+    wheel.arm(entry, 10_ms);
+    wheel.arm(entry, 500_ms);
+    BOOST_CHECK_EQUAL(wheel.size(), 1u);
+    elle::reactor::sleep(30_ms);
+    BOOST_CHECK_EQUAL(fired, 0);
+    wheel.arm(entry, 0_ms);
+    elle::reactor::sleep(10_ms);
+    BOOST_CHECK_EQUAL(fired, 1);
+    BOOST_CHECK(!entry.armed());
+    // Destruction cancels.
+    {
+      Entry transient([&] { ++fired; });
+      wheel.arm(transient, 10_ms);
+    }
+    BOOST_CHECK_EQUAL(wheel.size(), 0u);
+    elle::reactor::sleep(30_ms);
+    BOOST_CHECK_EQUAL(fired, 1);
+  }
+
+  // Mostly canceled timeouts, as network read timeouts are.
+  ELLE_TEST_SCHEDULED(many)
+  {
+    auto& wheel = elle::reactor::scheduler().timer_wheel();
+    auto const count = 10000;
+    auto fired = std::vector<bool>(count, false);
+    int early = 0;
+    int remaining = count / 10;
+    elle::reactor::Barrier done;
+    auto entries = std::vector<std::unique_ptr<Entry>>{};
+    auto deadlines = std::vector<Clock::time_point>(count);
+    for (int i = 0; i < count; ++i)
+      entries.emplace_back(std::make_unique<Entry>(
+        [&, i]
+        {
+          if (Clock::now() < deadlines[i])
+            ++early;
+          fired[i] = true;
+          if (--remaining == 0)
+            done.open();
+        }));
+    for (int i = 0; i < count; ++i)
+    {
+      auto const delay = (i * 7919) % 400;
+      deadlines[i] = Clock::now() + std::chrono::milliseconds(delay);
+      wheel.arm(*entries[i], boost::posix_time::milliseconds(delay));
+    }
+    for (int i = 0; i < count; ++i)
+      if (i % 10)
+        entries[i]->cancel();
+    BOOST_CHECK_EQUAL(wheel.size(), unsigned(count / 10));
+    elle::reactor::wait(done);
+    BOOST_CHECK_EQUAL(early, 0);
+    for (int i = 0; i < count; ++i)
+      BOOST_CHECK_EQUAL(fired[i], i % 10 == 0);
+  }
+}
+
+#ifdef ELLE_LINUX
+namespace io_uring
+{
+  // Concurrent positioned writes and reads, submitted in batches.
+  ELLE_TEST_SCHEDULED(read_write)
+  {
+    auto ring = elle::reactor::scheduler().io_uring();
+    if (!ring)
+      return;
+    elle::filesystem::TemporaryDirectory d;
+    auto const path = (d.path() / "file").string();
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0600);
+    BOOST_REQUIRE(fd >= 0);
+    elle::SafeFinally close([&] { ::close(fd); });
+    auto const count = 64;
+    auto const block = std::size_t(4096);
+    auto const before = ring->statistics();
+    elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& scope)
+    {
+      for (int i = 0; i < count; ++i)
+        scope.run_background(
+          elle::sprintf("writer %s", i),
+          [&, i]
+          {
+            auto data = std::string(block, 'a' + i % 26);
+            BOOST_CHECK_EQUAL(
+              ring->pwrite(fd, data.data(), block, i * block), ssize_t(block));
+          });
+      elle::reactor::wait(scope);
+    };
+    BOOST_CHECK_EQUAL(ring->fsync(fd), 0);
+    elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& scope)
+    {
+      for (int i = 0; i < count; ++i)
+        scope.run_background(
+          elle::sprintf("reader %s", i),
+          [&, i]
+          {
+            auto data = std::string(block, 0);
+            BOOST_CHECK_EQUAL(
+              ring->pread(fd, &data[0], block, i * block), ssize_t(block));
+            BOOST_CHECK(data == std::string(block, 'a' + i % 26));
+          });
+      elle::reactor::wait(scope);
+    };
+    auto const after = ring->statistics();
+    BOOST_CHECK_EQUAL(after.operations - before.operations, 2 * count + 1);
+    BOOST_CHECK_EQUAL(after.completions - before.completions,
+                      after.operations - before.operations);
+    // Parallel operations share io_uring_enter calls.
+    BOOST_CHECK_LT(after.submissions - before.submissions, count);
+    BOOST_CHECK_EQUAL(ring->pread(-1, nullptr, 0, 0), -1);
+    BOOST_CHECK_EQUAL(errno, EBADF);
+  }
+
+  // A terminated operation is canceled.
+  ELLE_TEST_SCHEDULED(terminate)
+  {
+    auto ring = elle::reactor::scheduler().io_uring();
+    if (!ring)
+      return;
+    int fds[2];
+    BOOST_REQUIRE_EQUAL(::pipe(fds), 0);
+    elle::SafeFinally close([&] { ::close(fds[0]); ::close(fds[1]); });
+    char c;
+    elle::reactor::Thread reader(
+      "reader", [&] { ring->pread(fds[0], &c, 1, -1); });
+    elle::reactor::sleep(10_ms);
+    BOOST_CHECK(!reader.done());
+    reader.terminate_now();
+    auto const stats = ring->statistics();
+    BOOST_CHECK_EQUAL(stats.operations, stats.completions);
+  }
+}
+#endif
+
+namespace priority
+{
+  // Threads inherit their creator priority, and higher classes run first.
+  ELLE_TEST_SCHEDULED(order)
+  {
+    auto events = std::vector<std::string>{};
+    auto& current = *elle::reactor::scheduler().current();
+    BOOST_CHECK_EQUAL(current.priority(), elle::reactor::Priority::normal);
+    elle::reactor::Thread bulk(
+      "bulk", [&] { events.emplace_back("bulk"); });
+    bulk.priority(elle::reactor::Priority::bulk);
+    elle::reactor::Thread normal(
+      "normal", [&] { events.emplace_back("normal"); });
+    current.priority(elle::reactor::Priority::latency);
+    elle::reactor::Thread latency(
+      "latency",
+      [&]
+      {
+        events.emplace_back("latency");
+        elle::reactor::Thread child(
+          "child",
+          [&]
+          {
+            BOOST_CHECK_EQUAL(elle::reactor::scheduler().current()->priority(),
+                              elle::reactor::Priority::latency);
+          });
+        elle::reactor::wait(child);
+      });
+    current.priority(elle::reactor::Priority::normal);
+    elle::reactor::wait({&bulk, &normal, &latency});
+    BOOST_CHECK_EQUAL(
+      events, (std::vector<std::string>{"latency", "normal", "bulk"}));
+    auto const& delays =
+      elle::reactor::scheduler().latency(elle::reactor::Priority::latency);
+    BOOST_CHECK_GE(delays.count(), 2u);
+    BOOST_CHECK_LE(delays.percentile(0.5), delays.percentile(1));
+    BOOST_CHECK_EQUAL(delays.percentile(1), delays.maximum());
+  }
+
+  // When a round overruns its budget, latency threads woken by asio catch up
+  // within the round.
+  ELLE_TEST_SCHEDULED(budget)
+  {
+    auto& sched = elle::reactor::scheduler();
+    sched.round_budget(boost::posix_time::seconds(0));
+    auto events = std::vector<std::string>{};
+    elle::reactor::Barrier woken;
+    elle::reactor::Thread latency(
+      "latency",
+      [&]
+      {
+        elle::reactor::wait(woken);
+        events.emplace_back("latency");
+      });
+    latency.priority(elle::reactor::Priority::latency);
+    elle::reactor::sleep(10_ms);
+    BOOST_CHECK(events.empty());
+    elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& scope)
+    {
+      for (int i = 0; i < 4; ++i)
+        scope.run_background(
+          elle::sprintf("bulk %s", i),
+          [&, i]
+          {
+            elle::reactor::scheduler().current()->priority(
+              elle::reactor::Priority::bulk);
+            elle::reactor::yield();
+            events.emplace_back(elle::sprintf("bulk %s", i));
+            if (i == 0)
+              sched.io_service().post([&] { woken.open(); });
+          });
+      elle::reactor::wait(scope);
+    };
+    BOOST_CHECK_EQUAL(
+      events,
+      (std::vector<std::string>{
+        "bulk 0", "latency", "bulk 1", "bulk 2", "bulk 3"}));
+  }
+
+  // Busy latency threads overrunning the budget do not starve other classes.
+  ELLE_TEST_SCHEDULED(starvation)
+  {
+    auto& sched = elle::reactor::scheduler();
+    sched.round_budget(boost::posix_time::seconds(0));
+    auto steps = 0;
+    elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& scope)
+    {
+      for (int i = 0; i < 5; ++i)
+        scope.run_background(
+          elle::sprintf("latency %s", i),
+          [&]
+          {
+            elle::reactor::scheduler().current()->priority(
+              elle::reactor::Priority::latency);
+            while (steps < 10)
+              elle::reactor::yield();
+          });
+      scope.run_background(
+        "normal",
+        [&]
+        {
+          for (; steps < 10; ++steps)
+            elle::reactor::yield();
+        });
+      elle::reactor::wait(scope);
+    };
+    BOOST_CHECK_EQUAL(steps, 10);
+  }
+
+  void
+  histogram()
+  {
+    auto latency = elle::reactor::Scheduler::Latency{};
+    BOOST_CHECK_EQUAL(latency.count(), 0u);
+    for (int i = 1; i <= 1000; ++i)
+      latency.record(std::chrono::microseconds(i));
+    BOOST_CHECK_EQUAL(latency.count(), 1000u);
+    BOOST_CHECK_EQUAL(latency.maximum(), std::chrono::microseconds(1000));
+    auto const p50 = latency.percentile(0.5);
+    BOOST_CHECK_GE(p50, std::chrono::microseconds(500));
+    BOOST_CHECK_LE(p50, std::chrono::microseconds(625));
+    auto const p99 = latency.percentile(0.99);
+    BOOST_CHECK_GE(p99, std::chrono::microseconds(990));
+    BOOST_CHECK_LE(p99, std::chrono::microseconds(1000));
+    latency.reset();
+    BOOST_CHECK_EQUAL(latency.count(), 0u);
+  }
+}
+
 namespace non_interruptible
 {
   ELLE_TEST_SCHEDULED(terminate)
@@ -3552,10 +4255,16 @@ ELLE_TEST_SUITE()
   rwmtx->add(BOOST_TEST_CASE(test_rw_mutex_multi_read), 0, valgrind(1, 5));
   rwmtx->add(BOOST_TEST_CASE(test_rw_mutex_multi_write), 0, valgrind(1, 5));
   rwmtx->add(BOOST_TEST_CASE(test_rw_mutex_both), 0, valgrind(1, 5));
+  rwmtx->add(BOOST_TEST_CASE(test_shared_mutex_read), 0, valgrind(1, 5));
+  rwmtx->add(BOOST_TEST_CASE(test_shared_mutex_yield), 0, valgrind(1, 5));
+  rwmtx->add(BOOST_TEST_CASE(test_shared_mutex_terminate), 0, valgrind(1, 5));
+  rwmtx->add(BOOST_TEST_CASE(test_shared_mutex_wake), 0, valgrind(1, 5));
+  rwmtx->add(BOOST_TEST_CASE(test_shared_mutex_threads), 0, valgrind(5, 5));
 
   boost::unit_test::test_suite* storage = BOOST_TEST_SUITE("Storage");
   boost::unit_test::framework::master_test_suite().add(storage);
   storage->add(BOOST_TEST_CASE(test_storage), 0, valgrind(1, 5));
+  storage->add(BOOST_TEST_CASE(storage_lifetime), 0, valgrind(1, 5));
 #if !defined ELLE_WINDOWS && !defined ELLE_ANDROID
   storage->add(BOOST_TEST_CASE(test_storage_multithread), 0, valgrind(3, 4));
 #endif
@@ -3575,6 +4284,8 @@ ELLE_TEST_SUITE()
     using namespace background;
     background->add(BOOST_TEST_CASE(aborted), 0, valgrind(1, 5));
     background->add(BOOST_TEST_CASE(aborted_throw), 0, valgrind(1, 5));
+    background->add(BOOST_TEST_CASE(batch), 0, valgrind(1, 5));
+    background->add(BOOST_TEST_CASE(compute), 0, valgrind(1, 5));
     background->add(BOOST_TEST_CASE(exception), 0, valgrind(1, 5));
     background->add(BOOST_TEST_CASE(future), 0, valgrind(2, 5));
     background->add(BOOST_TEST_CASE(operation), 0, valgrind(3, 10));
@@ -3582,6 +4293,17 @@ ELLE_TEST_SUITE()
     background->add(BOOST_TEST_CASE(thread_exception_yield), 0, valgrind(1, 5));
   }
 
+  {
+    boost::unit_test::test_suite* s = BOOST_TEST_SUITE("producer_pool");
+    boost::unit_test::framework::master_test_suite().add(s);
+    using namespace producer_pool;
+    s->add(BOOST_TEST_CASE(refill), 0, valgrind(1, 5));
+    s->add(BOOST_TEST_CASE(try_get), 0, valgrind(1, 5));
+    s->add(BOOST_TEST_CASE(workers), 0, valgrind(1, 5));
+    s->add(BOOST_TEST_CASE(error), 0, valgrind(1, 5));
+    s->add(BOOST_TEST_CASE(persistence), 0, valgrind(1, 5));
+  }
+
   boost::unit_test::test_suite* released = BOOST_TEST_SUITE("released");
   boost::unit_test::framework::master_test_suite().add(released);
   released->add(BOOST_TEST_CASE(test_released_signal), 0, valgrind(1, 5));
@@ -3605,6 +4327,41 @@ ELLE_TEST_SUITE()
     s->add(BOOST_TEST_CASE(race_condition), 0, valgrind(1, 5));
   }
 
+  {
+    boost::unit_test::test_suite* s = BOOST_TEST_SUITE("timer_wheel");
+    boost::unit_test::framework::master_test_suite().add(s);
+    auto order = &timer_wheel::order;
+    s->add(BOOST_TEST_CASE(order), 0, valgrind(1, 5));
+    auto cancel = &timer_wheel::cancel;
+    s->add(BOOST_TEST_CASE(cancel), 0, valgrind(1, 5));
+    auto many = &timer_wheel::many;
+    s->add(BOOST_TEST_CASE(many), 0, valgrind(2, 5));
+  }
+
+  {
+    boost::unit_test::test_suite* s = BOOST_TEST_SUITE("priority");
+    boost::unit_test::framework::master_test_suite().add(s);
+    auto order = &priority::order;
+    s->add(BOOST_TEST_CASE(order), 0, valgrind(1, 5));
+    auto budget = &priority::budget;
+    s->add(BOOST_TEST_CASE(budget), 0, valgrind(1, 5));
+    auto starvation = &priority::starvation;
+    s->add(BOOST_TEST_CASE(starvation), 0, valgrind(1, 5));
+    auto histogram = &priority::histogram;
+    s->add(BOOST_TEST_CASE(histogram), 0, valgrind(1, 5));
+  }
+
+#ifdef ELLE_LINUX
+  {
+    boost::unit_test::test_suite* s = BOOST_TEST_SUITE("io_uring");
+    boost::unit_test::framework::master_test_suite().add(s);
+    auto read_write = &io_uring::read_write;
+    s->add(BOOST_TEST_CASE(read_write), 0, valgrind(1, 5));
+    auto terminate = &io_uring::terminate;
+    s->add(BOOST_TEST_CASE(terminate), 0, valgrind(1, 5));
+  }
+#endif
+
 #if !defined(ELLE_WINDOWS) && !defined(ELLE_IOS)
   {
     boost::unit_test::test_suite* system_signals =
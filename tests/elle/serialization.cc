@@ -6,6 +6,7 @@
 #include <utility>
 #include <vector>
 
+#include <elle/UUID.hh>
 #include <elle/attribute.hh>
 #include <elle/filesystem/path.hh>
 #include <elle/serialization/binary.hh>
@@ -569,6 +570,14 @@ namespace
     round_trip<Format>(std::chrono::hours(609 * 24));
   }
 
+  template <typename Format>
+  void
+  duration()
+  {
+    round_trip<Format>(elle::Duration(boost::posix_time::milliseconds(1500)));
+    round_trip<Format>(elle::Duration(boost::posix_time::hours(-42)));
+  }
+
   template <typename Format>
   void
   path()
@@ -1141,6 +1150,148 @@ namespace versioning
   }
 }
 
+namespace compact
+{
+  using elle::serialization::Serializer;
+
+  /// Elle's serialization versions, with or without compact encodings.
+  Serializer::Versions
+  versions(bool compact)
+  {
+    return {
+      {
+        elle::type_info<elle::serialization_tag>(),
+        compact ? Serializer::compact_version : elle::Version(0, 9, 0),
+      },
+    };
+  }
+
+  template <typename T, typename R = T>
+  R
+  round_trip(T value, bool compact, int size = -1)
+  {
+    ELLE_LOG("round-trip%s: %s", compact ? " compact" : "", value);
+    std::stringstream stream;
+    {
+      elle::serialization::binary::SerializerOut output(
+        stream, versions(compact), false);
+      BOOST_TEST(output.compact() == compact);
+      output.serialize("value", value);
+    }
+    // The magic byte and the value.
+    if (size >= 0)
+      BOOST_TEST(stream.str().size() == 1 + size);
+    elle::serialization::binary::SerializerIn input(
+      stream, versions(compact), false);
+    auto res = R{};
+    input.serialize("value", res);
+    return res;
+  }
+
+  template <typename T>
+  void
+  check(T const& value, int size)
+  {
+    BOOST_TEST(round_trip(value, true, size) == value);
+    BOOST_TEST(round_trip(value, false) == value);
+  }
+
+  static
+  void
+  sizes()
+  {
+    check(elle::UUID::random(), 16);
+    check(elle::UUID(), 16);
+    check(elle::Version(2, 27, 123), 3);
+    check(boost::posix_time::microsec_clock::universal_time(), 8);
+    check(boost::posix_time::ptime(boost::posix_time::pos_infin), 8);
+    check(boost::posix_time::ptime(boost::posix_time::not_a_date_time), 8);
+    check(elle::Duration(boost::posix_time::milliseconds(1500)), 8);
+    // Only fixed-width encodings have special durations.
+    auto const infinity = elle::Duration(boost::posix_time::neg_infin);
+    BOOST_TEST(round_trip(infinity, true, 8) == infinity);
+    check(std::chrono::nanoseconds(603), 8);
+    check(std::chrono::hours(609 * 24), 8);
+    auto const now = std::chrono::time_point_cast<std::chrono::microseconds>(
+      std::chrono::system_clock::now());
+    BOOST_TEST((round_trip(now, true, 8) == now));
+    BOOST_TEST((round_trip(now, false) == now));
+  }
+
+  static
+  void
+  conversions()
+  {
+    // Times and durations share their encodings.
+    BOOST_TEST(
+      (round_trip<std::chrono::milliseconds, elle::Duration>(
+        std::chrono::milliseconds(1500), true) ==
+       boost::posix_time::milliseconds(1500)));
+    BOOST_TEST(
+      (round_trip<elle::Duration, std::chrono::seconds>(
+        boost::posix_time::minutes(2), true) ==
+       std::chrono::minutes(2)));
+    auto const now = std::chrono::time_point_cast<std::chrono::microseconds>(
+      std::chrono::system_clock::now());
+    BOOST_TEST(
+      (round_trip<decltype(now), boost::posix_time::ptime>(now, true) ==
+       elle::to_boost(now)));
+  }
+
+  static
+  void
+  overflow()
+  {
+    BOOST_CHECK_THROW(round_trip(std::chrono::hours::max(), true),
+                      elle::serialization::Error);
+    BOOST_CHECK_THROW(
+      (round_trip<std::chrono::hours, elle::Duration>(
+        std::chrono::hours::max(), false)),
+      elle::serialization::Error);
+    BOOST_CHECK_THROW(
+      (round_trip<std::chrono::hours, elle::Duration>(
+        std::chrono::hours(std::numeric_limits<std::int64_t>::max() / 3600),
+        false)),
+      elle::serialization::Error);
+  }
+
+  /// Without an explicit version, legacy encodings are used so that data
+  /// written before compact encodings can still be read.
+  static
+  void
+  legacy()
+  {
+    auto const uuid = elle::UUID::random();
+    auto const version = elle::Version(2, 27, 123);
+    auto const duration = elle::Duration(boost::posix_time::milliseconds(1500));
+    std::stringstream legacy;
+    {
+      elle::serialization::binary::SerializerOut output(
+        legacy, versions(false), false);
+      output.serialize("uuid", uuid);
+      output.serialize("version", version);
+      output.serialize("duration", duration);
+    }
+    {
+      std::stringstream stream(legacy.str());
+      elle::serialization::binary::SerializerIn input(stream, false);
+      BOOST_TEST(!input.compact());
+      BOOST_TEST(input.deserialize<elle::UUID>("uuid") == uuid);
+      BOOST_TEST(input.deserialize<elle::Version>("version") == version);
+      BOOST_TEST(input.deserialize<elle::Duration>("duration") == duration);
+    }
+    std::stringstream unversioned;
+    {
+      elle::serialization::binary::SerializerOut output(unversioned, false);
+      BOOST_TEST(!output.compact());
+      output.serialize("uuid", uuid);
+      output.serialize("version", version);
+      output.serialize("duration", duration);
+    }
+    BOOST_TEST(unversioned.str() == legacy.str());
+  }
+}
+
 static
 void
 in_place()
@@ -1684,6 +1835,7 @@ ELLE_TEST_SUITE()
   FOR_ALL_SERIALIZATION_TYPES(check_date);
   FOR_ALL_SERIALIZATION_TYPES(version);
   FOR_ALL_SERIALIZATION_TYPES(chrono);
+  FOR_ALL_SERIALIZATION_TYPES(duration);
   FOR_ALL_SERIALIZATION_TYPES(path);
   {
     auto* subsuite = BOOST_TEST_SUITE("hierarchy");
@@ -1718,6 +1870,14 @@ ELLE_TEST_SUITE()
   FOR_ALL_SERIALIZATION_TYPES(exceptions);
   FOR_ALL_SERIALIZATION_TYPES(text_parser);
   FOR_ALL_SERIALIZATION_TYPES(convert);
+  {
+    auto subsuite = BOOST_TEST_SUITE("compact");
+    master.add(subsuite);
+    subsuite->add(BOOST_TEST_CASE(compact::sizes));
+    subsuite->add(BOOST_TEST_CASE(compact::conversions));
+    subsuite->add(BOOST_TEST_CASE(compact::overflow));
+    subsuite->add(BOOST_TEST_CASE(compact::legacy));
+  }
   suite.add(BOOST_TEST_CASE(in_place));
   suite.add(BOOST_TEST_CASE(unordered_map_string_legacy));
   suite.add(BOOST_TEST_CASE(json_type_error));
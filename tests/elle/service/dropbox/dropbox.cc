@@ -0,0 +1,252 @@
+#include <elle/test.hh>
+
+#include <elle/reactor/network/http-server.hh>
+#include <elle/reactor/scheduler.hh>
+#include <elle/reactor/signal.hh>
+#include <elle/service/dropbox/Dropbox.hh>
+
+ELLE_LOG_COMPONENT("elle.services.dropbox.test");
+
+namespace dropbox = elle::service::dropbox;
+
+using Server = elle::reactor::network::HttpServer;
+using Method = elle::reactor::http::Method;
+
+namespace
+{
+  /// A local Dropbox, serving files from memory.
+  class Stub
+  {
+  public:
+    Stub()
+    {
+      this->server.register_route(
+        "/1/delta", Method::POST,
+        [this] (Server::Headers const&, Server::Cookies const&,
+                Server::Parameters const&, elle::Buffer const&)
+        {
+          ++this->deltas;
+          return this->delta;
+        });
+      this->server.register_route(
+        "/1/longpoll_delta", Method::GET,
+        [this] (Server::Headers const&, Server::Cookies const&,
+                Server::Parameters const&, elle::Buffer const&)
+        {
+          while (!this->changed)
+            elle::reactor::wait(this->changes);
+          this->changed = false;
+          return std::string(R"({"changes": true})");
+        });
+      this->serve("/", "", true);
+    }
+
+    /// Serve @a path metadata and content.
+    void
+    serve(std::string const& path,
+          std::string content,
+          bool is_dir = false)
+    {
+      this->files[path] = std::move(content);
+      auto metadata = [this, path, is_dir]
+        {
+          return elle::sprintf(
+            R"({"is_dir": %s, "path": "%s", "bytes": %s})",
+            is_dir ? "true" : "false", path, this->files.at(path).size());
+        };
+      this->server.register_route(
+        "/1/metadata/auto" + path, Method::GET,
+        [this, metadata] (Server::Headers const&, Server::Cookies const&,
+                          Server::Parameters const&, elle::Buffer const&)
+        {
+          ++this->metadatas;
+          return metadata();
+        });
+      this->server.register_route(
+        "/1/files/auto" + path, Method::GET,
+        [this, path] (Server::Headers const& headers, Server::Cookies const&,
+                      Server::Parameters const&, elle::Buffer const&)
+        {
+          auto const& content = this->files.at(path);
+          auto start = 0;
+          auto end = signed(content.size()) - 1;
+          auto range = headers.find("Range");
+          if (range != headers.end())
+            BOOST_REQUIRE_EQUAL(
+              sscanf(range->second.c_str(), "bytes=%d-%d", &start, &end), 2);
+          ++this->fetching;
+          this->fetching_max = std::max(this->fetching_max, this->fetching);
+          // Let concurrent requests pile up.
+          elle::reactor::sleep(10_ms);
+          --this->fetching;
+          return content.substr(start, end - start + 1);
+        });
+      this->server.register_route(
+        "/1/commit_chunked_upload/auto" + path, Method::POST,
+        [this, path, metadata] (Server::Headers const&,
+                                Server::Cookies const&,
+                                Server::Parameters const& params,
+                                elle::Buffer const&)
+        {
+          BOOST_CHECK_EQUAL(params.at("upload_id"), "session");
+          this->files[path] = std::move(this->uploading);
+          return metadata();
+        });
+    }
+
+    /// Start an upload session.
+    void
+    upload()
+    {
+      this->server.register_route(
+        "/1/chunked_upload", Method::PUT,
+        [this] (Server::Headers const&, Server::Cookies const&,
+                Server::Parameters const& params, elle::Buffer const& body)
+        {
+          ++this->chunks;
+          if (this->chunks == 1)
+            BOOST_CHECK(params.find("upload_id") == params.end());
+          else
+          {
+            BOOST_CHECK_EQUAL(params.at("upload_id"), "session");
+            BOOST_CHECK_EQUAL(params.at("offset"),
+                              std::to_string(this->uploading.size()));
+          }
+          this->uploading += body.string();
+          return elle::sprintf(R"({"upload_id": "session", "offset": %s})",
+                               this->uploading.size());
+        });
+    }
+
+    /// Signal pending changes to longpolls.
+    void
+    change()
+    {
+      this->changed = true;
+      this->changes.signal();
+    }
+
+    dropbox::Endpoints
+    endpoints()
+    {
+      auto root = elle::sprintf("http://127.0.0.1:%s", this->server.port());
+      return {root, root, root};
+    }
+
+    std::string delta = R"({"reset": true, "cursor": "0", "has_more": false,
+                            "entries": {}})";
+    bool changed = false;
+    elle::reactor::Signal changes;
+    std::unordered_map<std::string, std::string> files;
+    std::string uploading;
+    int deltas = 0;
+    int metadatas = 0;
+    int chunks = 0;
+    int fetching = 0;
+    int fetching_max = 0;
+    Server server;
+  };
+
+  std::string
+  entry(std::string const& path, int bytes)
+  {
+    return elle::sprintf(
+      R"("%s": {"is_dir": false, "path": "%s", "bytes": %s})",
+      path, path, bytes);
+  }
+
+  std::string
+  data(int size)
+  {
+    auto res = std::string(size, 0);
+    for (auto i = 0; i < size; ++i)
+      res[i] = 'a' + i % 26;
+    return res;
+  }
+}
+
+ELLE_TEST_SCHEDULED(metadata_cache)
+{
+  Stub stub;
+  stub.delta = elle::sprintf(
+    R"({"reset": true, "cursor": "1", "has_more": false,
+        "entries": {%s, %s}})",
+    entry("/a", 1), entry("/b", 2));
+  dropbox::Dropbox d("token", 1024, 4, stub.endpoints());
+  BOOST_CHECK_EQUAL(stub.deltas, 1);
+  BOOST_CHECK_EQUAL(stub.metadatas, 1);
+  for (auto i = 0; i < 3; ++i)
+  {
+    BOOST_CHECK_EQUAL(d.metadata("/a").bytes, 1);
+    BOOST_CHECK_EQUAL(d.metadata("/B").bytes, 2);
+    BOOST_CHECK_THROW(d.metadata("/c"), dropbox::NoSuchFile);
+  }
+  BOOST_CHECK(d.metadata("/").is_dir);
+  BOOST_CHECK_EQUAL(stub.metadatas, 1);
+  // A reset replaces everything known.
+  stub.delta = elle::sprintf(
+    R"({"reset": true, "cursor": "2", "has_more": false,
+        "entries": {%s, %s}})",
+    entry("/b", 3), entry("/c", 4));
+  stub.change();
+  while (stub.deltas < 2)
+    elle::reactor::sleep(10_ms);
+  elle::reactor::yield();
+  BOOST_CHECK_THROW(d.metadata("/a"), dropbox::NoSuchFile);
+  BOOST_CHECK_EQUAL(d.metadata("/b").bytes, 3);
+  BOOST_CHECK_EQUAL(d.metadata("/c").bytes, 4);
+  BOOST_CHECK(d.metadata("/").is_dir);
+  BOOST_CHECK_EQUAL(stub.metadatas, 2);
+}
+
+ELLE_TEST_SCHEDULED(download)
+{
+  Stub stub;
+  auto const content = data(10 * 1024 + 100);
+  stub.serve("/big", content);
+  stub.serve("/small", "small");
+  stub.delta = elle::sprintf(
+    R"({"reset": true, "cursor": "1", "has_more": false,
+        "entries": {%s, %s}})",
+    entry("/big", content.size()), entry("/small", 5));
+  dropbox::Dropbox d("token", 1024, 4, stub.endpoints());
+  {
+    auto blocks = std::string();
+    d.download("/big", [&] (elle::ConstWeakBuffer block)
+               {
+                 BOOST_CHECK_LE(block.size(), 1024u);
+                 // Never more than parallelism blocks in flight.
+                 BOOST_CHECK_LE(stub.fetching, 4);
+                 blocks += block.string();
+               });
+    BOOST_CHECK(blocks == content);
+    BOOST_CHECK_GT(stub.fetching_max, 1);
+    BOOST_CHECK_LE(stub.fetching_max, 4);
+  }
+  BOOST_CHECK(d.get("/big").string() == content);
+  stub.fetching_max = 0;
+  BOOST_CHECK_EQUAL(d.get("/small").string(), "small");
+  BOOST_CHECK_EQUAL(stub.fetching_max, 1);
+  BOOST_CHECK_THROW(d.get("/missing"), dropbox::NoSuchFile);
+}
+
+ELLE_TEST_SCHEDULED(upload)
+{
+  Stub stub;
+  stub.serve("/up", "");
+  stub.upload();
+  dropbox::Dropbox d("token", 1024, 4, stub.endpoints());
+  auto content = data(3000);
+  BOOST_CHECK(d.put("/up", elle::WeakBuffer(&content[0], content.size())));
+  BOOST_CHECK_EQUAL(stub.chunks, 3);
+  BOOST_CHECK(stub.files.at("/up") == content);
+  BOOST_CHECK_EQUAL(d.metadata("/up").bytes, 3000);
+}
+
+ELLE_TEST_SUITE()
+{
+  auto& suite = boost::unit_test::framework::master_test_suite();
+  suite.add(BOOST_TEST_CASE(metadata_cache), 0, valgrind(5));
+  suite.add(BOOST_TEST_CASE(download), 0, valgrind(5));
+  suite.add(BOOST_TEST_CASE(upload), 0, valgrind(5));
+}
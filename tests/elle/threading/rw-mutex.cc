@@ -1,9 +1,13 @@
+#include <atomic>
 #include <thread>
+#include <vector>
 
 #include <elle/log.hh>
 #include <elle/test.hh>
 #include <elle/threading/rw-mutex.hh>
 
+ELLE_LOG_COMPONENT("elle.threading.rw_mutex");
+
 // Check two threads can read concurrently.
 static
 void
@@ -158,6 +162,82 @@ blocks()
   block.join();
 }
 
+// Check a waiting writer has precedence over new readers.
+static
+void
+writer_preference()
+{
+  elle::threading::rw_mutex mutex;
+  mutex.read_mutex::lock();
+  std::atomic<bool> written{false};
+  std::thread writer(
+    [&]
+    {
+      std::unique_lock<elle::threading::write_mutex> lock(mutex);
+      written = true;
+    });
+  // Wait for the writer to queue.
+  std::thread reader(
+    [&]
+    {
+      while (true)
+      {
+        std::unique_lock<elle::threading::read_mutex> lock(
+          mutex, std::try_to_lock);
+        if (!lock.owns_lock())
+          break;
+        lock.unlock();
+        std::this_thread::yield();
+      }
+    });
+  reader.join();
+  BOOST_CHECK(!written);
+  mutex.read_mutex::unlock();
+  writer.join();
+  BOOST_CHECK(written);
+  // Both are free again.
+  BOOST_CHECK(mutex.write_mutex::try_lock());
+  mutex.write_mutex::unlock();
+  BOOST_CHECK(mutex.read_mutex::try_lock());
+  mutex.read_mutex::unlock();
+}
+
+// Check readers never see a half written state.
+static
+void
+stress()
+{
+  elle::threading::rw_mutex mutex;
+  int a = 0;
+  int b = 0;
+  std::atomic<int> reads{0};
+  auto threads = std::vector<std::thread>{};
+  for (int t = 0; t < 8; ++t)
+    threads.emplace_back(
+      [&, t]
+      {
+        for (int i = 0; i < 2000; ++i)
+          if (t % 4 == 0)
+          {
+            std::unique_lock<elle::threading::write_mutex> lock(mutex);
+            ++a;
+            std::this_thread::yield();
+            ++b;
+          }
+          else
+          {
+            std::unique_lock<elle::threading::read_mutex> lock(mutex);
+            BOOST_CHECK_EQUAL(a, b);
+            ++reads;
+          }
+      });
+  for (auto& t: threads)
+    t.join();
+  BOOST_CHECK_EQUAL(a, 4000);
+  BOOST_CHECK_EQUAL(b, 4000);
+  BOOST_CHECK_EQUAL(reads, 12000);
+}
+
 ELLE_TEST_SUITE()
 {
   auto& suite = boost::unit_test::framework::master_test_suite();
@@ -174,4 +254,6 @@ ELLE_TEST_SUITE()
   auto write_blocks_write =
     &blocks<elle::threading::write_mutex, elle::threading::write_mutex>;
   suite.add(BOOST_TEST_CASE(write_blocks_write), 0, 3);
+  suite.add(BOOST_TEST_CASE(writer_preference), 0, 10);
+  suite.add(BOOST_TEST_CASE(stress), 0, 30);
 }